@@ -5,6 +5,7 @@
 #include <ti/xdais/xdas.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "trik_vidtranscode_resample.h"
 #include "internal/vidtranscode_resample_iface.h"
@@ -27,7 +28,8 @@ bool handlePickOutputParams(const TrikVideoResampleHandle*	_handle,
                             XDAS_Int32*				_iFormat,
                             XDAS_Int32*				_iHeight,
                             XDAS_Int32*				_iWidth,
-                            XDAS_Int32*				_iLineLength);
+                            XDAS_Int32*				_iLineLength,
+                            XDAS_Int32*				_iAlgorithm);
 
 bool handlePickInputParams(const TrikVideoResampleHandle*	_handle,
                            XDAS_Int32*				_iFormat,
@@ -35,6 +37,9 @@ bool handlePickInputParams(const TrikVideoResampleHandle*	_handle,
                            XDAS_Int32*				_iWidth,
                            XDAS_Int32*				_iLineLength);
 
+/* build resample plans of configured geometry into handle cache, so that first frame does not have to */
+bool handlePrepareResample(TrikVideoResampleHandle* _handle);
+
 
 typedef enum TrikVideoResampleStatus
 {
@@ -49,6 +54,22 @@ typedef enum TrikVideoResampleStatus
 } TrikVideoResampleStatus;
 
 
+/*
+ * Algorithm state of every output stream, reused from frame to frame; NULL cache is allowed,
+ * state is built and dropped within the call then.
+ * Cache object and its plans and scratch rows live in memory supplied by caller, i.e. in IALG memTab record,
+ * sized by estimate for maximum geometry of params (NULL for defaults); whatever does not fit falls back to heap.
+ * Peak is the most of cache memory used so far, it is checked against the estimate by tests.
+ */
+typedef struct TrikVideoResampleCache TrikVideoResampleCache;
+
+size_t resampleCacheSize(const TRIK_VIDTRANSCODE_RESAMPLE_Params* _params);
+size_t resampleCacheAlignment(void);
+TrikVideoResampleCache* resampleCacheCreate(void* _memory, size_t _size);
+void resampleCacheDestroy(TrikVideoResampleCache* _cache);
+size_t resampleCachePeak(const TrikVideoResampleCache* _cache);
+
+
 TrikVideoResampleStatus resampleBuffer(const XDAS_Int8* restrict	_iInBuf,
                                        XDAS_Int32			_iInBufSize,
                                        XDAS_Int32			_iInFormat,
@@ -61,7 +82,33 @@ TrikVideoResampleStatus resampleBuffer(const XDAS_Int8* restrict	_iInBuf,
                                        XDAS_Int32			_iOutFormat,
                                        XDAS_Int32			_iOutHeight,
                                        XDAS_Int32			_iOutWidth,
-                                       XDAS_Int32			_iOutLineLength);
+                                       XDAS_Int32			_iOutLineLength,
+                                       XDAS_Int32			_iAlgorithm,
+                                       TrikVideoResampleCache*	_iCache,
+                                       XDAS_Int32			_iStreamIndex);
+
+
+typedef struct TrikVideoResampleOutput
+{
+  XDAS_Int8*	m_buf;
+  XDAS_Int32	m_bufSize;
+  XDAS_Int32	m_bufUsed;
+  XDAS_Int32	m_format;
+  XDAS_Int32	m_height;
+  XDAS_Int32	m_width;
+  XDAS_Int32	m_lineLength;
+  XDAS_Int32	m_algorithm;
+} TrikVideoResampleOutput;
+
+TrikVideoResampleStatus resampleBufferMulti(const XDAS_Int8* restrict	_iInBuf,
+                                            XDAS_Int32			_iInBufSize,
+                                            XDAS_Int32			_iInFormat,
+                                            XDAS_Int32			_iInHeight,
+                                            XDAS_Int32			_iInWidth,
+                                            XDAS_Int32			_iInLineLength,
+                                            TrikVideoResampleOutput*	_iOutputs,
+                                            XDAS_Int32			_iOutputsCount,
+                                            TrikVideoResampleCache*	_iCache);
 
 
 #ifdef __cplusplus
@@ -18,6 +18,9 @@ typedef struct TrikVideoResampleHandle {
 
     TRIK_VIDTRANSCODE_RESAMPLE_Params		m_params;
     TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams	m_dynamicParams;
+    void*					m_cacheMemory;	/* memTab[1] */
+    Uns						m_cacheMemorySize;	/* granted size of memTab[1], reported back by free() */
+    struct TrikVideoResampleCache*		m_cache;	/* resample state kept between frames, in m_cacheMemory */
 } TrikVideoResampleHandle;
 
 
@@ -0,0 +1,169 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422, const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888, uint8_t>       ImgRGB888o;
+typedef trik::libimage::ImagePlanar<trik::libimage::BaseImagePlanar::PlanarI420, const uint8_t> ImgI420i;
+typedef trik::libimage::ImagePlanar<trik::libimage::BaseImagePlanar::PlanarI420, uint8_t>       ImgI420o;
+
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic,  ImgYUV422i, ImgRGB888o> AlgPacked;
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleBilinear, ImgI420i,   ImgI420o>   AlgPlanar;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+/*
+ * Same pixels in two layouts: rows padded to cache line in aligned buffer,
+ * or tightly packed rows in buffer shifted off cache line by one byte
+ */
+class Layout
+{
+  public:
+    Layout(size_t _height, size_t _lineLength, size_t _tightLineLength, size_t _extraRows, bool _aligned)
+     :m_aligned(_aligned),
+      m_lineLength(_aligned ? _lineLength : _tightLineLength),
+      m_size(m_lineLength * (_height + _extraRows)),
+      m_alignedBuffer(_aligned ? m_size : 0),
+      m_unalignedBuffer(_aligned ? 0 : m_size + 1)
+    {
+    }
+
+    uint8_t* data()
+    {
+      return m_aligned ? m_alignedBuffer.data() : &m_unalignedBuffer[1];
+    }
+
+    const size_t& size() const
+    {
+      return m_size;
+    }
+
+    const size_t& lineLength() const
+    {
+      return m_lineLength;
+    }
+
+  private:
+    bool                         m_aligned;
+    size_t                       m_lineLength;
+    size_t                       m_size;
+    trik::libimage::ImageBuffer  m_alignedBuffer;
+    vector<uint8_t>              m_unalignedBuffer;
+};
+
+
+static void fill(Layout& _layout, size_t _rowBytes, size_t _rows)
+{
+  for (size_t row = 0; row < _rows; ++row)
+    for (size_t col = 0; col < _rowBytes; ++col)
+      _layout.data()[row*_layout.lineLength() + col] = static_cast<uint8_t>((col*7) ^ (row*3));
+}
+
+static uint32_t checksum(Layout& _layout, size_t _rowBytes, size_t _rows)
+{
+  uint32_t sum = 0;
+  for (size_t row = 0; row < _rows; ++row)
+    for (size_t col = 0; col < _rowBytes; ++col)
+      sum = sum*31 + _layout.data()[row*_layout.lineLength() + col];
+  return sum;
+}
+
+
+static double benchmarkPacked(size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight,
+                              size_t _repeat, bool _aligned, uint32_t& _checksum)
+{
+  Layout src(_srcHeight, ImgYUV422i::calcAlignedLineLength(_srcWidth), ImgYUV422i::RowType::calcLineLength(_srcWidth), 0, _aligned);
+  Layout dst(_dstHeight, ImgRGB888o::calcAlignedLineLength(_dstWidth), ImgRGB888o::RowType::calcLineLength(_dstWidth), 0, _aligned);
+  fill(src, ImgYUV422i::RowType::calcLineLength(_srcWidth), _srcHeight);
+
+  ImgYUV422i srcImage(src.data(), src.size(), _srcWidth, _srcHeight, src.lineLength());
+  ImgRGB888o dstImage(dst.data(), dst.size(), _dstWidth, _dstHeight, dst.lineLength());
+
+  AlgPacked algorithm;
+  algorithm(srcImage, dstImage);
+
+  double us = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    algorithm(srcImage, dstImage);
+  us = (nowUs() - us) / _repeat;
+
+  _checksum = checksum(dst, ImgRGB888o::RowType::calcLineLength(_dstWidth), _dstHeight);
+  return us;
+}
+
+
+static double benchmarkPlanar(size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight,
+                              size_t _repeat, bool _aligned, uint32_t& _checksum)
+{
+  // two I420 chroma planes take about half of luma rows each, extra row covers odd line length
+  const size_t srcChromaRows = trik::libimage::BaseImagePlanar::chromaSize(_srcHeight) + 1;
+  const size_t dstChromaRows = trik::libimage::BaseImagePlanar::chromaSize(_dstHeight) + 1;
+  Layout src(_srcHeight, ImgI420i::calcAlignedLineLength(_srcWidth), _srcWidth, srcChromaRows, _aligned);
+  Layout dst(_dstHeight, ImgI420o::calcAlignedLineLength(_dstWidth), _dstWidth, dstChromaRows, _aligned);
+
+  ImgI420i srcImage(src.data(), src.size(), _srcWidth, _srcHeight, src.lineLength());
+  ImgI420o dstImage(dst.data(), dst.size(), _dstWidth, _dstHeight, dst.lineLength());
+  fill(src, _srcWidth, _srcHeight);
+
+  AlgPlanar algorithm;
+  algorithm(srcImage, dstImage);
+
+  double us = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    algorithm(srcImage, dstImage);
+  us = (nowUs() - us) / _repeat;
+
+  // luma plane only, chroma of two layouts has different line length
+  _checksum = checksum(dst, _dstWidth, _dstHeight);
+  return us;
+}
+
+
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 5 || _argc > 6)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> <out-width> <out-height> [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t dstWidth  = atoi(_argv[3]);
+  size_t dstHeight = atoi(_argv[4]);
+  size_t repeat    = _argc > 5 ? atoi(_argv[5]) : 10;
+
+  uint32_t packedAlignedSum;
+  uint32_t packedUnalignedSum;
+  const double packedAlignedUs   = benchmarkPacked(srcWidth, srcHeight, dstWidth, dstHeight, repeat, true,  packedAlignedSum);
+  const double packedUnalignedUs = benchmarkPacked(srcWidth, srcHeight, dstWidth, dstHeight, repeat, false, packedUnalignedSum);
+
+  uint32_t planarAlignedSum;
+  uint32_t planarUnalignedSum;
+  const double planarAlignedUs   = benchmarkPlanar(srcWidth, srcHeight, dstWidth, dstHeight, repeat, true,  planarAlignedSum);
+  const double planarUnalignedUs = benchmarkPlanar(srcWidth, srcHeight, dstWidth, dstHeight, repeat, false, planarUnalignedSum);
+
+  const bool identical = packedAlignedSum == packedUnalignedSum && planarAlignedSum == planarUnalignedSum;
+  cout << srcWidth << "x" << srcHeight << " -> " << dstWidth << "x" << dstHeight << endl
+       << "YUV422 -> RGB888 bicubic: aligned " << packedAlignedUs << "us, unaligned " << packedUnalignedUs << "us" << endl
+       << "I420 -> I420 bilinear:    aligned " << planarAlignedUs << "us, unaligned " << planarUnalignedUs << "us" << endl
+       << (identical ? "identical" : "MISMATCH") << endl;
+
+  return identical ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,139 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+#include <libimage/image_algo_parallel.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422,  const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB565X, uint8_t>       ImgRGB565Xo;
+
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic, ImgYUV422i, ImgRGB565Xo> AlgResample;
+typedef trik::libimage::ImageAlgorithmParallel<AlgResample> AlgResampleParallel;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+// decimated path only picks pixels, so its timing says nothing about interpolation
+static const char* resamplePath(const AlgResample& _algorithm)
+{
+  if (_algorithm.decimation() == 1)
+    return "same size conversion";
+  if (_algorithm.decimation() != 0)
+    return "exact reduction, decimated";
+  return _algorithm.horizontalFirst() ? "interpolated, horizontal first" : "interpolated, vertical first";
+}
+
+
+// false when output differs from serial one
+static bool benchmarkParallel(const ImgYUV422i& _srcImage, const vector<uint8_t>& _serialBuffer,
+                              size_t _dstWidth, size_t _dstHeight, size_t _threads, size_t _repeat,
+                              double& _parallelUs)
+{
+  vector<uint8_t> parallelBuffer(_serialBuffer.size());
+  ImgRGB565Xo parallelImage(&parallelBuffer.front(), parallelBuffer.size(), _dstWidth, _dstHeight, _dstWidth*2);
+
+  AlgResampleParallel parallel;
+  if (!parallel.threads(_threads))
+  {
+    cerr << "Cannot start " << _threads << " threads" << endl;
+    exit(EX_OSERR);
+  }
+
+  if (!parallel(_srcImage, parallelImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  _parallelUs = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    parallel(_srcImage, parallelImage);
+  _parallelUs = (nowUs() - _parallelUs) / _repeat;
+
+  return parallelBuffer == _serialBuffer;
+}
+
+
+// zero threads sweeps 1, 2, 4 and 8 threads
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 5 || _argc > 7)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> <out-width> <out-height> [<threads>|0] [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t dstWidth  = atoi(_argv[3]);
+  size_t dstHeight = atoi(_argv[4]);
+  size_t threads   = _argc > 5 ? atoi(_argv[5]) : 1;
+  size_t repeat    = _argc > 6 ? atoi(_argv[6]) : 10;
+
+  vector<uint8_t> srcBuffer(srcHeight*srcWidth*2);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/(srcWidth*2)*3));
+
+  vector<uint8_t> serialBuffer(dstHeight*dstWidth*2);
+
+  ImgYUV422i  srcImage(&srcBuffer.front(), srcBuffer.size(), srcWidth, srcHeight, srcWidth*2);
+  ImgRGB565Xo serialImage(&serialBuffer.front(), serialBuffer.size(), dstWidth, dstHeight, dstWidth*2);
+
+  AlgResample serial;
+  if (!serial(srcImage, serialImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  double serialUs = nowUs();
+  for (size_t idx = 0; idx < repeat; ++idx)
+    serial(srcImage, serialImage);
+  serialUs = (nowUs() - serialUs) / repeat;
+
+  if (threads != 0)
+  {
+    double parallelUs;
+    const bool identical = benchmarkParallel(srcImage, serialBuffer, dstWidth, dstHeight, threads, repeat, parallelUs);
+
+    cout << "YUV422 " << srcWidth << "x" << srcHeight << " -> RGB565X " << dstWidth << "x" << dstHeight
+         << " (" << resamplePath(serial) << ")"
+         << ": serial " << serialUs << "us, " << threads << " threads " << parallelUs << "us"
+         << (identical ? ", identical" : ", MISMATCH") << endl;
+
+    return identical ? EX_OK : EX_SOFTWARE;
+  }
+
+  // scaling is bounded by online cores, they are reported along with the table
+  cout << "YUV422 " << srcWidth << "x" << srcHeight << " -> RGB565X " << dstWidth << "x" << dstHeight
+       << " (" << resamplePath(serial) << ")"
+       << ", " << sysconf(_SC_NPROCESSORS_ONLN) << " cores online" << endl
+       << "threads\tus\tspeedup" << endl
+       << "serial\t" << serialUs << "\t1" << endl;
+
+  bool identical = true;
+  for (size_t sweepThreads = 1; sweepThreads <= 8; sweepThreads *= 2)
+  {
+    double parallelUs;
+    identical &= benchmarkParallel(srcImage, serialBuffer, dstWidth, dstHeight, sweepThreads, repeat, parallelUs);
+    cout << sweepThreads << "\t" << parallelUs << "\t" << serialUs / parallelUs << endl;
+  }
+
+  cout << (identical ? "identical" : "MISMATCH") << endl;
+  return identical ? EX_OK : EX_SOFTWARE;
+}
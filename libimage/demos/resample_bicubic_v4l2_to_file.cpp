@@ -7,14 +7,21 @@
 #include <stdint.h>
 #include <errno.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
 
 #include <string>
 #include <ios>
 #include <iostream>
 #include <sstream>
+#include <vector>
+#include <memory>
+
+#include <linux/udmabuf.h>
 
 #include <libimage/image.hpp>
 #include <libimage/image_algo.hpp>
+#include <libimage/image_buffer.hpp>
 
 #include "v4l2device.hpp"
 #include "filedevice.hpp"
@@ -26,6 +33,14 @@ using namespace std;
 static trik::libimage::demos::V4L2Input  s_videoSrc(trik::libimage::demos::V4L2Config("/dev/video", 800, 600), "RGB888");
 static trik::libimage::demos::FileOutput s_videoDst(trik::libimage::demos::FileConfig("video.out", 320, 240), "RGB888");
 static size_t s_repeatCount = 1;
+static string s_algorithm("bicubic");
+static string s_srcMemory("mmap");
+
+// capture buffers owned by demo for USERPTR and DMABUF memory; frames are read from them
+// without copying and resampled into separate output buffer
+static const size_t s_srcBuffersCount = 2;
+static vector<shared_ptr<trik::libimage::ImageBuffer> > s_srcUserBuffers;
+static vector<int> s_srcDmabufFds;
 
 
 
@@ -41,6 +56,8 @@ static bool parseConfig(int _argc, char* const _argv[])
     { "dst-height",		1,	NULL,	0 },
     { "dst-format",		1,	NULL,	0 },
     { "repeat",			1,	NULL,	0 },
+    { "algorithm",		1,	NULL,	0 },
+    { "src-memory",		1,	NULL,	0 },
     { "help",			0,	NULL,	'?' },
     { NULL,			0,	NULL,	0 },
   };
@@ -128,6 +145,33 @@ static bool parseConfig(int _argc, char* const _argv[])
             }
             break;
 
+          case 9:
+            if ((istringstream(optarg) >> s_algorithm).fail())
+            {
+              fprintf(stderr, "Cannot parse algorithm argument\n");
+              return false;
+            }
+            break;
+
+          case 10:
+            if ((istringstream(optarg) >> s_srcMemory).fail())
+            {
+              fprintf(stderr, "Cannot parse src-memory argument\n");
+              return false;
+            }
+            else if (s_srcMemory == "mmap")
+              s_videoSrc.config().memory(V4L2_MEMORY_MMAP);
+            else if (s_srcMemory == "userptr")
+              s_videoSrc.config().memory(V4L2_MEMORY_USERPTR);
+            else if (s_srcMemory == "dmabuf")
+              s_videoSrc.config().memory(V4L2_MEMORY_DMABUF);
+            else
+            {
+              fprintf(stderr, "Unknown src-memory %s\n", s_srcMemory.c_str());
+              return false;
+            }
+            break;
+
           default:
             return false;
         }
@@ -149,63 +193,158 @@ static bool parseConfig(int _argc, char* const _argv[])
 
 
 
+class FrameResampler
+{
+  public:
+    virtual ~FrameResampler() {}
+
+    virtual bool operator()(const trik::libimage::demos::V4L2Input::Description&  _srcDesc,
+                            const trik::libimage::demos::V4L2Input::Frame&        _srcFrame,
+                            const trik::libimage::demos::FileOutput::Description& _dstDesc,
+                            trik::libimage::demos::FileOutput::Frame&             _dstFrame) = 0;
+};
+
+
+// algorithm is a member, so resample plan is kept between frames for as long as resampler lives
 template <trik::libimage::BaseImagePixel::PixelType         _PixelTypeSrc,
           trik::libimage::BaseImagePixel::PixelType         _PixelTypeDst,
           trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
-static bool execAlgorithm(const trik::libimage::demos::V4L2Input::Description&  _srcDesc,
-                          const trik::libimage::demos::V4L2Input::Frame&        _srcFrame,
-                          const trik::libimage::demos::FileOutput::Description& _dstDesc,
-                          trik::libimage::demos::FileOutput::Frame&             _dstFrame)
+class FrameResamplerAlgorithm : public FrameResampler
 {
-  typedef trik::libimage::Image<_PixelTypeSrc, const uint8_t>            ImageSrc;
-  typedef trik::libimage::Image<_PixelTypeDst, uint8_t>                  ImageDst;
-  typedef trik::libimage::ImageAlgorithm<_Algorithm, ImageSrc, ImageDst> Algorithm;
-
-  ImageSrc imageSrc(_srcFrame.ptr(), _srcFrame.size(),
-                    _srcDesc.width(), _srcDesc.height(),
-                    _srcDesc.bytesPerLine());
-  ImageDst imageDst(_dstFrame.ptr(), _dstFrame.size(),
-                    _dstDesc.width(), _dstDesc.height(),
-                    _dstDesc.bytesPerLine());
-  Algorithm algorithm;
-
-  if (!algorithm(imageSrc, imageDst))
-  {
-    fprintf(stderr, "algorithm failed\n");
-    return false;
-  }
+  public:
+    virtual bool operator()(const trik::libimage::demos::V4L2Input::Description&  _srcDesc,
+                            const trik::libimage::demos::V4L2Input::Frame&        _srcFrame,
+                            const trik::libimage::demos::FileOutput::Description& _dstDesc,
+                            trik::libimage::demos::FileOutput::Frame&             _dstFrame)
+    {
+      ImageSrc imageSrc(_srcFrame.ptr(), _srcFrame.size(),
+                        _srcDesc.width(), _srcDesc.height(),
+                        _srcDesc.bytesPerLine());
+      ImageDst imageDst(_dstFrame.ptr(), _dstFrame.size(),
+                        _dstDesc.width(), _dstDesc.height(),
+                        _dstDesc.bytesPerLine());
+
+      if (!m_algorithm(imageSrc, imageDst))
+      {
+        fprintf(stderr, "algorithm failed\n");
+        return false;
+      }
 
-  _dstFrame.size(imageDst.actualImageSize());
-  return true;
+      _dstFrame.size(imageDst.actualImageSize());
+      return true;
+    }
+
+  private:
+    typedef trik::libimage::Image<_PixelTypeSrc, const uint8_t>            ImageSrc;
+    typedef trik::libimage::Image<_PixelTypeDst, uint8_t>                  ImageDst;
+    typedef trik::libimage::ImageAlgorithm<_Algorithm, ImageSrc, ImageDst> Algorithm;
+
+    Algorithm m_algorithm;
+};
+
+
+template <trik::libimage::BaseImagePixel::PixelType         _PixelTypeSrc,
+          trik::libimage::BaseImagePixel::PixelType         _PixelTypeDst>
+static FrameResampler* createConversion()
+{
+  if (s_algorithm == "bicubic")
+    return new FrameResamplerAlgorithm<_PixelTypeSrc, _PixelTypeDst,
+                                       trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>();
+  else if (s_algorithm == "area")
+    return new FrameResamplerAlgorithm<_PixelTypeSrc, _PixelTypeDst,
+                                       trik::libimage::BaseImageAlgorithm::AlgoResampleArea>();
+  else if (s_algorithm == "nearest")
+    return new FrameResamplerAlgorithm<_PixelTypeSrc, _PixelTypeDst,
+                                       trik::libimage::BaseImageAlgorithm::AlgoResampleNearest>();
+  else if (s_algorithm == "lanczos2")
+    return new FrameResamplerAlgorithm<_PixelTypeSrc, _PixelTypeDst,
+                                       trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos2>();
+  else if (s_algorithm == "lanczos3")
+    return new FrameResamplerAlgorithm<_PixelTypeSrc, _PixelTypeDst,
+                                       trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos3>();
+
+  fprintf(stderr, "unknown algorithm %s\n", s_algorithm.c_str());
+  return NULL;
 }
 
 
-static bool resample(const trik::libimage::demos::V4L2Input::Description&  _srcDesc,
-                     const trik::libimage::demos::V4L2Input::Frame&        _srcFrame,
-                     const trik::libimage::demos::FileOutput::Description& _dstDesc,
-                     trik::libimage::demos::FileOutput::Frame&             _dstFrame)
+// page aligned user memory, or udmabuf over sealed memfd as stand-in for buffers shared with another device
+static bool importSrcBuffers()
 {
-  if (_srcDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24 && _dstDesc.format().rawFormat() == V4L2_PIX_FMT_RGB565)
+  typedef trik::libimage::demos::V4L2Input V4L2Input;
+
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  const size_t size = trik::alignSize(s_videoSrc.description().bytesPerImage(), pageSize);
+  vector<V4L2Input::ImportBuffer> buffers;
+
+  for (size_t bufIdx = 0; bufIdx < s_srcBuffersCount; ++bufIdx)
   {
-    if (!execAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
-                       trik::libimage::BaseImagePixel::PixelRGB565,
-                       trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>(_srcDesc, _srcFrame, _dstDesc, _dstFrame))
+    if (s_videoSrc.config().memory() == V4L2_MEMORY_USERPTR)
+    {
+      s_srcUserBuffers.push_back(make_shared<trik::libimage::ImageBuffer>(size, pageSize));
+      buffers.push_back(V4L2Input::ImportBuffer(s_srcUserBuffers.back()->data(), size));
+      continue;
+    }
+
+    const int memfd = memfd_create("resample-src", MFD_ALLOW_SEALING);
+    if (memfd < 0)
+    {
+      fprintf(stderr, "memfd_create() failed: %d\n", errno);
       return false;
-  }
-  else if (_srcDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24 && _dstDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24)
-  {
-    if (!execAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
-                       trik::libimage::BaseImagePixel::PixelRGB888,
-                       trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>(_srcDesc, _srcFrame, _dstDesc, _dstFrame))
+    }
+
+    const int udmabuf = open("/dev/udmabuf", O_RDWR);
+    struct udmabuf_create create;
+    memset(&create, 0, sizeof(create));
+    create.memfd  = memfd;
+    create.flags  = UDMABUF_FLAGS_CLOEXEC;
+    create.offset = 0;
+    create.size   = size;
+
+    int dmabufFd = -1;
+    if (   ftruncate(memfd, size) == 0
+        && fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK) == 0
+        && udmabuf >= 0)
+      dmabufFd = ioctl(udmabuf, UDMABUF_CREATE, &create);
+
+    if (udmabuf >= 0)
+      close(udmabuf);
+    close(memfd); // pages are kept by dmabuf
+
+    if (dmabufFd < 0)
+    {
+      fprintf(stderr, "udmabuf of %zu bytes failed: %d\n", size, errno);
       return false;
-  }
-  else
-  {
-    fprintf(stderr, "algorithm does not know requested conversion\n");
-    return false;
+    }
+
+    s_srcDmabufFds.push_back(dmabufFd);
+    buffers.push_back(V4L2Input::ImportBuffer(NULL, size, dmabufFd));
   }
 
-  return true;
+  return s_videoSrc.importBuffers(buffers);
+}
+
+static void releaseSrcBuffers()
+{
+  for (size_t bufIdx = 0; bufIdx < s_srcDmabufFds.size(); ++bufIdx)
+    close(s_srcDmabufFds[bufIdx]);
+  s_srcDmabufFds.clear();
+  s_srcUserBuffers.clear();
+}
+
+
+static FrameResampler* createResampler(const trik::libimage::demos::V4L2Input::Description&  _srcDesc,
+                                       const trik::libimage::demos::FileOutput::Description& _dstDesc)
+{
+  if (_srcDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24 && _dstDesc.format().rawFormat() == V4L2_PIX_FMT_RGB565)
+    return createConversion<trik::libimage::BaseImagePixel::PixelRGB888,
+                            trik::libimage::BaseImagePixel::PixelRGB565>();
+  else if (_srcDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24 && _dstDesc.format().rawFormat() == V4L2_PIX_FMT_RGB24)
+    return createConversion<trik::libimage::BaseImagePixel::PixelRGB888,
+                            trik::libimage::BaseImagePixel::PixelRGB888>();
+
+  fprintf(stderr, "algorithm does not know requested conversion\n");
+  return NULL;
 }
 
 
@@ -227,8 +366,10 @@ int main(int _argc, char* const _argv[])
                     "  --dst-path   <path>\n"
                     "  --dst-width  <width>\n"
                     "  --dst-height <height>\n"
-                    "  --dst-format <format>\n",
-                    "  --repeat     <count>\n",
+                    "  --dst-format <format>\n"
+                    "  --repeat     <count>\n"
+                    "  --algorithm  <bicubic|area|nearest|lanczos2|lanczos3>\n"
+                    "  --src-memory <mmap|userptr|dmabuf>\n",
             _argv[0]);
     exit(EX_USAGE);
   }
@@ -238,8 +379,21 @@ int main(int _argc, char* const _argv[])
   if (!s_videoSrc.open())
     exit(EX_NOINPUT);
 
-  if (!s_videoSrc.start())
-    exit(EX_NOINPUT);
+  // driver refusing our buffers, on request or on first queueing, still captures into its own ones
+  const bool imported = s_videoSrc.config().memory() != V4L2_MEMORY_MMAP;
+  if (!(imported ? importSrcBuffers() && s_videoSrc.start() : s_videoSrc.start()))
+  {
+    if (!imported)
+      exit(EX_NOINPUT);
+
+    fprintf(stderr, "Driver refused %s buffers, falling back to mmap\n", s_srcMemory.c_str());
+    if (!s_videoSrc.mmapBuffers())
+      exit(EX_OSERR);
+    releaseSrcBuffers();
+
+    if (!s_videoSrc.start())
+      exit(EX_NOINPUT);
+  }
 
   if (!s_videoDst.open())
     exit(EX_CANTCREAT);
@@ -247,6 +401,10 @@ int main(int _argc, char* const _argv[])
   if (!s_videoDst.start())
     exit(EX_CANTCREAT);
 
+  const unique_ptr<FrameResampler> resampler(createResampler(s_videoSrc.description(), s_videoDst.description()));
+  if (!resampler)
+    exit(EX_SOFTWARE);
+
   const int videoSrcFd = s_videoSrc.v4l2fd();
 
   for (size_t repeat = 0; repeat < s_repeatCount; ++repeat)
@@ -281,7 +439,7 @@ int main(int _argc, char* const _argv[])
     if (!s_videoDst.getFrame(dstFrame))
       exit(EX_SOFTWARE);
 
-    if (!resample(s_videoSrc.description(), srcFrame, s_videoDst.description(), dstFrame))
+    if (!(*resampler)(s_videoSrc.description(), srcFrame, s_videoDst.description(), dstFrame))
       exit(EX_SOFTWARE);
 
     if (!s_videoDst.putFrame(dstFrame))
@@ -295,6 +453,7 @@ int main(int _argc, char* const _argv[])
   s_videoDst.close();
   s_videoSrc.stop();
   s_videoSrc.close();
+  releaseSrcBuffers();
 
   return EX_OK;
 }
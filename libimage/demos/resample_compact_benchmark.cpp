@@ -0,0 +1,102 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422,  const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB565X, uint8_t>       ImgRGB565Xo;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  const uint8_t> ImgRGB888i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  uint8_t>       ImgRGB888o;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+template <trik::libimage::BaseImageAlgorithm::AlgorithmType _ALG, typename _ImageIn, typename _ImageOut>
+static double benchmark(const vector<uint8_t>& _srcBuffer, size_t _srcWidth, size_t _srcHeight,
+                        vector<uint8_t>& _dstBuffer, size_t _dstWidth, size_t _dstHeight,
+                        size_t _repeat)
+{
+  const size_t srcLineLength = _ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = _ImageOut::RowType::calcLineLength(_dstWidth);
+  _dstBuffer.assign(dstLineLength*_dstHeight, 0);
+
+  _ImageIn  srcImage(&_srcBuffer.front(), _srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  _ImageOut dstImage(&_dstBuffer.front(), _dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+
+  trik::libimage::ImageAlgorithm<_ALG, _ImageIn, _ImageOut> algorithm;
+  if (!algorithm(srcImage, dstImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  double us = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    algorithm(srcImage, dstImage);
+  return (nowUs() - us) / _repeat;
+}
+
+
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 5 || _argc > 6)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> <out-width> <out-height> [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t dstWidth  = atoi(_argv[3]);
+  size_t dstHeight = atoi(_argv[4]);
+  size_t repeat    = _argc > 5 ? atoi(_argv[5]) : 10;
+
+  vector<uint8_t> srcBuffer(srcHeight*srcWidth*3);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/(srcWidth*3)*3));
+
+  // compact intermediates use the same fixed point arithmetic, so output must match fixed engine exactly
+  vector<uint8_t> fixedBuffer;
+  vector<uint8_t> compactBuffer;
+  bool identical = true;
+
+  const double yuvFixedUs   = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubicFixed, ImgYUV422i, ImgRGB565Xo>
+                                (srcBuffer, srcWidth, srcHeight, fixedBuffer, dstWidth, dstHeight, repeat);
+  const double yuvCompactUs = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubicCompact, ImgYUV422i, ImgRGB565Xo>
+                                (srcBuffer, srcWidth, srcHeight, compactBuffer, dstWidth, dstHeight, repeat);
+  identical &= fixedBuffer == compactBuffer;
+
+  const double rgbFixedUs   = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubicFixed, ImgRGB888i, ImgRGB888o>
+                                (srcBuffer, srcWidth, srcHeight, fixedBuffer, dstWidth, dstHeight, repeat);
+  const double rgbCompactUs = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubicCompact, ImgRGB888i, ImgRGB888o>
+                                (srcBuffer, srcWidth, srcHeight, compactBuffer, dstWidth, dstHeight, repeat);
+  identical &= fixedBuffer == compactBuffer;
+
+  const double linFixedUs   = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBilinearFixed, ImgRGB888i, ImgRGB888o>
+                                (srcBuffer, srcWidth, srcHeight, fixedBuffer, dstWidth, dstHeight, repeat);
+  const double linCompactUs = benchmark<trik::libimage::BaseImageAlgorithm::AlgoResampleBilinearCompact, ImgRGB888i, ImgRGB888o>
+                                (srcBuffer, srcWidth, srcHeight, compactBuffer, dstWidth, dstHeight, repeat);
+  identical &= fixedBuffer == compactBuffer;
+
+  cout << srcWidth << "x" << srcHeight << " -> " << dstWidth << "x" << dstHeight << endl
+       << "YUV422 -> RGB565X bicubic:  fixed " << yuvFixedUs << "us, compact " << yuvCompactUs << "us" << endl
+       << "RGB888 -> RGB888 bicubic:   fixed " << rgbFixedUs << "us, compact " << rgbCompactUs << "us" << endl
+       << "RGB888 -> RGB888 bilinear:  fixed " << linFixedUs << "us, compact " << linCompactUs << "us" << endl
+       << (identical ? "identical" : "MISMATCH") << endl;
+
+  return identical ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,120 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::BaseImageAlgorithm BaseAlg;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422,  const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB565X, uint8_t>       ImgRGB565Xo;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  const uint8_t> ImgRGB888i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  uint8_t>       ImgRGB888o;
+
+
+/*
+ * Cost per output pixel of fixed set of cases, best of repeated frames.
+ * Built twice: demo-resample_cycles_benchmark with unchecked rows, demo-resample_cycles_benchmark_checked
+ * with TRIK_LIBIMAGE_CHECKED, so the two tables compare unchecked rows against checked ones on one host.
+ * Checksums of both builds must match. Time stamp counter on x86, nanoseconds elsewhere.
+ */
+#if defined(__i386__) || defined(__x86_64__)
+static const char* s_unit = "cycles";
+
+static uint64_t now()
+{
+  return __rdtsc();
+}
+#else
+static const char* s_unit = "ns";
+
+static uint64_t now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec)*1000000000u + ts.tv_nsec;
+}
+#endif
+
+
+template <BaseAlg::AlgorithmType _ALG, typename _ImageIn, typename _ImageOut>
+static void benchmark(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight,
+                      size_t _repeat)
+{
+  const size_t srcLineLength = _ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = _ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/srcLineLength*3));
+
+  _ImageIn  srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  _ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+
+  trik::libimage::ImageAlgorithm<_ALG, _ImageIn, _ImageOut> algorithm;
+  if (!algorithm(srcImage, dstImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  uint64_t best = 0;
+  for (size_t idx = 0; idx < _repeat; ++idx)
+  {
+    const uint64_t start = now();
+    algorithm(srcImage, dstImage);
+    const uint64_t spent = now() - start;
+    if (idx == 0 || spent < best)
+      best = spent;
+  }
+
+  uint32_t checksum = 0;
+  for (size_t idx = 0; idx < dstBuffer.size(); ++idx)
+    checksum = checksum*31 + dstBuffer[idx];
+
+  cout << left << setw(40) << _name << right << fixed << setprecision(1)
+       << setw(8) << static_cast<double>(best) / (_dstWidth*_dstHeight)
+       << "  " << hex << setw(8) << setfill('0') << checksum << dec << setfill(' ') << endl;
+}
+
+
+int main(int _argc, char* _argv[])
+{
+  if (_argc > 2)
+  {
+    cerr << "Usage: " << _argv[0] << " [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t repeat = _argc > 1 ? atoi(_argv[1]) : 15;
+
+#ifdef TRIK_LIBIMAGE_CHECKED
+  cout << "checked rows";
+#else
+  cout << "unchecked rows";
+#endif
+  cout << ", best of " << repeat << " frames, " << s_unit << " per output pixel, output checksum" << endl;
+
+  benchmark<BaseAlg::AlgoResampleBicubic,  ImgYUV422i, ImgRGB565Xo>("bicubic  YUV422 640x480 -> 480x272", 640, 480, 480, 272, repeat);
+  benchmark<BaseAlg::AlgoResampleBilinear, ImgYUV422i, ImgRGB565Xo>("bilinear YUV422 640x480 -> 480x272", 640, 480, 480, 272, repeat);
+  benchmark<BaseAlg::AlgoResampleBicubic,  ImgYUV422i, ImgRGB565Xo>("bicubic  YUV422 320x240 -> 640x480", 320, 240, 640, 480, repeat);
+  benchmark<BaseAlg::AlgoResampleBicubic,  ImgYUV422i, ImgRGB565Xo>("bicubic  YUV422 640x480 -> 320x240", 640, 480, 320, 240, repeat);
+  benchmark<BaseAlg::AlgoResampleArea,     ImgYUV422i, ImgRGB565Xo>("area     YUV422 640x480 -> 213x157", 640, 480, 213, 157, repeat);
+  benchmark<BaseAlg::AlgoResampleLanczos3, ImgRGB888i, ImgRGB888o> ("lanczos3 RGB888 640x480 -> 480x272", 640, 480, 480, 272, repeat);
+  benchmark<BaseAlg::AlgoResampleNearest,  ImgYUV422i, ImgRGB565Xo>("nearest  YUV422 640x480 -> 480x272", 640, 480, 480, 272, repeat);
+  benchmark<BaseAlg::AlgoConvert,          ImgYUV422i, ImgRGB565Xo>("convert  YUV422 640x480",             640, 480, 640, 480, repeat);
+
+  return EX_OK;
+}
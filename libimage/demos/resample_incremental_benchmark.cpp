@@ -0,0 +1,116 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422,  const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB565X, uint8_t>       ImgRGB565Xo;
+
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic, ImgYUV422i, ImgRGB565Xo> AlgResample;
+typedef trik::libimage::ImageAlgorithmIncremental<AlgResample> AlgResampleIncremental;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+// static background with small moving square, like robot camera looking at one moving object
+static void renderFrame(vector<uint8_t>& _buffer, size_t _width, size_t _height, size_t _frame)
+{
+  for (size_t idx = 0; idx < _buffer.size(); ++idx)
+    _buffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/(_width*2)*3));
+
+  const size_t side = 32;
+  if (_width < side || _height < side)
+    return;
+
+  const size_t left = (_frame * 8) % (_width  - side + 1) & ~static_cast<size_t>(1);
+  const size_t top  = (_frame * 4) % (_height - side + 1);
+  for (size_t row = top; row < top + side; ++row)
+    for (size_t col = left*2; col < (left + side)*2; ++col)
+      _buffer[row*_width*2 + col] = static_cast<uint8_t>(col % 2 == 0 ? 200 : 128);
+}
+
+
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 5 || _argc > 8)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> <out-width> <out-height> [<band-rows>] [<threshold>] [<frames>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t dstWidth  = atoi(_argv[3]);
+  size_t dstHeight = atoi(_argv[4]);
+  size_t bandRows  = _argc > 5 ? atoi(_argv[5]) : 16;
+  unsigned threshold = _argc > 6 ? atoi(_argv[6]) : 0;
+  size_t frames    = _argc > 7 ? atoi(_argv[7]) : 30;
+
+  vector<uint8_t> srcBuffer(srcHeight*srcWidth*2);
+  vector<uint8_t> fullBuffer(dstHeight*dstWidth*2);
+  vector<uint8_t> incrementalBuffer(dstHeight*dstWidth*2);
+
+  ImgYUV422i  srcImage(&srcBuffer.front(), srcBuffer.size(), srcWidth, srcHeight, srcWidth*2);
+  ImgRGB565Xo fullImage(&fullBuffer.front(), fullBuffer.size(), dstWidth, dstHeight, dstWidth*2);
+  ImgRGB565Xo incrementalImage(&incrementalBuffer.front(), incrementalBuffer.size(), dstWidth, dstHeight, dstWidth*2);
+
+  AlgResample full;
+  AlgResampleIncremental incremental(bandRows, threshold);
+
+  double fullUs = 0;
+  double incrementalUs = 0;
+  size_t bandsTotal = 0;
+  size_t bandsRecomputed = 0;
+  bool isIdentical = true;
+
+  for (size_t frame = 0; frame < frames; ++frame)
+  {
+    renderFrame(srcBuffer, srcWidth, srcHeight, frame);
+
+    double us = nowUs();
+    if (!full(srcImage, fullImage))
+    {
+      cerr << "Resampler failed" << endl;
+      exit(EX_DATAERR);
+    }
+    fullUs += nowUs() - us;
+
+    us = nowUs();
+    if (!incremental(srcImage, incrementalImage))
+    {
+      cerr << "Incremental resampler failed" << endl;
+      exit(EX_DATAERR);
+    }
+    incrementalUs += nowUs() - us;
+
+    cout << "frame " << frame << ": recomputed " << incremental.bandsRecomputed() << "/" << incremental.bandsTotal() << " bands" << endl;
+
+    if (frame > 0)
+    {
+      bandsTotal      += incremental.bandsTotal();
+      bandsRecomputed += incremental.bandsRecomputed();
+    }
+    isIdentical &= fullBuffer == incrementalBuffer;
+  }
+
+  cout << "YUV422 " << srcWidth << "x" << srcHeight << " -> RGB565X " << dstWidth << "x" << dstHeight
+       << ": full " << fullUs/frames << "us, incremental " << incrementalUs/frames << "us per frame"
+       << ", recomputed " << (bandsTotal == 0 ? 0.0 : 100.0*bandsRecomputed/bandsTotal) << "% of bands after first frame"
+       << (isIdentical ? ", identical" : ", differs") << endl;
+
+  return isIdentical || threshold > 0 ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,140 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::BaseImageAlgorithm BaseAlg;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422,  const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB565X, uint8_t>       ImgRGB565Xo;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  const uint8_t> ImgRGB888i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888,  uint8_t>       ImgRGB888o;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+// ms per frame after one warm-up frame
+template <BaseAlg::AlgorithmType _ALG, typename _ImageIn, typename _ImageOut>
+static double benchmark(const vector<uint8_t>& _srcBuffer, size_t _srcWidth, size_t _srcHeight,
+                        size_t _dstWidth, size_t _dstHeight, size_t _repeat)
+{
+  const size_t srcLineLength = _ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = _ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+
+  _ImageIn  srcImage(&_srcBuffer.front(), _srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  _ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+
+  trik::libimage::ImageAlgorithm<_ALG, _ImageIn, _ImageOut> algorithm;
+  if (!algorithm(srcImage, dstImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  double us = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    algorithm(srcImage, dstImage);
+  return (nowUs() - us) / _repeat / 1000;
+}
+
+
+// resample path interpolating kernels take for this geometry, they all share the same plan decisions
+template <typename _ImageIn, typename _ImageOut>
+static size_t decimation(const vector<uint8_t>& _srcBuffer, size_t _srcWidth, size_t _srcHeight,
+                         size_t _dstWidth, size_t _dstHeight)
+{
+  const size_t srcLineLength = _ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = _ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+
+  _ImageIn  srcImage(&_srcBuffer.front(), _srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  _ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+
+  trik::libimage::ImageAlgorithm<BaseAlg::AlgoResampleBicubic, _ImageIn, _ImageOut> algorithm;
+  if (!algorithm(srcImage, dstImage))
+  {
+    cerr << "Resampler failed" << endl;
+    exit(EX_DATAERR);
+  }
+  return algorithm.decimation();
+}
+
+
+/*
+ * Exact 2:1, 3:1 and 4:1 reductions are decimated, not interpolated; one more output pixel on each axis
+ * breaks the exact ratio, so that column is the interpolated cost of nearly the same work
+ */
+template <BaseAlg::AlgorithmType _ALG, typename _ImageIn, typename _ImageOut>
+static void benchmarkRow(const char* _name, const vector<uint8_t>& _srcBuffer, size_t _srcWidth, size_t _srcHeight,
+                         size_t _dstWidth, size_t _dstHeight, size_t _repeat, bool _decimated)
+{
+  cout << _name << "\t" << benchmark<_ALG, _ImageIn, _ImageOut>(_srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat);
+  if (_decimated)
+    cout << "\t" << benchmark<_ALG, _ImageIn, _ImageOut>(_srcBuffer, _srcWidth, _srcHeight, _dstWidth+1, _dstHeight+1, _repeat);
+  cout << endl;
+}
+
+template <typename _ImageIn, typename _ImageOut>
+static void benchmarkAll(const char* _formats, size_t _srcWidth, size_t _srcHeight,
+                         size_t _dstWidth, size_t _dstHeight, size_t _repeat)
+{
+  const size_t srcLineLength = _ImageIn::RowType::calcLineLength(_srcWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/srcLineLength*3));
+
+  const size_t factor = decimation<_ImageIn, _ImageOut>(srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight);
+  const bool decimated = factor > 1;
+
+  cout << _formats << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight;
+  if (decimated)
+    cout << " (exact " << factor << ":1 reduction, decimated)" << endl
+         << "algorithm\tms/frame\tms/frame at " << _dstWidth+1 << "x" << _dstHeight+1 << ", interpolated" << endl;
+  else
+    cout << (factor == 1 ? " (same size conversion)" : " (interpolated)") << endl
+         << "algorithm\tms/frame" << endl;
+
+  benchmarkRow<BaseAlg::AlgoResampleNearest,  _ImageIn, _ImageOut>("nearest",  srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, false);
+  benchmarkRow<BaseAlg::AlgoResampleBilinear, _ImageIn, _ImageOut>("bilinear", srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, decimated);
+  benchmarkRow<BaseAlg::AlgoResampleBicubic,  _ImageIn, _ImageOut>("bicubic",  srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, decimated);
+  benchmarkRow<BaseAlg::AlgoResampleLanczos2, _ImageIn, _ImageOut>("lanczos2", srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, decimated);
+  benchmarkRow<BaseAlg::AlgoResampleLanczos3, _ImageIn, _ImageOut>("lanczos3", srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, decimated);
+  benchmarkRow<BaseAlg::AlgoResampleArea,     _ImageIn, _ImageOut>("area",     srcBuffer, _srcWidth, _srcHeight, _dstWidth, _dstHeight, _repeat, false);
+}
+
+
+// every kernel on YUV422 -> RGB565X and RGB888 -> RGB888, same geometry
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 5 || _argc > 6)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> <out-width> <out-height> [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t dstWidth  = atoi(_argv[3]);
+  size_t dstHeight = atoi(_argv[4]);
+  size_t repeat    = _argc > 5 ? atoi(_argv[5]) : 10;
+
+  benchmarkAll<ImgYUV422i, ImgRGB565Xo>("YUV422 -> RGB565X", srcWidth, srcHeight, dstWidth, dstHeight, repeat);
+  benchmarkAll<ImgRGB888i, ImgRGB888o>("RGB888 -> RGB888",   srcWidth, srcHeight, dstWidth, dstHeight, repeat);
+
+  return EX_OK;
+}
@@ -0,0 +1,100 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <time.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelYUV422, const uint8_t> ImgYUV422i;
+typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelRGB888, uint8_t>       ImgRGB888o;
+
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResamplePyramid, ImgYUV422i, ImgRGB888o> AlgPyramid;
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic, ImgYUV422i, ImgRGB888o> AlgBicubic;
+typedef trik::libimage::ImageAlgorithm<trik::libimage::BaseImageAlgorithm::AlgoResampleArea,    ImgYUV422i, ImgRGB888o> AlgArea;
+
+
+static double nowUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+
+template <typename _Algorithm>
+static double benchmarkIndependent(const ImgYUV422i& _srcImage, vector<ImgRGB888o>& _levels, size_t _repeat)
+{
+  vector<_Algorithm> algorithms(_levels.size());
+
+  double us = nowUs();
+  for (size_t idx = 0; idx < _repeat; ++idx)
+    for (size_t level = 0; level < _levels.size(); ++level)
+      algorithms[level](_srcImage, _levels[level]);
+  return (nowUs() - us) / _repeat;
+}
+
+
+int main(int _argc, char* _argv[])
+{
+  if (_argc < 3 || _argc > 5)
+  {
+    cerr << "Usage: " << _argv[0] << " <in-width> <in-height> [<levels>] [<repeat>]" << endl;
+    exit(EX_USAGE);
+  }
+
+  size_t srcWidth  = atoi(_argv[1]);
+  size_t srcHeight = atoi(_argv[2]);
+  size_t levels    = _argc > 3 ? atoi(_argv[3]) : 3;
+  size_t repeat    = _argc > 4 ? atoi(_argv[4]) : 10;
+
+  vector<uint8_t> srcBuffer(srcHeight*srcWidth*2);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = static_cast<uint8_t>((idx*7) ^ (idx/(srcWidth*2)*3));
+  ImgYUV422i srcImage(&srcBuffer.front(), srcBuffer.size(), srcWidth, srcHeight, srcWidth*2);
+
+  vector<vector<uint8_t> > pyramidBuffers(levels);
+  vector<vector<uint8_t> > areaBuffers(levels);
+  vector<ImgRGB888o> pyramidImages;
+  vector<ImgRGB888o> areaImages;
+  for (size_t level = 0, width = srcWidth/2, height = srcHeight/2; level < levels; ++level, width /= 2, height /= 2)
+  {
+    pyramidBuffers[level].resize(width*height*3 + 1);
+    areaBuffers[level].resize(width*height*3 + 1);
+    pyramidImages.push_back(ImgRGB888o(&pyramidBuffers[level].front(), pyramidBuffers[level].size(), width, height, width*3));
+    areaImages.push_back(ImgRGB888o(&areaBuffers[level].front(), areaBuffers[level].size(), width, height, width*3));
+  }
+
+  AlgPyramid pyramid;
+  if (!pyramid(srcImage, &pyramidImages.front(), levels))
+  {
+    cerr << "Pyramid failed" << endl;
+    exit(EX_DATAERR);
+  }
+
+  double pyramidUs = nowUs();
+  for (size_t idx = 0; idx < repeat; ++idx)
+    pyramid(srcImage, &pyramidImages.front(), levels);
+  pyramidUs = (nowUs() - pyramidUs) / repeat;
+
+  const double bicubicUs = benchmarkIndependent<AlgBicubic>(srcImage, areaImages, repeat);
+  const double areaUs    = benchmarkIndependent<AlgArea>(srcImage, areaImages, repeat);
+
+  // box of box is area average of 2^level footprint, only float rounding may differ
+  int maxDiff = 0;
+  for (size_t level = 0; level < levels; ++level)
+    for (size_t idx = 0; idx < areaBuffers[level].size(); ++idx)
+      maxDiff = max(maxDiff, abs(static_cast<int>(pyramidBuffers[level][idx]) - static_cast<int>(areaBuffers[level][idx])));
+
+  cout << "YUV422 " << srcWidth << "x" << srcHeight << " -> RGB888 " << levels << " levels: pyramid " << pyramidUs << "us"
+       << ", independent bicubic " << bicubicUs << "us, independent area " << areaUs << "us"
+       << ", max diff to area " << maxDiff << endl;
+
+  return maxDiff <= 1 ? EX_OK : EX_SOFTWARE;
+}
+
@@ -15,13 +15,32 @@
 #include <map>
 #include <cinttypes>
 #include <sys/mman.h>
+#include <sys/ioctl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
 
 #include <linux/videodev2.h>
+#include <linux/dma-buf.h>
+
+#ifdef TRIK_LIBIMAGE_DEMOS_WITHOUT_LIBV4L2
+// plain kernel interface, without libv4l2 format emulation: device must capture requested format natively
+#include <unistd.h>
+
+static FILE* v4l2_log_file = NULL;
+
+static inline int v4l2_open(const char* _path, int _flags, mode_t _mode) { return ::open(_path, _flags, _mode); }
+static inline int v4l2_close(int _fd) { return ::close(_fd); }
+static inline int v4l2_ioctl(int _fd, unsigned long _request, void* _arg) { return ::ioctl(_fd, _request, _arg); }
+static inline void* v4l2_mmap(void* _start, size_t _length, int _prot, int _flags, int _fd, int64_t _offset)
+{
+  return ::mmap(_start, _length, _prot, _flags, _fd, _offset);
+}
+static inline int v4l2_munmap(void* _start, size_t _length) { return ::munmap(_start, _length); }
+#else
 #include <libv4l2.h>
+#endif
 
 #include "common.hpp"
 
@@ -37,25 +56,29 @@ class V4L2Config : public VideoConfig<V4L2Format>
   public:
     V4L2Config()
      :VideoConfig(),
-      m_path()
+      m_path(),
+      m_memory(V4L2_MEMORY_MMAP)
     {
     }
 
     V4L2Config(const std::string& _path, const VideoDimension& _width, const VideoDimension& _height)
      :VideoConfig(_width, _height),
-      m_path(_path)
+      m_path(_path),
+      m_memory(V4L2_MEMORY_MMAP)
     {
     }
 
     explicit V4L2Config(const VideoFormat::FormatMapPtr& _formatMap)
      :VideoConfig(_formatMap),
-      m_path()
+      m_path(),
+      m_memory(V4L2_MEMORY_MMAP)
     {
     }
 
      V4L2Config(const V4L2Config& _config, const VideoFormat::FormatMapPtr& _formatMap)
       :VideoConfig(_config, _formatMap),
-       m_path(_config.m_path)
+       m_path(_config.m_path),
+       m_memory(_config.m_memory)
     {
     }
 
@@ -63,8 +86,14 @@ class V4L2Config : public VideoConfig<V4L2Format>
     std::string&       path()       { return m_path; }
     void               path(const std::string& _path) { m_path = _path; }
 
+    // V4L2_MEMORY_MMAP buffers are allocated by driver, USERPTR and DMABUF ones are imported, see V4L2Input::importBuffers()
+    const v4l2_memory& memory() const { return m_memory; }
+    v4l2_memory&       memory()       { return m_memory; }
+    void               memory(const v4l2_memory& _memory) { m_memory = _memory; }
+
   private:
     std::string m_path;
+    v4l2_memory m_memory;
 };
 
 
@@ -80,10 +109,25 @@ class V4L2Input
     typedef void*                                   BufferPtr;
     typedef size_t                                  BufferSize;
 
+    /*
+     * Caller owned capture buffer: user memory for V4L2_MEMORY_USERPTR, dmabuf for V4L2_MEMORY_DMABUF.
+     * Dmabuf without CPU mapping is mapped by V4L2Input itself; buffers must outlive close().
+     */
+    struct ImportBuffer
+    {
+      ImportBuffer() : m_ptr(NULL), m_size(0), m_dmabufFd(-1) {}
+      ImportBuffer(BufferPtr _ptr, BufferSize _size, int _dmabufFd = -1) : m_ptr(_ptr), m_size(_size), m_dmabufFd(_dmabufFd) {}
+
+      BufferPtr  m_ptr;
+      BufferSize m_size;
+      int        m_dmabufFd;
+    };
+
     V4L2Input()
      :m_config(knownFormats()),
       m_description(),
       m_v4l2fd(-1),
+      m_v4l2memory(V4L2_MEMORY_MMAP),
       m_v4l2buffers()
     {
     }
@@ -92,6 +136,7 @@ class V4L2Input
      :m_config(_config, knownFormats()),
       m_description(),
       m_v4l2fd(-1),
+      m_v4l2memory(V4L2_MEMORY_MMAP),
       m_v4l2buffers()
     {
       std::istringstream is(_format);
@@ -106,17 +151,48 @@ class V4L2Input
     const Config& config() const { return m_config; }
     Config&       config()       { return m_config; }
 
+    // with imported memory buffers are passed by importBuffers() after open(), when description() is known
     bool open()
     {
       if (   doOpen()
           && doSetFormat()
-          && doMmapBuffers())
+          && (m_config.memory() != V4L2_MEMORY_MMAP || doMmapBuffers()))
         return true;
 
       close();
       return false;
     }
 
+    bool importBuffers(const std::vector<ImportBuffer>& _buffers)
+    {
+      // buffers which are already there are not touched when import is not possible at all
+      if (!canImportBuffers(_buffers))
+        return false;
+
+      if (doImportBuffers(_buffers))
+        return true;
+
+      // no buffers were there before, so everything to release was registered by this call
+      doMunmapBuffers();
+      return false;
+    }
+
+    /*
+     * Driver allocated buffers instead of imported ones, when driver refused them by importBuffers() or start();
+     * imported buffers are released by driver before it returns, so caller may free them afterwards
+     */
+    bool mmapBuffers()
+    {
+      if (m_v4l2fd == -1 || (!m_v4l2buffers.empty() && m_v4l2memory == V4L2_MEMORY_MMAP))
+        return false;
+
+      if (!doMunmapBuffers())
+        return false;
+
+      m_config.memory(V4L2_MEMORY_MMAP);
+      return doMmapBuffers();
+    }
+
     bool close()
     {
       bool isOk = true;
@@ -167,6 +243,12 @@ class V4L2Input
       return doUngetFrame(_index);
     }
 
+    // dmabuf of driver allocated buffer, to be imported by another device or process; caller closes it
+    bool exportBuffer(const FrameIndex& _index, int& _dmabufFd)
+    {
+      return doExportBuffer(_index, _dmabufFd);
+    }
+
   protected:
     static V4L2Config::VideoFormat::FormatMapPtr knownFormats()
     {
@@ -267,6 +349,7 @@ class V4L2Input
           fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_REQBUFS) requested no buffers\n");
         return false;
       }
+      m_v4l2memory = V4L2_MEMORY_MMAP;
       m_v4l2buffers.resize(reqBufs.count);
 
       for (size_t bufIdx = 0; bufIdx < m_v4l2buffers.size(); ++bufIdx)
@@ -295,6 +378,87 @@ class V4L2Input
             fprintf(v4l2_log_file, "v4l2_mmap[%zu] failed: %d\n", bufIdx, errno);
           return false;
         }
+        m_v4l2buffers[bufIdx].m_mapped = true;
+      }
+
+      return true;
+    }
+
+    bool canImportBuffers(const std::vector<ImportBuffer>& _buffers) const
+    {
+      const v4l2_memory memory = m_config.memory();
+      if (   m_v4l2fd == -1
+          || !m_v4l2buffers.empty()
+          || _buffers.empty()
+          || (memory != V4L2_MEMORY_USERPTR && memory != V4L2_MEMORY_DMABUF))
+      {
+        if (v4l2_log_file)
+          fprintf(v4l2_log_file, "importBuffers() requires opened device without buffers in USERPTR or DMABUF memory mode\n");
+        return false;
+      }
+
+      return true;
+    }
+
+    bool doImportBuffers(const std::vector<ImportBuffer>& _buffers)
+    {
+      const v4l2_memory memory = m_config.memory();
+
+      struct v4l2_requestbuffers reqBufs;
+      memset(&reqBufs, 0, sizeof(reqBufs));
+      reqBufs.count = _buffers.size();
+      reqBufs.type = m_v4l2format.type;
+      reqBufs.memory = memory;
+
+      int res;
+      if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_REQBUFS, &reqBufs)) != 0)
+      {
+        if (v4l2_log_file)
+          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_REQBUFS) failed: %d/%d\n", res, errno);
+        return false;
+      }
+
+      if (reqBufs.count <= 0)
+      {
+        if (v4l2_log_file)
+          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_REQBUFS) requested no buffers\n");
+        return false;
+      }
+
+      // driver might raise buffers count, then indexes past imported buffers are never queued
+      m_v4l2memory = memory;
+      m_v4l2buffers.resize(std::min<size_t>(reqBufs.count, _buffers.size()));
+
+      for (size_t bufIdx = 0; bufIdx < m_v4l2buffers.size(); ++bufIdx)
+      {
+        const ImportBuffer& imported = _buffers[bufIdx];
+        if (   imported.m_size < m_description.bytesPerImage()
+            || (memory == V4L2_MEMORY_USERPTR && imported.m_ptr == NULL)
+            || (memory == V4L2_MEMORY_DMABUF  && imported.m_dmabufFd < 0))
+        {
+          if (v4l2_log_file)
+            fprintf(v4l2_log_file, "imported buffer[%zu] of %zu bytes does not fit image of %zu bytes\n",
+                    bufIdx, imported.m_size, m_description.bytesPerImage());
+          return false;
+        }
+
+        Buffer& buffer = m_v4l2buffers[bufIdx];
+        buffer.m_size = imported.m_size;
+        buffer.m_dmabufFd = memory == V4L2_MEMORY_DMABUF ? imported.m_dmabufFd : -1;
+        if (imported.m_ptr != NULL)
+        {
+          buffer.m_ptr = imported.m_ptr;
+          continue;
+        }
+
+        buffer.m_ptr = mmap(NULL, buffer.m_size, PROT_READ, MAP_SHARED, buffer.m_dmabufFd, 0);
+        if (buffer.m_ptr == MAP_FAILED)
+        {
+          if (v4l2_log_file)
+            fprintf(v4l2_log_file, "mmap(dmabuf %d)[%zu] failed: %d\n", buffer.m_dmabufFd, bufIdx, errno);
+          return false;
+        }
+        buffer.m_mapped = true;
       }
 
       return true;
@@ -305,30 +469,94 @@ class V4L2Input
       bool isOk = true;
 
       for (size_t bufIdx = 0; bufIdx < m_v4l2buffers.size(); ++bufIdx)
-        if (m_v4l2buffers[bufIdx].m_ptr != MAP_FAILED)
+        if (m_v4l2buffers[bufIdx].m_mapped)
         {
+          const Buffer& buffer = m_v4l2buffers[bufIdx];
           int res;
-          if ((res = v4l2_munmap(m_v4l2buffers[bufIdx].m_ptr, m_v4l2buffers[bufIdx].m_size)) != 0)
+          if (buffer.m_dmabufFd != -1)
+            res = munmap(buffer.m_ptr, buffer.m_size);
+          else
+            res = v4l2_munmap(buffer.m_ptr, buffer.m_size);
+
+          if (res != 0)
           {
             if (v4l2_log_file)
-              fprintf(v4l2_log_file, "v4l2_munmap(%p)[%zu] failed: %d\n", m_v4l2buffers[bufIdx].m_ptr, bufIdx, errno);
+              fprintf(v4l2_log_file, "munmap(%p)[%zu] failed: %d\n", buffer.m_ptr, bufIdx, errno);
             isOk = false;
           }
         }
 
+      // imported memory is released by driver only when buffers are freed
+      if (   m_v4l2memory != V4L2_MEMORY_MMAP
+          && !m_v4l2buffers.empty()
+          && m_v4l2fd != -1)
+      {
+        struct v4l2_requestbuffers reqBufs;
+        memset(&reqBufs, 0, sizeof(reqBufs));
+        reqBufs.count = 0;
+        reqBufs.type = m_v4l2format.type;
+        reqBufs.memory = m_v4l2memory;
+
+        int res;
+        if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_REQBUFS, &reqBufs)) != 0)
+        {
+          if (v4l2_log_file)
+            fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_REQBUFS, 0) failed: %d/%d\n", res, errno);
+          isOk = false;
+        }
+      }
+
       m_v4l2buffers.resize(0);
       return isOk;
     }
 
+    // imported buffer is passed to driver by pointer or dmabuf fd every time it is queued
+    void fillV4L2Buffer(v4l2_buffer& _buf, size_t _bufIdx) const
+    {
+      memset(&_buf, 0, sizeof(_buf));
+      _buf.index = _bufIdx;
+      _buf.type = m_v4l2format.type;
+      _buf.memory = m_v4l2memory;
+
+      if (m_v4l2memory == V4L2_MEMORY_USERPTR)
+      {
+        _buf.m.userptr = reinterpret_cast<unsigned long>(m_v4l2buffers[_bufIdx].m_ptr);
+        _buf.length = m_v4l2buffers[_bufIdx].m_size;
+      }
+      else if (m_v4l2memory == V4L2_MEMORY_DMABUF)
+      {
+        _buf.m.fd = m_v4l2buffers[_bufIdx].m_dmabufFd;
+        _buf.length = m_v4l2buffers[_bufIdx].m_size;
+      }
+    }
+
+    // CPU reads of dmabuf are bracketed by sync, so that caches are coherent with device writes
+    bool doSyncDmabuf(const FrameIndex& _index, uint64_t _flags)
+    {
+      if (m_v4l2buffers[_index].m_dmabufFd == -1)
+        return true;
+
+      struct dma_buf_sync sync;
+      memset(&sync, 0, sizeof(sync));
+      sync.flags = _flags | DMA_BUF_SYNC_READ;
+
+      int res;
+      if ((res = ioctl(m_v4l2buffers[_index].m_dmabufFd, DMA_BUF_IOCTL_SYNC, &sync)) != 0)
+      {
+        if (v4l2_log_file)
+          fprintf(v4l2_log_file, "ioctl(DMA_BUF_IOCTL_SYNC)[%" PRIu32 "] failed: %d/%d\n", _index, res, errno);
+        return false;
+      }
+
+      return true;
+    }
+
     bool doStart()
     {
       for (size_t bufIdx = 0; bufIdx < m_v4l2buffers.size(); ++bufIdx)
       {
         v4l2_buffer buf;
-        memset(&buf, 0, sizeof(buf));
-        buf.index = bufIdx;
-        buf.type = m_v4l2format.type;
-        buf.memory = V4L2_MEMORY_MMAP;
+        fillV4L2Buffer(buf, bufIdx);
         int res;
         if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_QBUF, &buf)) != 0)
         {
@@ -370,7 +598,7 @@ class V4L2Input
       v4l2_buffer buf;
       memset(&buf, 0, sizeof(buf));
       buf.type = m_v4l2format.type;
-      buf.memory = V4L2_MEMORY_MMAP;
+      buf.memory = m_v4l2memory;
       int res;
       if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_DQBUF, &buf)) != 0)
       {
@@ -383,10 +611,13 @@ class V4L2Input
       if (buf.index >= m_v4l2buffers.size())
       {
         if (v4l2_log_file)
-          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_DQBUF) returned index out range: %"PRIu32"\n", _index);
+          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_DQBUF) returned index out range: %" PRIu32 "\n", _index);
         return false;
       }
 
+      if (!doSyncDmabuf(_index, DMA_BUF_SYNC_START))
+        return false;
+
       _frame = Frame(reinterpret_cast<Frame::Ptr>(m_v4l2buffers[_index].m_ptr),
                      std::min<Frame::Size>(m_v4l2buffers[_index].m_size, m_description.bytesPerImage()));
       return true;
@@ -394,19 +625,46 @@ class V4L2Input
 
     bool doUngetFrame(const FrameIndex& _index)
     {
+      if (_index >= m_v4l2buffers.size())
+        return false;
+
+      if (!doSyncDmabuf(_index, DMA_BUF_SYNC_END))
+        return false;
+
       v4l2_buffer buf;
-      memset(&buf, 0, sizeof(buf));
-      buf.index = _index;
-      buf.type = m_v4l2format.type;
-      buf.memory = V4L2_MEMORY_MMAP;
+      fillV4L2Buffer(buf, _index);
       int res;
       if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_QBUF, &buf)) != 0)
       {
         if (v4l2_log_file)
-          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_QBUF)[%"PRIu32"] failed: %d/%d\n", _index, res, errno);
+          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_QBUF)[%" PRIu32 "] failed: %d/%d\n", _index, res, errno);
+        return false;
+      }
+
+      return true;
+    }
+
+    bool doExportBuffer(const FrameIndex& _index, int& _dmabufFd)
+    {
+      if (   m_v4l2memory != V4L2_MEMORY_MMAP
+          || _index >= m_v4l2buffers.size())
+        return false;
+
+      struct v4l2_exportbuffer expBuf;
+      memset(&expBuf, 0, sizeof(expBuf));
+      expBuf.type = m_v4l2format.type;
+      expBuf.index = _index;
+      expBuf.flags = O_CLOEXEC|O_RDONLY;
+
+      int res;
+      if ((res = v4l2_ioctl(m_v4l2fd, VIDIOC_EXPBUF, &expBuf)) != 0)
+      {
+        if (v4l2_log_file)
+          fprintf(v4l2_log_file, "v4l2_ioctl(VIDIOC_EXPBUF)[%" PRIu32 "] failed: %d/%d\n", _index, res, errno);
         return false;
       }
 
+      _dmabufFd = expBuf.fd;
       return true;
     }
 
@@ -415,15 +673,18 @@ class V4L2Input
     Description m_description;
     int         m_v4l2fd;
     v4l2_format m_v4l2format;
+    v4l2_memory m_v4l2memory;
 
-    struct MmapBuffer
+    struct Buffer
     {
-      MmapBuffer() : m_ptr(MAP_FAILED), m_size(0) {}
+      Buffer() : m_ptr(MAP_FAILED), m_size(0), m_dmabufFd(-1), m_mapped(false) {}
 
       BufferPtr  m_ptr;
       BufferSize m_size;
+      int        m_dmabufFd;
+      bool       m_mapped; // mapped by V4L2Input, so unmapped on close
     };
-    std::vector<MmapBuffer> m_v4l2buffers;
+    std::vector<Buffer> m_v4l2buffers;
 
 
     V4L2Input(const V4L2Input&);
@@ -11,12 +11,10 @@
 #include <libimage/stdcpp.hpp>
 #include <libimage/image_row.hpp>
 #include <libimage/image_pixel.hpp>
+#include <libimage/image_planar.hpp>
+#include <libimage/image_buffer.hpp>
 
 
-#ifdef __GNUC__
-#warning TODO: add 'restrict' to UByteCVs
-#endif
-
 /* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
 /* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
@@ -96,7 +94,7 @@ class ImageAccessor : protected BaseImageAccessor
       return m_ptr;
     }
 
-    bool getRowPtr(_UByteCV*& _rowPtr, size_t _rowIndex) const
+    bool getRowPtr(_UByteCV* TRIK_LIBIMAGE_RESTRICT& _rowPtr, size_t _rowIndex) const
     {
       if (m_ptr == NULL)
         return false;
@@ -138,7 +136,8 @@ class Image : public BaseImage,
   public:
     static const BaseImagePixel::PixelType PT = _PT;
     typedef _UByteCV                UByteCV;
-    typedef ImageRow<_PT, _UByteCV> RowType;
+    typedef ImageRow<_PT, _UByteCV>        RowType;
+    typedef ImageRow<_PT, _UByteCV, false> UncheckedRowType;
 
 
     Image()
@@ -165,9 +164,22 @@ class Image : public BaseImage,
     }
 
 
+    /*
+     * Buffer, line length and width are consistent, so every row holds width pixels
+     * and pixels of rows may be accessed unchecked; checked once per frame by algorithms
+     */
+    bool isValid() const
+    {
+      const size_t rowLength = RowType::calcLineLength(width());
+      return ImageAccessor::getPtr() != NULL
+          && (rowLength > 0 || width() == 0)
+          && rowLength <= ImageAccessor::lineLength()
+          && height() * ImageAccessor::lineLength() <= imageSize();
+    }
+
     bool getRow(RowType& _row, size_t _rowIndex) const
     {
-      _UByteCV* rowPtr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtr;
       if (!ImageAccessor::getRowPtr(rowPtr, _rowIndex))
         return false;
 
@@ -175,8 +187,19 @@ class Image : public BaseImage,
       return true;
     }
 
-    template <size_t _rowsBefore, size_t _rowsAfter>
-    bool getRowSet(ImageRowSet<_PT, _UByteCV, _rowsBefore+1+_rowsAfter>& _rowSet, size_t _baseRow) const
+    // only for image which isValid(), row index is still checked
+    bool getRow(UncheckedRowType& _row, size_t _rowIndex) const
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtr;
+      if (!ImageAccessor::getRowPtr(rowPtr, _rowIndex))
+        return false;
+
+      _row = UncheckedRowType(rowPtr, ImageAccessor::lineLength(), width());
+      return true;
+    }
+
+    template <size_t _rowsBefore, size_t _rowsAfter, bool _checked>
+    bool getRowSet(ImageRowSet<_PT, _UByteCV, _rowsBefore+1+_rowsAfter, _checked>& _rowSet, size_t _baseRow) const
     {
       assert(_rowSet.rowsCount() == _rowsBefore+1+_rowsAfter);
 
@@ -200,7 +223,15 @@ class Image : public BaseImage,
     using ImageAccessor::height;
     using ImageAccessor::imageSize;
     using ImageAccessor::actualImageSize;
+    using ImageAccessor::lineLength;
     using ImageAccessor::getPtr;
+    using ImageAccessor::getRowPtr;
+
+    // line length padded so that every row of aligned buffer, see ImageBuffer, starts at cache line
+    static size_t calcAlignedLineLength(size_t _width, size_t _alignment = s_cacheLineSize)
+    {
+      return alignSize(RowType::calcLineLength(_width), _alignment);
+    }
 
   protected:
     static size_t fixupLineLength(size_t _width, size_t _lineLength)
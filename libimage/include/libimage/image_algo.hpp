@@ -19,7 +19,17 @@ class BaseImageAlgorithm
     enum AlgorithmType
     {
       AlgoResampleBicubic,
-      AlgoResampleBilinear
+      AlgoResampleBilinear,
+      AlgoResampleBicubicFixed,
+      AlgoResampleBilinearFixed,
+      AlgoResampleBicubicCompact,
+      AlgoResampleBilinearCompact,
+      AlgoResampleArea,
+      AlgoResampleNearest,
+      AlgoResampleLanczos2,
+      AlgoResampleLanczos3,
+      AlgoConvert,
+      AlgoResamplePyramid
     };
 
   protected:
@@ -40,6 +50,15 @@ class ImageAlgorithm : public BaseImageAlgorithm,
 
 #include <libimage/image_algo_cubic.hpp>
 #include <libimage/image_algo_linear.hpp>
+#include <libimage/image_algo_area.hpp>
+#include <libimage/image_algo_nearest.hpp>
+#include <libimage/image_algo_lanczos.hpp>
+#include <libimage/image_algo_convert.hpp>
+#include <libimage/image_algo_multi.hpp>
+#include <libimage/image_algo_pyramid.hpp>
+#include <libimage/image_algo_incremental.hpp>
+#include <libimage/image_algo_planar.hpp>
+#include <libimage/image_algo_gray.hpp>
 
 
 #endif // !TRIK_LIBIMAGE_IMAGE_ALGO_HPP_
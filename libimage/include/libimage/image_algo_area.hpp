@@ -0,0 +1,575 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_AREA_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_AREA_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <algorithm>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Area plan for single dimension: output pixel covers [idxOut*sizeIn, (idxOut+1)*sizeIn) in units of 1/sizeOut
+ * of input pixel. Only first and last input pixels of footprint may be covered partially, all inner ones
+ * share one weight, so inner pixels are summed as is and multiplied once.
+ * Computed in integers, so footprints tile input exactly.
+ */
+template <typename _Component>
+class AlgoResampleAreaPlan1Dim
+{
+  public:
+    typedef typename _Component::Weight Weight;
+
+    explicit AlgoResampleAreaPlan1Dim(ImageMemoryArena* _arena = NULL)
+     :m_sizeIn(0),
+      m_sizeOut(0),
+      m_entries(typename ImageVector<Entry>::Allocator(_arena))
+    {
+    }
+
+    bool build(size_t _sizeIn, size_t _sizeOut)
+    {
+      if (   m_sizeIn  == _sizeIn
+          && m_sizeOut == _sizeOut
+          && m_entries.size() == _sizeOut)
+        return true;
+
+      m_sizeIn  = 0;
+      m_sizeOut = 0;
+      m_entries.clear();
+
+      if (_sizeOut > 0 && _sizeIn == 0)
+        return false;
+
+      m_entries.reserve(_sizeOut);
+
+      const float footprint = _sizeIn;
+      for (size_t idxOut = 0; idxOut < _sizeOut; ++idxOut)
+      {
+        const size_t begin = idxOut * _sizeIn;
+        const size_t end   = begin + _sizeIn;
+        const size_t first = begin / _sizeOut;
+        const size_t last  = (end - 1) / _sizeOut;
+
+        Entry entry(first, last - first + 1);
+        if (entry.m_count == 1)
+          entry.m_weightFirst = _Component::weight(1.0f);
+        else
+        {
+          entry.m_weightFirst = _Component::weight(((first+1) * _sizeOut - begin) / footprint);
+          entry.m_weightInner = _Component::weight(_sizeOut / footprint);
+          entry.m_weightLast  = _Component::weight((end - last * _sizeOut) / footprint);
+
+          // rounded weights must still sum to exactly 1.0, put the error on larger edge weight
+          const Weight error = _Component::weight(1.0f)
+                             - entry.m_weightFirst
+                             - entry.m_weightLast
+                             - entry.m_weightInner * static_cast<Weight>(entry.m_count - 2);
+          if (entry.m_weightFirst > entry.m_weightLast)
+            entry.m_weightFirst += error;
+          else
+            entry.m_weightLast += error;
+        }
+
+        m_entries.push_back(entry);
+      }
+
+      m_sizeIn  = _sizeIn;
+      m_sizeOut = _sizeOut;
+      return true;
+    }
+
+    const size_t& sizeIn() const
+    {
+      return m_sizeIn;
+    }
+
+    const size_t& sizeOut() const
+    {
+      return m_sizeOut;
+    }
+
+    const size_t& first(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_first;
+    }
+
+    const size_t& count(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_count;
+    }
+
+    const Weight& weightFirst(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_weightFirst;
+    }
+
+    const Weight& weightInner(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_weightInner;
+    }
+
+    const Weight& weightLast(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_weightLast;
+    }
+
+  private:
+    struct Entry
+    {
+      Entry(size_t _first, size_t _count)
+       :m_first(_first),
+        m_count(_count),
+        m_weightFirst(),
+        m_weightInner(),
+        m_weightLast()
+      {
+      }
+
+      size_t m_first;
+      size_t m_count;
+      Weight m_weightFirst;
+      Weight m_weightInner;
+      Weight m_weightLast;
+    };
+
+    size_t             m_sizeIn;
+    size_t             m_sizeOut;
+    typename ImageVector<Entry>::Type m_entries;
+};
+
+
+
+
+/*
+ * Area averaging resample.
+ * Every input row is read and horizontally integrated once: rows shared by two output footprints
+ * are kept in a two-row cache, inner rows of footprint are summed directly into running sum.
+ * Cost is proportional to input size, alias-free for any reduction factor.
+ */
+template <typename _Component, typename _ImageIn, typename _ImageOut>
+class AlgoResampleArea
+{
+  private:
+    typedef ImagePixel<_ImageIn::PT,  _Component> PixelIn;
+    typedef ImagePixel<_ImageOut::PT, _Component> PixelOut;
+
+    typedef ImagePixelConvertion<PixelIn, PixelOut> PixelIn2OutConvertion;
+
+    typedef AlgoResampleAreaPlan1Dim<_Component> Plan;
+
+    static const size_t s_cacheSize = 2; // footprint first and last rows
+    static const size_t s_cacheRowNone = static_cast<size_t>(-1);
+
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    /*
+     * Scratch state of one band of output rows; bands with distinct states can be resampled concurrently
+     */
+    class BandState
+    {
+      public:
+        explicit BandState(ImageMemoryArena* _arena = NULL)
+         :m_cache(typename ImageVector<PixelIn>::Allocator(_arena)),
+          m_sum(typename ImageVector<PixelIn>::Allocator(_arena))
+        {
+        }
+
+      private:
+        typename ImageVector<PixelIn>::Type m_cache;
+        typename ImageVector<PixelIn>::Type m_sum;
+
+        friend class AlgoResampleArea;
+    };
+
+    typedef PixelIn UnpackedPixelIn;
+
+    /*
+     * State of one output fed row by row, see streamRow() and streamRows(); holds three output-width rows only
+     */
+    class StreamState
+    {
+      public:
+        explicit StreamState(ImageMemoryArena* _arena = NULL)
+         :m_first(typename ImageVector<PixelIn>::Allocator(_arena)),
+          m_row(typename ImageVector<PixelIn>::Allocator(_arena)),
+          m_sum(typename ImageVector<PixelIn>::Allocator(_arena)),
+          m_rowIdxInNext(0),
+          m_rowIdxOutNext(0)
+        {
+        }
+
+      private:
+        typename ImageVector<PixelIn>::Type m_first;
+        typename ImageVector<PixelIn>::Type m_row;
+        typename ImageVector<PixelIn>::Type m_sum;
+        size_t               m_rowIdxInNext;
+        size_t               m_rowIdxOutNext;
+
+        friend class AlgoResampleArea;
+    };
+
+    // plans and scratch rows are allocated from given arena, heap by default
+    explicit AlgoResampleArea(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena),
+      m_bandState(_arena)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_verticalPlan.build(_heightIn, _heightOut)
+          && m_horizontalPlan.build(_widthIn, _widthOut);
+    }
+
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut& _imageOut)
+    {
+      if (!prepare(_imageIn.width(), _imageIn.height(), _imageOut.width(), _imageOut.height()))
+        return false;
+
+      return resampleBand(_imageIn, _imageOut, 0, _imageOut.height(), m_bandState);
+    }
+
+    /*
+     * Resample output rows [_rowIdxOutBegin, _rowIdxOutEnd) only; plan must be already prepared for the geometry.
+     */
+    bool resampleBand(const _ImageIn& _imageIn,
+                      _ImageOut& _imageOut,
+                      size_t _rowIdxOutBegin,
+                      size_t _rowIdxOutEnd,
+                      BandState& _bandState) const
+    {
+      if (   m_verticalPlan.sizeIn()    != _imageIn.height()
+          || m_verticalPlan.sizeOut()   != _imageOut.height()
+          || m_horizontalPlan.sizeIn()  != _imageIn.width()
+          || m_horizontalPlan.sizeOut() != _imageOut.width()
+          || _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > _imageOut.height()
+          || !_imageIn.isValid()
+          || !_imageOut.isValid())
+        return false;
+
+      const size_t widthOut = _imageOut.width();
+      if (widthOut == 0 || _rowIdxOutBegin == _rowIdxOutEnd)
+        return true;
+
+      _bandState.m_cache.resize(s_cacheSize * widthOut);
+      _bandState.m_sum.resize(widthOut);
+
+      size_t cacheRows[s_cacheSize];
+      for (size_t slot = 0; slot < s_cacheSize; ++slot)
+        cacheRows[slot] = s_cacheRowNone;
+
+      PixelIn* const sum = &_bandState.m_sum.front();
+
+      for (size_t rowIdxOut = _rowIdxOutBegin; rowIdxOut < _rowIdxOutEnd; ++rowIdxOut)
+      {
+        const size_t rowFirst = m_verticalPlan.first(rowIdxOut);
+        const size_t rowCount = m_verticalPlan.count(rowIdxOut);
+
+        const PixelIn* first;
+        if (!cachedRowHorizontal(_imageIn, rowFirst, s_cacheRowNone, cacheRows, _bandState.m_cache, first))
+          return false;
+
+        const PixelIn* last = first;
+        if (rowCount > 1)
+        {
+          for (size_t rowIdxIn = rowFirst+1; rowIdxIn < rowFirst+rowCount-1; ++rowIdxIn)
+            if (!integrateRowHorizontal(_imageIn, rowIdxIn, sum, rowIdxIn != rowFirst+1))
+              return false;
+
+          if (!cachedRowHorizontal(_imageIn, rowFirst+rowCount-1, rowFirst, cacheRows, _bandState.m_cache, last))
+            return false;
+        }
+
+        if (!combineRowVertical(first, last, sum, _imageOut, rowIdxOut))
+          return false;
+      }
+
+      return true;
+    }
+
+    /*
+     * Input rows [_rowIdxInBegin, _rowIdxInEnd) read by output rows [_rowIdxOutBegin, _rowIdxOutEnd); plan must be prepared
+     */
+    bool bandRowsIn(size_t _rowIdxOutBegin, size_t _rowIdxOutEnd,
+                    size_t& _rowIdxInBegin, size_t& _rowIdxInEnd) const
+    {
+      if (   _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > m_verticalPlan.sizeOut())
+        return false;
+
+      if (_rowIdxOutBegin == _rowIdxOutEnd)
+      {
+        _rowIdxInBegin = _rowIdxInEnd = 0;
+        return true;
+      }
+
+      _rowIdxInBegin = m_verticalPlan.first(_rowIdxOutBegin);
+      _rowIdxInEnd   = m_verticalPlan.first(_rowIdxOutEnd-1) + m_verticalPlan.count(_rowIdxOutEnd-1);
+      return true;
+    }
+
+    /*
+     * Row-driven alternative to resampleBand(): every input row is passed in order, either unpacked by caller,
+     * so one unpacked row may feed several outputs, or as slices of packed rows as soon as they are captured.
+     * Output is identical to operator().
+     */
+    bool streamBegin(const _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (   m_verticalPlan.sizeOut()   != _imageOut.height()
+          || m_horizontalPlan.sizeOut() != _imageOut.width()
+          || !_imageOut.isValid())
+        return false;
+
+      _streamState.m_first.resize(_imageOut.width());
+      _streamState.m_row.resize(_imageOut.width());
+      _streamState.m_sum.resize(_imageOut.width());
+      _streamState.m_rowIdxInNext  = 0;
+      _streamState.m_rowIdxOutNext = _imageOut.width() == 0 ? _imageOut.height() : 0;
+
+      return true;
+    }
+
+    // footprints tile input, so every row is needed until all output rows are written
+    bool streamRowNeeded(size_t _rowIdxIn, const StreamState& _streamState) const
+    {
+      (void)_rowIdxIn;
+      return _streamState.m_rowIdxOutNext < m_verticalPlan.sizeOut();
+    }
+
+    bool streamRow(const UnpackedPixelIn* _rowIn, size_t _rowWidthIn, size_t _rowIdxIn,
+                   _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      ImageRowUnpacked<PixelIn> rowIn(_rowIn, _rowWidthIn);
+      return streamRowImpl(rowIn, _rowIdxIn, _imageOut, _streamState);
+    }
+
+    /*
+     * Slice holds input rows [_rowIdxInFirst, _rowIdxInFirst + _slice.height()) of full frame, e.g. one DMA block
+     */
+    bool streamRows(const _ImageIn& _slice, size_t _rowIdxInFirst,
+                    _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (   _slice.width() != m_horizontalPlan.sizeIn()
+          || !_slice.isValid())
+        return false;
+
+      for (size_t rowIdx = 0; rowIdx < _slice.height(); ++rowIdx)
+      {
+        typename _ImageIn::UncheckedRowType rowIn;
+        if (   !_slice.getRow(rowIn, rowIdx)
+            || !streamRowImpl(rowIn, _rowIdxInFirst + rowIdx, _imageOut, _streamState))
+          return false;
+      }
+
+      return true;
+    }
+
+    bool streamEnd(const _ImageOut& _imageOut, const StreamState& _streamState) const
+    {
+      return _streamState.m_rowIdxOutNext == _imageOut.height();
+    }
+
+  private:
+    template <typename _RowIn>
+    bool streamRowImpl(_RowIn& _rowIn, size_t _rowIdxIn,
+                       _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      // inner rows are summed in place, so no row may be skipped
+      if (_rowIdxIn != _streamState.m_rowIdxInNext)
+        return false;
+      ++_streamState.m_rowIdxInNext;
+
+      size_t& rowIdxOut = _streamState.m_rowIdxOutNext;
+      if (rowIdxOut >= m_verticalPlan.sizeOut())
+        return true;
+
+      PixelIn* const sum = &_streamState.m_sum.front();
+
+      const size_t rowFirst = m_verticalPlan.first(rowIdxOut);
+      const size_t rowCount = m_verticalPlan.count(rowIdxOut);
+      if (_rowIdxIn > rowFirst && _rowIdxIn < rowFirst+rowCount-1)
+        return integrateRowHorizontal(_rowIn, sum, _rowIdxIn != rowFirst+1);
+
+      // buffer is swapped into m_first below, pointer stays valid
+      const PixelIn* const row = &_streamState.m_row.front();
+      if (!integrateRowHorizontal(_rowIn, &_streamState.m_row.front(), false))
+        return false;
+
+      for (/*rowIdxOut*/; rowIdxOut < m_verticalPlan.sizeOut(); ++rowIdxOut)
+      {
+        const size_t first = m_verticalPlan.first(rowIdxOut);
+        const size_t count = m_verticalPlan.count(rowIdxOut);
+        if (_rowIdxIn < first)
+          break;
+
+        if (_rowIdxIn == first && count > 1)
+        {
+          _streamState.m_first.swap(_streamState.m_row);
+          break;
+        }
+
+        const PixelIn* const firstRow = count > 1 ? &_streamState.m_first.front() : row;
+        if (!combineRowVertical(firstRow, row, sum, _imageOut, rowIdxOut))
+          return false;
+      }
+
+      return true;
+    }
+
+    bool combineRowVertical(const PixelIn* _first, const PixelIn* _last, const PixelIn* _sum,
+                            _ImageOut& _imageOut, size_t _rowIdxOut) const
+    {
+      typename _ImageOut::UncheckedRowType rowOut;
+      if (!_imageOut.getRow(rowOut, _rowIdxOut))
+        return false;
+
+      const PixelIn2OutConvertion convertion;
+      const size_t rowCount = m_verticalPlan.count(_rowIdxOut);
+      const typename Plan::Weight& weightFirst = m_verticalPlan.weightFirst(_rowIdxOut);
+      const typename Plan::Weight& weightInner = m_verticalPlan.weightInner(_rowIdxOut);
+      const typename Plan::Weight& weightLast  = m_verticalPlan.weightLast(_rowIdxOut);
+
+      bool isOk = true;
+      for (size_t colIdxOut = 0; colIdxOut < _imageOut.width(); ++colIdxOut)
+      {
+        PixelIn result = _first[colIdxOut] * weightFirst;
+        if (rowCount > 1)
+          result += _last[colIdxOut] * weightLast;
+        if (rowCount > 2)
+          result += _sum[colIdxOut] * weightInner;
+
+        PixelOut pixelOut;
+        isOk &= convertion(result, pixelOut);
+        isOk &= rowOut.writePixel(pixelOut);
+      }
+
+      return isOk;
+    }
+
+    // output footprints advance monotonically, so row not pinned by current footprint and oldest one is evicted
+    bool cachedRowHorizontal(const _ImageIn& _imageIn, size_t _rowIdxIn, size_t _rowIdxPinned,
+                             size_t* _cacheRows, typename ImageVector<PixelIn>::Type& _cache, const PixelIn*& _row) const
+    {
+      size_t slot;
+      for (slot = 0; slot < s_cacheSize; ++slot)
+        if (_cacheRows[slot] == _rowIdxIn)
+        {
+          _row = &_cache[slot * m_horizontalPlan.sizeOut()];
+          return true;
+        }
+
+      // unused slot has s_cacheRowNone, which wraps to the least
+      if (_cacheRows[0] == _rowIdxPinned)
+        slot = 1;
+      else if (_cacheRows[1] == _rowIdxPinned)
+        slot = 0;
+      else
+        slot = _cacheRows[0]+1 < _cacheRows[1]+1 ? 0 : 1;
+
+      PixelIn* row = &_cache[slot * m_horizontalPlan.sizeOut()];
+      _cacheRows[slot] = s_cacheRowNone;
+      if (!integrateRowHorizontal(_imageIn, _rowIdxIn, row, false))
+        return false;
+
+      _cacheRows[slot] = _rowIdxIn;
+      _row = row;
+      return true;
+    }
+
+    bool integrateRowHorizontal(const _ImageIn& _imageIn, size_t _rowIdxIn,
+                                PixelIn* _rowOut, bool _accumulate) const
+    {
+      typename _ImageIn::UncheckedRowType rowIn;
+      if (!_imageIn.getRow(rowIn, _rowIdxIn))
+        return false;
+
+      return integrateRowHorizontal(rowIn, _rowOut, _accumulate);
+    }
+
+    template <typename _RowIn>
+    bool integrateRowHorizontal(_RowIn& _rowIn, PixelIn* _rowOut, bool _accumulate) const
+    {
+      bool isOk = true;
+      PixelIn pixel;
+      size_t colIdxIn = 0;
+      isOk &= _rowIn.readPixel(pixel);
+
+      for (size_t colIdxOut = 0; colIdxOut < m_horizontalPlan.sizeOut(); ++colIdxOut)
+      {
+        const size_t colFirst = m_horizontalPlan.first(colIdxOut);
+        const size_t colCount = m_horizontalPlan.count(colIdxOut);
+
+        for (/*colIdxIn*/; colIdxIn < colFirst; ++colIdxIn)
+          isOk &= _rowIn.readPixel(pixel);
+
+        PixelIn result = pixel * m_horizontalPlan.weightFirst(colIdxOut);
+        if (colCount > 1)
+        {
+          PixelIn inner;
+          for (++colIdxIn; colIdxIn < colFirst+colCount-1; ++colIdxIn)
+          {
+            isOk &= _rowIn.readPixel(pixel);
+            inner += pixel;
+          }
+          isOk &= _rowIn.readPixel(pixel);
+
+          result += pixel * m_horizontalPlan.weightLast(colIdxOut);
+          if (colCount > 2)
+            result += inner * m_horizontalPlan.weightInner(colIdxOut);
+        }
+
+        if (_accumulate)
+          _rowOut[colIdxOut] += result;
+        else
+          _rowOut[colIdxOut] = result;
+      }
+
+      return isOk;
+    }
+
+    Plan      m_verticalPlan;
+    Plan      m_horizontalPlan;
+    BandState m_bandState;
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleArea, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleArea<internal::ImagePixelComponentFloat, _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleArea(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_AREA_HPP_
@@ -0,0 +1,219 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_CONVERT_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_CONVERT_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <cstring>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Pixel format conversion of same size images, no interpolation at all.
+ * Same pixel types are copied row by row, others stream readPixel -> convertion -> writePixel.
+ */
+template <typename _ImageIn, typename _ImageOut>
+class AlgoConvert
+{
+  private:
+    typedef ImagePixel<_ImageIn::PT>  PixelIn;
+    typedef ImagePixel<_ImageOut::PT> PixelOut;
+
+    typedef ImagePixelConvertion<PixelIn, PixelOut> PixelIn2OutConvertion;
+
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    class BandState
+    {
+      public:
+        explicit BandState(ImageMemoryArena* = NULL)
+        {
+        }
+    };
+
+    typedef PixelIn UnpackedPixelIn;
+
+    /*
+     * State of one output fed row by row with unpacked input rows, see streamRow()
+     */
+    class StreamState
+    {
+      public:
+        explicit StreamState(ImageMemoryArena* = NULL)
+         :m_rowIdxNext(0)
+        {
+        }
+
+      private:
+        size_t m_rowIdxNext;
+
+        friend class AlgoConvert;
+    };
+
+    // keeps no plans nor scratch rows, arena is accepted for uniform construction only
+    explicit AlgoConvert(ImageMemoryArena* = NULL)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return _widthIn == _widthOut && _heightIn == _heightOut;
+    }
+
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut& _imageOut)
+    {
+      BandState bandState;
+      return resampleBand(_imageIn, _imageOut, 0, _imageOut.height(), bandState);
+    }
+
+    bool resampleBand(const _ImageIn& _imageIn,
+                      _ImageOut& _imageOut,
+                      size_t _rowIdxOutBegin,
+                      size_t _rowIdxOutEnd,
+                      BandState& _bandState) const
+    {
+      (void)_bandState;
+
+      if (   _imageIn.width()  != _imageOut.width()
+          || _imageIn.height() != _imageOut.height()
+          || _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > _imageOut.height()
+          || !_imageIn.isValid()
+          || !_imageOut.isValid())
+        return false;
+
+      for (size_t rowIdx = _rowIdxOutBegin; rowIdx < _rowIdxOutEnd; ++rowIdx)
+        if (!convertRow(_imageIn, _imageOut, rowIdx))
+          return false;
+
+      return true;
+    }
+
+    bool bandRowsIn(size_t _rowIdxOutBegin, size_t _rowIdxOutEnd,
+                    size_t& _rowIdxInBegin, size_t& _rowIdxInEnd) const
+    {
+      if (_rowIdxOutBegin > _rowIdxOutEnd)
+        return false;
+
+      _rowIdxInBegin = _rowIdxOutBegin;
+      _rowIdxInEnd   = _rowIdxOutEnd;
+      return true;
+    }
+
+    /*
+     * Row-driven alternative to resampleBand(), input rows are unpacked by caller and passed in increasing order
+     */
+    bool streamBegin(const _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      _streamState.m_rowIdxNext = 0;
+      return _imageOut.isValid();
+    }
+
+    bool streamRowNeeded(size_t _rowIdxIn, const StreamState& _streamState) const
+    {
+      return _rowIdxIn == _streamState.m_rowIdxNext;
+    }
+
+    bool streamRow(const UnpackedPixelIn* _rowIn, size_t _rowWidthIn, size_t _rowIdxIn,
+                   _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (!streamRowNeeded(_rowIdxIn, _streamState))
+        return true;
+
+      typename _ImageOut::UncheckedRowType rowOut;
+      if (   _rowWidthIn < _imageOut.width()
+          || !_imageOut.getRow(rowOut, _rowIdxIn))
+        return false;
+
+      const PixelIn2OutConvertion convertion;
+      bool isOk = true;
+      for (size_t colIdx = 0; colIdx < _imageOut.width(); ++colIdx)
+      {
+        PixelOut pixelOut;
+        isOk &= convertion(_rowIn[colIdx], pixelOut);
+        isOk &= rowOut.writePixel(pixelOut);
+      }
+
+      ++_streamState.m_rowIdxNext;
+      return isOk;
+    }
+
+    bool streamEnd(const _ImageOut& _imageOut, const StreamState& _streamState) const
+    {
+      return _streamState.m_rowIdxNext == _imageOut.height();
+    }
+
+  private:
+    bool convertRow(const _ImageIn& _imageIn, _ImageOut& _imageOut, size_t _rowIdx) const
+    {
+      if (_ImageIn::PT == _ImageOut::PT)
+      {
+        typename _ImageIn::UByteCV*  TRIK_LIBIMAGE_RESTRICT rowPtrIn;
+        typename _ImageOut::UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtrOut;
+        if (   !_imageIn.getRowPtr(rowPtrIn, _rowIdx)
+            || !_imageOut.getRowPtr(rowPtrOut, _rowIdx))
+          return false;
+
+        memcpy(rowPtrOut, rowPtrIn, _ImageOut::RowType::calcLineLength(_imageOut.width()));
+        return true;
+      }
+
+      typename _ImageIn::UncheckedRowType  rowIn;
+      typename _ImageOut::UncheckedRowType rowOut;
+      if (   !_imageIn.getRow(rowIn, _rowIdx)
+          || !_imageOut.getRow(rowOut, _rowIdx))
+        return false;
+
+      const PixelIn2OutConvertion convertion;
+      bool isOk = true;
+      for (size_t colIdx = 0; colIdx < _imageOut.width(); ++colIdx)
+      {
+        PixelIn  pixelIn;
+        PixelOut pixelOut;
+        isOk &= rowIn.readPixel(pixelIn);
+        isOk &= convertion(pixelIn, pixelOut);
+        isOk &= rowOut.writePixel(pixelOut);
+      }
+
+      return isOk;
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoConvert, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoConvert<_ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoConvert(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_CONVERT_HPP_
@@ -15,7 +15,8 @@
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
 
 
-class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2>
+template <typename _Component>
+class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2, _Component>
 {
   public:
     AlgoInterpolationCubic(const float& _t)
@@ -27,10 +28,11 @@ class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2>
       const float t2 = _t*_t;
       const float t3 = _t*_t*_t;
 
-      m_weight[0] = 0.5 * ( 0*t0 + -1*t1 +  2*t2 + -1*t3 );
-      m_weight[1] = 0.5 * ( 2*t0 +  0*t1 + -5*t2 +  3*t3 );
-      m_weight[2] = 0.5 * ( 0*t0 +  1*t1 +  4*t2 + -3*t3 );
-      m_weight[3] = 0.5 * ( 0*t0 +  0*t1 + -1*t2 +  1*t3 );
+      m_weight[0] = _Component::weight(0.5 * ( 0*t0 + -1*t1 +  2*t2 + -1*t3 ));
+      m_weight[1] = _Component::weight(0.5 * ( 2*t0 +  0*t1 + -5*t2 +  3*t3 ));
+      m_weight[2] = _Component::weight(0.5 * ( 0*t0 +  1*t1 +  4*t2 + -3*t3 ));
+      m_weight[3] = _Component::weight(0.5 * ( 0*t0 +  0*t1 + -1*t2 +  1*t3 ));
+      _Component::fixupWeights(m_weight, s_weightDimension);
     }
 
     template <typename PixelSetIn, typename PixelSetOut>
@@ -40,7 +42,8 @@ class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2>
       typename PixelSetOut::Pixel result;
 
       for (size_t idx = 0; idx < s_weightDimension; ++idx)
-        result += _pixelsIn[idx] * m_weight[idx];
+        result.accumulate(_pixelsIn[idx], m_weight[idx]);
+      result.reduce();
 
       _pixelsOut.insertNewPixel() = result;
 
@@ -57,7 +60,7 @@ class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2>
      *                             [  2, -5,  4, -1 ]
      *                             [ -1,  3, -3,  1 ]
      */
-    float m_weight[s_weightDimension];
+    typename _Component::Weight m_weight[s_weightDimension];
 };
 
 
@@ -69,9 +72,45 @@ class AlgoInterpolationCubic : public BaseAlgoInterpolation1Dim<1, 2>
 template <typename _ImageIn, typename _ImageOut>
 class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, _ImageIn, _ImageOut>
  : public BaseImageAlgorithm,
-   public internal::AlgoResampleVH<internal::AlgoInterpolationCubic, internal::AlgoInterpolationCubic,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat>,
+                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat>,
                                    _ImageIn, _ImageOut>
 {
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicFixed, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed>,
+                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicCompact, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact>,
+                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
 };
 
 
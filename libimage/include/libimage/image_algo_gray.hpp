@@ -0,0 +1,388 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_GRAY_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_GRAY_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+#include <libimage/image_algo_planar.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Luma of packed image seen as single plane, for plane algorithms.
+ * YUV and GRAY8 luma is taken in place and chroma bytes are never read;
+ * RGB luma is computed from packed pixel by integer BT.601 weights in Q16, which sum to exactly 1.0.
+ */
+template <BaseImagePixel::PixelType _PT, typename _UByteCV>
+class ImageLumaPlane : private assert_inst<false> // Generic instance, non-functional
+{
+};
+
+
+template <typename _UByteCV>
+class BaseImageLumaPlanePacked
+{
+  public:
+    typedef _UByteCV UByteCV;
+
+    const size_t& width() const
+    {
+      return m_width;
+    }
+
+    const size_t& height() const
+    {
+      return m_height;
+    }
+
+    // not checked, image is validated once by the algorithm
+    _UByteCV* row(size_t _rowIndex) const
+    {
+      return m_ptr + _rowIndex*m_lineLength;
+    }
+
+  protected:
+    template <typename _Image>
+    explicit BaseImageLumaPlanePacked(const _Image& _image)
+     :m_ptr(_image.getPtr()),
+      m_width(_image.width()),
+      m_height(_image.height()),
+      m_lineLength(_image.lineLength())
+    {
+    }
+
+    static unsigned luma(uint32_t _r, uint32_t _g, uint32_t _b,
+                         uint32_t _weightR, uint32_t _weightG, uint32_t _weightB)
+    {
+      return (_r*_weightR + _g*_weightG + _b*_weightB + (1u<<15)) >> 16;
+    }
+
+  private:
+    _UByteCV* m_ptr;
+    size_t    m_width;
+    size_t    m_height;
+    size_t    m_lineLength;
+};
+
+
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelRGB888, _UByteCV> : public BaseImageLumaPlanePacked<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelRGB888, _UByteCV>& _image)
+     :BaseImageLumaPlanePacked<_UByteCV>(_image)
+    {
+    }
+
+    unsigned sample(const _UByteCV* _row, size_t _column) const
+    {
+      const _UByteCV* ptr = _row + _column*3;
+      return this->luma(ptr[0], ptr[1], ptr[2], 19595, 38470, 7471);
+    }
+};
+
+
+// 5 and 6 bit weights are 8 bit ones scaled by 255/31 and 255/63, so white is still 255
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelRGB565, _UByteCV> : public BaseImageLumaPlanePacked<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelRGB565, _UByteCV>& _image)
+     :BaseImageLumaPlanePacked<_UByteCV>(_image)
+    {
+    }
+
+    unsigned sample(const _UByteCV* _row, size_t _column) const
+    {
+      const _UByteCV* ptr = _row + _column*2;
+      return this->luma(ptr[0] >> 3, ((ptr[0] & 0x07) << 3) | (ptr[1] >> 5), ptr[1] & 0x1f,
+                        161185, 155713, 61455);
+    }
+};
+
+
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelRGB565X, _UByteCV> : public BaseImageLumaPlanePacked<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelRGB565X, _UByteCV>& _image)
+     :BaseImageLumaPlanePacked<_UByteCV>(_image)
+    {
+    }
+
+    unsigned sample(const _UByteCV* _row, size_t _column) const
+    {
+      const _UByteCV* ptr = _row + _column*2;
+      return this->luma(ptr[0] & 0x1f, (ptr[0] >> 5) | ((ptr[1] & 0x07) << 3), ptr[1] >> 3,
+                        161185, 155713, 61455);
+    }
+};
+
+
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelYUV444, _UByteCV> : public ImagePlane<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelYUV444, _UByteCV>& _image)
+     :ImagePlane<_UByteCV>(_image.getPtr()+1, _image.width(), _image.height(), _image.lineLength(), 4)
+    {
+    }
+};
+
+
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelYUV422, _UByteCV> : public ImagePlane<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelYUV422, _UByteCV>& _image)
+     :ImagePlane<_UByteCV>(_image.getPtr(), _image.width(), _image.height(), _image.lineLength(), 2)
+    {
+    }
+};
+
+
+template <typename _UByteCV>
+class ImageLumaPlane<BaseImagePixel::PixelGRAY8, _UByteCV> : public ImagePlane<_UByteCV>
+{
+  public:
+    explicit ImageLumaPlane(const Image<BaseImagePixel::PixelGRAY8, _UByteCV>& _image)
+     :ImagePlane<_UByteCV>(_image.getPtr(), _image.width(), _image.height(), _image.lineLength(), 1)
+    {
+    }
+};
+
+
+template <BaseImagePixel::PixelType _PT, typename _UByteCV>
+ImageLumaPlane<_PT, _UByteCV> lumaPlane(const Image<_PT, _UByteCV>& _image)
+{
+  return ImageLumaPlane<_PT, _UByteCV>(_image);
+}
+
+template <BaseImagePlanar::PlanarType _PT, typename _UByteCV>
+const ImagePlane<_UByteCV>& lumaPlane(const ImagePlanar<_PT, _UByteCV>& _image)
+{
+  return _image.plane(BaseImagePlanar::PlaneY);
+}
+
+
+
+
+/*
+ * GRAY8 output from any input: only luma plane of input is resampled, by single channel plane algorithm
+ */
+template <typename _PlaneAlgorithm, typename _ImageIn, typename _ImageOut>
+class AlgoResampleLuma
+{
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    explicit AlgoResampleLuma(ImageMemoryArena* _arena = NULL)
+     :m_luma(_arena)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_luma.prepare(_widthIn, _heightIn, _widthOut, _heightOut);
+    }
+
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut& _imageOut)
+    {
+      if (!_imageIn.isValid() || !_imageOut.isValid())
+        return false;
+
+      const ImagePlane<typename _ImageOut::UByteCV> planeOut(_imageOut.getPtr(), _imageOut.width(), _imageOut.height(),
+                                                             _imageOut.lineLength(), 1);
+      return m_luma(lumaPlane(_imageIn), planeOut);
+    }
+
+  private:
+    _PlaneAlgorithm m_luma;
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat>,
+                                                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicFixed, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed>,
+                                                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicCompact, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact>,
+                                                                   internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinear, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat>,
+                                                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearFixed, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed>,
+                                                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearCompact, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact>,
+                                                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos2, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat>,
+                                                                   internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos3, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat>,
+                                                                   internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat> >,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleArea, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneArea<internal::ImagePixelComponentFloat>,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleNearest, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneNearest,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+// same size nearest is luma extraction
+template <typename _ImageIn, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoConvert, _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleLuma<internal::AlgoResamplePlaneNearest,
+                                     _ImageIn, Image<BaseImagePixel::PixelGRAY8, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleLuma(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_GRAY_HPP_
@@ -0,0 +1,216 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_INCREMENTAL_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_INCREMENTAL_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+
+
+/*
+ * Incremental resample of consecutive, mostly identical frames.
+ * Output rows are split into bands of full-width rows. Band is resampled again only if some input row
+ * of its footprint, including interpolation window, differs from reference copy of input by more than
+ * threshold in any byte; other bands are copied from last output.
+ * Reference row is refreshed only when detected as changed, so slow drift is caught once it exceeds threshold.
+ * With zero threshold output is identical to _Algorithm.
+ */
+template <typename _Algorithm>
+class ImageAlgorithmIncremental : public _Algorithm,
+                                  private noncopyable
+{
+  public:
+    typedef typename _Algorithm::ImageIn  ImageIn;
+    typedef typename _Algorithm::ImageOut ImageOut;
+
+    // algorithm state, reference and last output rows are allocated from given arena, heap by default
+    explicit ImageAlgorithmIncremental(size_t _bandRows = 16, unsigned _threshold = 0, ImageMemoryArena* _arena = NULL)
+     :_Algorithm(_arena),
+      m_bandRows(std::max<size_t>(_bandRows, 1)),
+      m_threshold(_threshold),
+      m_bandState(_arena),
+      m_reference(ImageVector<unsigned char>::Allocator(_arena)),
+      m_output(ImageVector<unsigned char>::Allocator(_arena)),
+      m_rowsChanged(ImageVector<bool>::Allocator(_arena)),
+      m_referenceValid(false),
+      m_widthIn(0),
+      m_heightIn(0),
+      m_widthOut(0),
+      m_heightOut(0),
+      m_bandsTotal(0),
+      m_bandsRecomputed(0)
+    {
+    }
+
+    size_t bandRows() const
+    {
+      return m_bandRows;
+    }
+
+    bool bandRows(size_t _bandRows)
+    {
+      if (_bandRows == 0)
+        return false;
+
+      m_bandRows = _bandRows;
+      return true;
+    }
+
+    unsigned threshold() const
+    {
+      return m_threshold;
+    }
+
+    void threshold(unsigned _threshold)
+    {
+      m_threshold = _threshold;
+    }
+
+    // next frame is resampled completely
+    void reset()
+    {
+      m_referenceValid = false;
+    }
+
+    // bands of last frame, and how many of them were resampled rather than copied
+    size_t bandsTotal() const
+    {
+      return m_bandsTotal;
+    }
+
+    size_t bandsRecomputed() const
+    {
+      return m_bandsRecomputed;
+    }
+
+    bool operator()(const ImageIn& _imageIn,
+                    ImageOut& _imageOut)
+    {
+      m_bandsTotal      = 0;
+      m_bandsRecomputed = 0;
+
+      if (!_Algorithm::prepare(_imageIn.width(), _imageIn.height(), _imageOut.width(), _imageOut.height()))
+        return false;
+
+      if (   m_widthIn   != _imageIn.width()
+          || m_heightIn  != _imageIn.height()
+          || m_widthOut  != _imageOut.width()
+          || m_heightOut != _imageOut.height())
+      {
+        m_referenceValid = false;
+        m_widthIn   = _imageIn.width();
+        m_heightIn  = _imageIn.height();
+        m_widthOut  = _imageOut.width();
+        m_heightOut = _imageOut.height();
+      }
+
+      const size_t rowBytesIn  = ImageIn::RowType::calcLineLength(m_widthIn);
+      const size_t rowBytesOut = ImageOut::RowType::calcLineLength(m_widthOut);
+      const bool   isFull      = !m_referenceValid;
+
+      m_referenceValid = false;
+      m_reference.resize(m_heightIn * rowBytesIn);
+      m_output.resize(m_heightOut * rowBytesOut);
+      m_rowsChanged.resize(m_heightIn);
+
+      for (size_t rowIdxIn = 0; rowIdxIn < m_heightIn; ++rowIdxIn)
+      {
+        typename ImageIn::UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtrIn;
+        if (!_imageIn.getRowPtr(rowPtrIn, rowIdxIn))
+          return false;
+
+        unsigned char* referenceRow = &m_reference[rowIdxIn * rowBytesIn];
+        m_rowsChanged[rowIdxIn] = isFull || rowChanged(rowPtrIn, referenceRow, rowBytesIn);
+        if (m_rowsChanged[rowIdxIn])
+          memcpy(referenceRow, rowPtrIn, rowBytesIn);
+      }
+
+      for (size_t rowIdxOutBegin = 0; rowIdxOutBegin < m_heightOut; rowIdxOutBegin += m_bandRows)
+      {
+        const size_t rowIdxOutEnd = std::min(rowIdxOutBegin + m_bandRows, m_heightOut);
+
+        size_t rowIdxInBegin;
+        size_t rowIdxInEnd;
+        if (!_Algorithm::bandRowsIn(rowIdxOutBegin, rowIdxOutEnd, rowIdxInBegin, rowIdxInEnd))
+          return false;
+
+        const bool isChanged = std::find(m_rowsChanged.begin() + rowIdxInBegin,
+                                         m_rowsChanged.begin() + rowIdxInEnd,
+                                         true) != m_rowsChanged.begin() + rowIdxInEnd;
+
+        ++m_bandsTotal;
+        if (isChanged)
+        {
+          ++m_bandsRecomputed;
+          if (!_Algorithm::resampleBand(_imageIn, _imageOut, rowIdxOutBegin, rowIdxOutEnd, m_bandState))
+            return false;
+        }
+
+        for (size_t rowIdxOut = rowIdxOutBegin; rowIdxOut < rowIdxOutEnd; ++rowIdxOut)
+        {
+          typename ImageOut::UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtrOut;
+          if (!_imageOut.getRowPtr(rowPtrOut, rowIdxOut))
+            return false;
+
+          unsigned char* outputRow = &m_output[rowIdxOut * rowBytesOut];
+          if (isChanged)
+            memcpy(outputRow, rowPtrOut, rowBytesOut);
+          else
+            memcpy(rowPtrOut, outputRow, rowBytesOut);
+        }
+      }
+
+      m_referenceValid = true;
+      return true;
+    }
+
+  private:
+    typedef typename _Algorithm::BandState BandState;
+
+    size_t                     m_bandRows;
+    unsigned                   m_threshold;
+    BandState                  m_bandState;
+    ImageVector<unsigned char>::Type m_reference;
+    ImageVector<unsigned char>::Type m_output;
+    ImageVector<bool>::Type          m_rowsChanged;
+    bool                       m_referenceValid;
+    size_t                     m_widthIn;
+    size_t                     m_heightIn;
+    size_t                     m_widthOut;
+    size_t                     m_heightOut;
+    size_t                     m_bandsTotal;
+    size_t                     m_bandsRecomputed;
+
+    bool rowChanged(const typename ImageIn::UByteCV* _rowPtrIn, const unsigned char* _referenceRow, size_t _rowBytes) const
+    {
+      if (m_threshold == 0)
+        return memcmp(_rowPtrIn, _referenceRow, _rowBytes) != 0;
+
+      for (size_t idx = 0; idx < _rowBytes; ++idx)
+      {
+        const int diff = static_cast<int>(_rowPtrIn[idx]) - static_cast<int>(_referenceRow[idx]);
+        if (static_cast<unsigned>(diff < 0 ? -diff : diff) > m_threshold)
+          return true;
+      }
+
+      return false;
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_INCREMENTAL_HPP_
@@ -0,0 +1,121 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_LANCZOS_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_LANCZOS_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <cmath>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_algo_resample_vh.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Lanczos-_a windowed sinc, taps at -(_a-1) .. _a around source index.
+ * Weights are evaluated once per plan entry, so sin() is never called per pixel.
+ */
+template <size_t _a, typename _Component>
+class AlgoInterpolationLanczos : public BaseAlgoInterpolation1Dim<_a-1, _a, _Component>
+{
+  public:
+    AlgoInterpolationLanczos(const float& _t)
+    {
+      assert(_t >= 0 && _t <= 1.0);
+
+      float weights[s_weightDimension];
+      float sum = 0;
+      for (size_t idx = 0; idx < s_weightDimension; ++idx)
+      {
+        weights[idx] = lanczos(_t + static_cast<float>(_a-1) - static_cast<float>(idx));
+        sum += weights[idx];
+      }
+
+      // truncated kernel does not sum to 1 exactly, flat areas must stay flat
+      for (size_t idx = 0; idx < s_weightDimension; ++idx)
+        m_weight[idx] = _Component::weight(weights[idx] / sum);
+      _Component::fixupWeights(m_weight, s_weightDimension);
+    }
+
+    template <typename PixelSetIn, typename PixelSetOut>
+    bool operator()(const PixelSetIn& _pixelsIn,
+                    PixelSetOut& _pixelsOut) const
+    {
+      typename PixelSetOut::Pixel result;
+
+      for (size_t idx = 0; idx < s_weightDimension; ++idx)
+        result.accumulate(_pixelsIn[idx], m_weight[idx]);
+      result.reduce();
+
+      _pixelsOut.insertNewPixel() = result;
+
+      return true;
+    }
+
+  private:
+    static const size_t s_weightDimension = 2*_a;
+
+    static float lanczos(const float& _x)
+    {
+      if (_x == 0.0f)
+        return 1.0f;
+
+      // exact zeros at other integers keep zero phase an exact copy of source pixel
+      if (   _x <= -static_cast<float>(_a) || _x >= static_cast<float>(_a)
+          || _x == floorf(_x))
+        return 0.0f;
+
+      const float pix = 3.14159265358979f * _x;
+      return static_cast<float>(_a) * sinf(pix) * sinf(pix / static_cast<float>(_a)) / (pix * pix);
+    }
+
+    typename _Component::Weight m_weight[s_weightDimension];
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos2, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat>,
+                                   internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos3, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat>,
+                                   internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_LANCZOS_HPP_
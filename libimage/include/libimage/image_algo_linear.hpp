@@ -15,15 +15,17 @@
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
 
 
-class AlgoInterpolationLinear : public BaseAlgoInterpolation1Dim<0, 1>
+template <typename _Component>
+class AlgoInterpolationLinear : public BaseAlgoInterpolation1Dim<0, 1, _Component>
 {
   public:
     AlgoInterpolationLinear(const float& _t)
     {
       assert(_t >= 0 && _t <= 1.0);
 
-      m_t0 = 1.0-_t;
-      m_t1 = _t;
+      m_weight[0] = _Component::weight(1.0-_t);
+      m_weight[1] = _Component::weight(_t);
+      _Component::fixupWeights(m_weight, s_weightDimension);
     }
 
     template <typename PixelSetIn, typename PixelSetOut>
@@ -32,8 +34,9 @@ class AlgoInterpolationLinear : public BaseAlgoInterpolation1Dim<0, 1>
     {
       typename PixelSetOut::Pixel result;
 
-      result += _pixelsIn[0] * m_t0;
-      result += _pixelsIn[1] * m_t1;
+      result.accumulate(_pixelsIn[0], m_weight[0]);
+      result.accumulate(_pixelsIn[1], m_weight[1]);
+      result.reduce();
 
       _pixelsOut.insertNewPixel() = result;
 
@@ -41,8 +44,9 @@ class AlgoInterpolationLinear : public BaseAlgoInterpolation1Dim<0, 1>
     }
 
   private:
-    float m_t0;
-    float m_t1;
+    static const size_t s_weightDimension = 2;
+
+    typename _Component::Weight m_weight[s_weightDimension];
 };
 
 
@@ -54,9 +58,45 @@ class AlgoInterpolationLinear : public BaseAlgoInterpolation1Dim<0, 1>
 template <typename _ImageIn, typename _ImageOut>
 class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinear, _ImageIn, _ImageOut>
  : public BaseImageAlgorithm,
-   public internal::AlgoResampleVH<internal::AlgoInterpolationLinear, internal::AlgoInterpolationLinear,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat>,
+                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearFixed, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed>,
+                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed>,
+                                   _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
+};
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearCompact, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact>,
+                                   internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact>,
                                    _ImageIn, _ImageOut>
 {
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleVH(_arena)
+    {
+    }
 };
 
 
@@ -0,0 +1,233 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_MULTI_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_MULTI_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <algorithm>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * One output of multi-output resample, consumes unpacked input rows in increasing order
+ */
+template <typename _ImageIn>
+class BaseImageAlgorithmOutput
+{
+  public:
+    typedef ImagePixel<_ImageIn::PT> UnpackedPixelIn;
+
+    virtual ~BaseImageAlgorithmOutput() {}
+
+    virtual bool prepare(size_t _widthIn, size_t _heightIn) = 0;
+    virtual bool begin(const _ImageIn& _imageIn) = 0;
+    virtual bool rowNeeded(size_t _rowIdxIn) const = 0;
+    virtual bool row(const UnpackedPixelIn* _rowIn, size_t _rowWidthIn, size_t _rowIdxIn) = 0;
+    virtual bool end() = 0;
+
+    virtual size_t actualImageSize() const = 0;
+
+  protected:
+    BaseImageAlgorithmOutput() {}
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+/*
+ * Output image bound to algorithm; algorithm must provide row streaming interface
+ * (UnpackedPixelIn, StreamState, streamBegin, streamRowNeeded, streamRow, streamEnd)
+ */
+template <typename _Algorithm>
+class ImageAlgorithmOutput : public internal::BaseImageAlgorithmOutput<typename _Algorithm::ImageIn>,
+                             private noncopyable
+{
+  public:
+    typedef typename _Algorithm::ImageIn  ImageIn;
+    typedef typename _Algorithm::ImageOut ImageOut;
+    typedef typename internal::BaseImageAlgorithmOutput<ImageIn>::UnpackedPixelIn UnpackedPixelIn;
+
+    // algorithm and stream state are allocated from given arena, heap by default
+    explicit ImageAlgorithmOutput(ImageMemoryArena* _arena = NULL)
+     :m_algorithm(_arena),
+      m_imageOut(),
+      m_streamState(_arena)
+    {
+    }
+
+    ImageAlgorithmOutput(const ImageOut& _imageOut, ImageMemoryArena* _arena = NULL)
+     :m_algorithm(_arena),
+      m_imageOut(_imageOut),
+      m_streamState(_arena)
+    {
+    }
+
+    _Algorithm& algorithm()
+    {
+      return m_algorithm;
+    }
+
+    // rebinding output buffer keeps algorithm plans and scratch of previous frame
+    void imageOut(const ImageOut& _imageOut)
+    {
+      m_imageOut = _imageOut;
+    }
+
+    virtual bool prepare(size_t _widthIn, size_t _heightIn)
+    {
+      return m_algorithm.prepare(_widthIn, _heightIn, m_imageOut.width(), m_imageOut.height());
+    }
+
+    virtual bool begin(const ImageIn& _imageIn)
+    {
+      return prepare(_imageIn.width(), _imageIn.height())
+          && m_algorithm.streamBegin(m_imageOut, m_streamState);
+    }
+
+    virtual bool rowNeeded(size_t _rowIdxIn) const
+    {
+      return m_algorithm.streamRowNeeded(_rowIdxIn, m_streamState);
+    }
+
+    virtual bool row(const UnpackedPixelIn* _rowIn, size_t _rowWidthIn, size_t _rowIdxIn)
+    {
+      return m_algorithm.streamRow(_rowIn, _rowWidthIn, _rowIdxIn, m_imageOut, m_streamState);
+    }
+
+    virtual bool end()
+    {
+      return m_algorithm.streamEnd(m_imageOut, m_streamState);
+    }
+
+    virtual size_t actualImageSize() const
+    {
+      return m_imageOut.actualImageSize();
+    }
+
+  private:
+    _Algorithm                           m_algorithm;
+    ImageOut                             m_imageOut;
+    typename _Algorithm::StreamState     m_streamState;
+};
+
+
+
+
+/*
+ * Resample one input into several outputs of any size, format and algorithm in a single pass:
+ * every input row is read and unpacked once, only if any output still needs it, and fed to all outputs.
+ */
+template <typename _ImageIn>
+class ImageAlgorithmMultiOutput : private noncopyable
+{
+  public:
+    typedef internal::BaseImageAlgorithmOutput<_ImageIn> Output;
+
+    explicit ImageAlgorithmMultiOutput(ImageMemoryArena* _arena = NULL)
+     :m_outputs(typename ImageVector<Output*>::Allocator(_arena)),
+      m_outputsNeeded(ImageVector<bool>::Allocator(_arena)),
+      m_row(typename ImageVector<typename Output::UnpackedPixelIn>::Allocator(_arena))
+    {
+    }
+
+    // output is not owned and must outlive processing
+    void addOutput(Output& _output)
+    {
+      m_outputs.push_back(&_output);
+    }
+
+    void clearOutputs()
+    {
+      m_outputs.clear();
+    }
+
+    // plans of all outputs and shared row for given input geometry, so that first frame has nothing to build
+    bool prepare(size_t _widthIn, size_t _heightIn)
+    {
+      const size_t outputsCount = m_outputs.size();
+      for (size_t idx = 0; idx < outputsCount; ++idx)
+        if (!m_outputs[idx]->prepare(_widthIn, _heightIn))
+          return false;
+
+      m_outputsNeeded.resize(outputsCount);
+      m_row.resize(std::max<size_t>(_widthIn, 1));
+      return true;
+    }
+
+    bool operator()(const _ImageIn& _imageIn)
+    {
+      const size_t outputsCount = m_outputs.size();
+      for (size_t idx = 0; idx < outputsCount; ++idx)
+        if (!m_outputs[idx]->begin(_imageIn))
+          return false;
+
+      m_outputsNeeded.resize(outputsCount);
+      m_row.resize(std::max<size_t>(_imageIn.width(), 1));
+
+      for (size_t rowIdxIn = 0; rowIdxIn < _imageIn.height(); ++rowIdxIn)
+      {
+        bool rowNeeded = false;
+        for (size_t idx = 0; idx < outputsCount; ++idx)
+        {
+          m_outputsNeeded[idx] = m_outputs[idx]->rowNeeded(rowIdxIn);
+          rowNeeded |= m_outputsNeeded[idx];
+        }
+
+        if (!rowNeeded)
+          continue;
+
+        size_t rowWidth;
+        if (!unpackRow(_imageIn, rowIdxIn, rowWidth))
+          return false;
+
+        for (size_t idx = 0; idx < outputsCount; ++idx)
+          if (m_outputsNeeded[idx] && !m_outputs[idx]->row(&m_row.front(), rowWidth, rowIdxIn))
+            return false;
+      }
+
+      bool isOk = true;
+      for (size_t idx = 0; idx < outputsCount; ++idx)
+        isOk &= m_outputs[idx]->end();
+
+      return isOk;
+    }
+
+  private:
+    // row may end early, e.g. odd width of YUV422; outputs see exactly the pixels packed row would give them
+    bool unpackRow(const _ImageIn& _imageIn, size_t _rowIdxIn, size_t& _rowWidth)
+    {
+      typename _ImageIn::RowType rowIn;
+      if (!_imageIn.getRow(rowIn, _rowIdxIn))
+        return false;
+
+      for (_rowWidth = 0; _rowWidth < m_row.size(); ++_rowWidth)
+        if (!rowIn.readPixel(m_row[_rowWidth]))
+          break;
+
+      return true;
+    }
+
+    typename ImageVector<Output*>::Type                           m_outputs;
+    ImageVector<bool>::Type                                       m_outputsNeeded;
+    typename ImageVector<typename Output::UnpackedPixelIn>::Type  m_row;
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_MULTI_HPP_
@@ -0,0 +1,369 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_NEAREST_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_NEAREST_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Bytes per pixel for pixel types where every pixel is stored separately, 0 when pixels share bytes
+ */
+template <BaseImagePixel::PixelType _PT>
+class AlgoResampleNearestPixelBytes
+{
+  public:
+    static const size_t s_bytes = 0;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelRGB565>
+{
+  public:
+    static const size_t s_bytes = 2;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelRGB565X>
+{
+  public:
+    static const size_t s_bytes = 2;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelRGB888>
+{
+  public:
+    static const size_t s_bytes = 3;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelYUV444>
+{
+  public:
+    static const size_t s_bytes = 4;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelGRAY8>
+{
+  public:
+    static const size_t s_bytes = 1;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelRGBA8888>
+{
+  public:
+    static const size_t s_bytes = 4;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelBGRA8888>
+{
+  public:
+    static const size_t s_bytes = 4;
+};
+
+template <>
+class AlgoResampleNearestPixelBytes<BaseImagePixel::PixelXRGB8888>
+{
+  public:
+    static const size_t s_bytes = 4;
+};
+
+
+
+
+/*
+ * Nearest plan for single dimension: index of input pixel which center is nearest to output pixel center
+ */
+class AlgoResampleNearestPlan1Dim
+{
+  public:
+    explicit AlgoResampleNearestPlan1Dim(ImageMemoryArena* _arena = NULL)
+     :m_sizeIn(0),
+      m_sizeOut(0),
+      m_indices(ImageVector<size_t>::Allocator(_arena))
+    {
+    }
+
+    bool build(size_t _sizeIn, size_t _sizeOut)
+    {
+      if (   m_sizeIn  == _sizeIn
+          && m_sizeOut == _sizeOut
+          && m_indices.size() == _sizeOut)
+        return true;
+
+      m_sizeIn  = 0;
+      m_sizeOut = 0;
+      m_indices.clear();
+
+      if (_sizeOut > 0 && _sizeIn == 0)
+        return false;
+
+      m_indices.reserve(_sizeOut);
+      for (size_t idxOut = 0; idxOut < _sizeOut; ++idxOut)
+        m_indices.push_back(((2*idxOut + 1) * _sizeIn) / (2*_sizeOut));
+
+      m_sizeIn  = _sizeIn;
+      m_sizeOut = _sizeOut;
+      return true;
+    }
+
+    const size_t& sizeIn() const
+    {
+      return m_sizeIn;
+    }
+
+    const size_t& sizeOut() const
+    {
+      return m_sizeOut;
+    }
+
+    const size_t& index(size_t _idxOut) const
+    {
+      return m_indices[_idxOut];
+    }
+
+  private:
+    size_t              m_sizeIn;
+    size_t              m_sizeOut;
+    ImageVector<size_t>::Type m_indices;
+};
+
+
+
+
+/*
+ * Nearest neighbour resample.
+ * When input and output pixel types match and pixels do not share bytes, pixels are copied as raw bytes
+ * from precomputed offsets, otherwise source row is unpacked once and picked pixels are converted.
+ * Output row picking the same input row as previous one is copied from it.
+ */
+template <typename _ImageIn, typename _ImageOut>
+class AlgoResampleNearest
+{
+  private:
+    typedef ImagePixel<_ImageIn::PT>  PixelIn;
+    typedef ImagePixel<_ImageOut::PT> PixelOut;
+
+    typedef ImagePixelConvertion<PixelIn, PixelOut> PixelIn2OutConvertion;
+
+    static const size_t s_pixelBytes = _ImageIn::PT == _ImageOut::PT
+                                     ? AlgoResampleNearestPixelBytes<_ImageIn::PT>::s_bytes
+                                     : 0;
+
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    /*
+     * Scratch state of one band of output rows; bands with distinct states can be resampled concurrently
+     */
+    class BandState
+    {
+      public:
+        explicit BandState(ImageMemoryArena* _arena = NULL)
+         :m_rowIn(typename ImageVector<PixelIn>::Allocator(_arena))
+        {
+        }
+
+      private:
+        typename ImageVector<PixelIn>::Type m_rowIn;
+
+        friend class AlgoResampleNearest;
+    };
+
+    // plans and scratch row are allocated from given arena, heap by default
+    explicit AlgoResampleNearest(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena),
+      m_columnOffsets(ImageVector<size_t>::Allocator(_arena)),
+      m_bandState(_arena)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      if (   !m_verticalPlan.build(_heightIn, _heightOut)
+          || !m_horizontalPlan.build(_widthIn, _widthOut))
+        return false;
+
+      m_columnOffsets.resize(_widthOut);
+      for (size_t colIdxOut = 0; colIdxOut < _widthOut; ++colIdxOut)
+        m_columnOffsets[colIdxOut] = m_horizontalPlan.index(colIdxOut) * s_pixelBytes;
+
+      return true;
+    }
+
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut& _imageOut)
+    {
+      if (!prepare(_imageIn.width(), _imageIn.height(), _imageOut.width(), _imageOut.height()))
+        return false;
+
+      return resampleBand(_imageIn, _imageOut, 0, _imageOut.height(), m_bandState);
+    }
+
+    /*
+     * Resample output rows [_rowIdxOutBegin, _rowIdxOutEnd) only; plan must be already prepared for the geometry.
+     */
+    bool resampleBand(const _ImageIn& _imageIn,
+                      _ImageOut& _imageOut,
+                      size_t _rowIdxOutBegin,
+                      size_t _rowIdxOutEnd,
+                      BandState& _bandState) const
+    {
+      if (   m_verticalPlan.sizeIn()    != _imageIn.height()
+          || m_verticalPlan.sizeOut()   != _imageOut.height()
+          || m_horizontalPlan.sizeIn()  != _imageIn.width()
+          || m_horizontalPlan.sizeOut() != _imageOut.width()
+          || _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > _imageOut.height()
+          || !_imageIn.isValid()
+          || !_imageOut.isValid())
+        return false;
+
+      const size_t rowBytesOut = _ImageOut::RowType::calcLineLength(_imageOut.width());
+      typename _ImageOut::UByteCV* rowPtrOutPrev = NULL;
+
+      for (size_t rowIdxOut = _rowIdxOutBegin; rowIdxOut < _rowIdxOutEnd; ++rowIdxOut)
+      {
+        const size_t rowIdxIn = m_verticalPlan.index(rowIdxOut);
+
+        typename _ImageOut::UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtrOut;
+        if (!_imageOut.getRowPtr(rowPtrOut, rowIdxOut))
+          return false;
+
+        if (rowPtrOutPrev != NULL && m_verticalPlan.index(rowIdxOut-1) == rowIdxIn)
+        {
+          memcpy(rowPtrOut, rowPtrOutPrev, rowBytesOut);
+          rowPtrOutPrev = rowPtrOut;
+          continue;
+        }
+
+        if (s_pixelBytes != 0)
+        {
+          typename _ImageIn::UByteCV* TRIK_LIBIMAGE_RESTRICT rowPtrIn;
+          if (!_imageIn.getRowPtr(rowPtrIn, rowIdxIn))
+            return false;
+
+          copyRowBytes(rowPtrIn, rowPtrOut);
+        }
+        else if (!convertRow(_imageIn, rowIdxIn, _imageOut, rowIdxOut, _bandState.m_rowIn))
+          return false;
+
+        rowPtrOutPrev = rowPtrOut;
+      }
+
+      return true;
+    }
+
+    /*
+     * Input rows [_rowIdxInBegin, _rowIdxInEnd) read by output rows [_rowIdxOutBegin, _rowIdxOutEnd); plan must be prepared
+     */
+    bool bandRowsIn(size_t _rowIdxOutBegin, size_t _rowIdxOutEnd,
+                    size_t& _rowIdxInBegin, size_t& _rowIdxInEnd) const
+    {
+      if (   _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > m_verticalPlan.sizeOut())
+        return false;
+
+      if (_rowIdxOutBegin == _rowIdxOutEnd)
+      {
+        _rowIdxInBegin = _rowIdxInEnd = 0;
+        return true;
+      }
+
+      _rowIdxInBegin = m_verticalPlan.index(_rowIdxOutBegin);
+      _rowIdxInEnd   = m_verticalPlan.index(_rowIdxOutEnd-1) + 1;
+      return true;
+    }
+
+  private:
+    void copyRowBytes(typename _ImageIn::UByteCV* _rowPtrIn, typename _ImageOut::UByteCV* _rowPtrOut) const
+    {
+      const size_t widthOut = m_columnOffsets.size();
+      for (size_t colIdxOut = 0; colIdxOut < widthOut; ++colIdxOut)
+      {
+        const typename _ImageIn::UByteCV* pixelIn = _rowPtrIn + m_columnOffsets[colIdxOut];
+        for (size_t idx = 0; idx < s_pixelBytes; ++idx)
+          _rowPtrOut[idx] = pixelIn[idx];
+        _rowPtrOut += s_pixelBytes;
+      }
+    }
+
+    bool convertRow(const _ImageIn& _imageIn, size_t _rowIdxIn,
+                    _ImageOut& _imageOut, size_t _rowIdxOut,
+                    typename ImageVector<PixelIn>::Type& _rowIn) const
+    {
+      typename _ImageIn::UncheckedRowType  rowIn;
+      typename _ImageOut::UncheckedRowType rowOut;
+      if (   !_imageIn.getRow(rowIn, _rowIdxIn)
+          || !_imageOut.getRow(rowOut, _rowIdxOut))
+        return false;
+
+      const size_t widthOut = m_horizontalPlan.sizeOut();
+      const size_t widthIn  = widthOut == 0 ? 0 : m_horizontalPlan.index(widthOut-1) + 1;
+      _rowIn.resize(widthIn);
+
+      bool isOk = true;
+      for (size_t colIdxIn = 0; colIdxIn < widthIn; ++colIdxIn)
+        isOk &= rowIn.readPixel(_rowIn[colIdxIn]);
+
+      const PixelIn2OutConvertion convertion;
+      for (size_t colIdxOut = 0; colIdxOut < widthOut; ++colIdxOut)
+      {
+        PixelOut pixelOut;
+        isOk &= convertion(_rowIn[m_horizontalPlan.index(colIdxOut)], pixelOut);
+        isOk &= rowOut.writePixel(pixelOut);
+      }
+
+      return isOk;
+    }
+
+    AlgoResampleNearestPlan1Dim m_verticalPlan;
+    AlgoResampleNearestPlan1Dim m_horizontalPlan;
+    ImageVector<size_t>::Type   m_columnOffsets;
+    BandState                   m_bandState;
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleNearest, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResampleNearest<_ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResampleNearest(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_NEAREST_HPP_
@@ -0,0 +1,275 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_PARALLEL_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_PARALLEL_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+/*
+ * Band-parallel execution on a persistent pool of POSIX threads.
+ * Host-side only, not included by image_algo.hpp.
+ */
+
+
+#include <pthread.h>
+#include <algorithm>
+#include <vector>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+class BaseImageAlgorithmJobs
+{
+  public:
+    virtual bool runJob(size_t _jobIndex) = 0;
+
+  protected:
+    BaseImageAlgorithmJobs() {}
+    virtual ~BaseImageAlgorithmJobs() {}
+};
+
+
+
+
+/*
+ * Runs jobs [0, jobsCount) on persistent worker threads; calling thread takes jobs as well,
+ * so pool of N threads owns N-1 workers
+ */
+class ImageAlgorithmWorkerPool : private noncopyable
+{
+  public:
+    ImageAlgorithmWorkerPool()
+     :m_workers(),
+      m_jobs(NULL),
+      m_jobsCount(0),
+      m_jobNext(0),
+      m_jobsRunning(0),
+      m_jobsOk(true),
+      m_generation(0),
+      m_exit(false)
+    {
+      pthread_mutex_init(&m_mutex, NULL);
+      pthread_cond_init(&m_wakeup, NULL);
+      pthread_cond_init(&m_done, NULL);
+    }
+
+    ~ImageAlgorithmWorkerPool()
+    {
+      stopWorkers();
+      pthread_cond_destroy(&m_done);
+      pthread_cond_destroy(&m_wakeup);
+      pthread_mutex_destroy(&m_mutex);
+    }
+
+    size_t threads() const
+    {
+      return m_workers.size() + 1;
+    }
+
+    bool threads(size_t _threads)
+    {
+      if (_threads == 0)
+        return false;
+
+      if (_threads == threads())
+        return true;
+
+      stopWorkers();
+
+      m_exit = false;
+      for (size_t idx = 1; idx < _threads; ++idx)
+      {
+        pthread_t worker;
+        if (pthread_create(&worker, NULL, &ImageAlgorithmWorkerPool::workerMain, this) != 0)
+          return false;
+        m_workers.push_back(worker);
+      }
+
+      return true;
+    }
+
+    bool run(BaseImageAlgorithmJobs& _jobs, size_t _jobsCount)
+    {
+      pthread_mutex_lock(&m_mutex);
+      m_jobs        = &_jobs;
+      m_jobsCount   = _jobsCount;
+      m_jobNext     = 0;
+      m_jobsRunning = 0;
+      m_jobsOk      = true;
+      ++m_generation;
+      pthread_cond_broadcast(&m_wakeup);
+
+      runJobsLocked();
+
+      while (m_jobNext < m_jobsCount || m_jobsRunning > 0)
+        pthread_cond_wait(&m_done, &m_mutex);
+
+      const bool isOk = m_jobsOk;
+      m_jobs = NULL;
+      pthread_mutex_unlock(&m_mutex);
+
+      return isOk;
+    }
+
+  private:
+    std::vector<pthread_t>  m_workers;
+    pthread_mutex_t         m_mutex;
+    pthread_cond_t          m_wakeup;
+    pthread_cond_t          m_done;
+
+    BaseImageAlgorithmJobs* m_jobs;
+    size_t                  m_jobsCount;
+    size_t                  m_jobNext;
+    size_t                  m_jobsRunning;
+    bool                    m_jobsOk;
+    size_t                  m_generation;
+    bool                    m_exit;
+
+    static void* workerMain(void* _pool)
+    {
+      static_cast<ImageAlgorithmWorkerPool*>(_pool)->workerLoop();
+      return NULL;
+    }
+
+    void workerLoop()
+    {
+      pthread_mutex_lock(&m_mutex);
+      size_t generationSeen = m_generation;
+      for (;;)
+      {
+        while (!m_exit && generationSeen == m_generation)
+          pthread_cond_wait(&m_wakeup, &m_mutex);
+
+        if (m_exit)
+          break;
+
+        generationSeen = m_generation;
+        runJobsLocked();
+      }
+      pthread_mutex_unlock(&m_mutex);
+    }
+
+    // called and returns with m_mutex locked
+    void runJobsLocked()
+    {
+      while (m_jobs != NULL && m_jobNext < m_jobsCount)
+      {
+        const size_t jobIndex = m_jobNext++;
+        ++m_jobsRunning;
+        pthread_mutex_unlock(&m_mutex);
+
+        const bool isOk = m_jobs->runJob(jobIndex);
+
+        pthread_mutex_lock(&m_mutex);
+        m_jobsOk = m_jobsOk && isOk;
+        --m_jobsRunning;
+      }
+
+      if (m_jobNext >= m_jobsCount && m_jobsRunning == 0)
+        pthread_cond_broadcast(&m_done);
+    }
+
+    void stopWorkers()
+    {
+      pthread_mutex_lock(&m_mutex);
+      m_exit = true;
+      pthread_cond_broadcast(&m_wakeup);
+      pthread_mutex_unlock(&m_mutex);
+
+      for (size_t idx = 0; idx < m_workers.size(); ++idx)
+        pthread_join(m_workers[idx], NULL);
+      m_workers.clear();
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+/*
+ * Splits output rows into bands and resamples them concurrently, each band with its own scratch state.
+ * Plan is built once by calling thread; output is identical to serial _Algorithm.
+ */
+template <typename _Algorithm>
+class ImageAlgorithmParallel : public _Algorithm,
+                               private internal::BaseImageAlgorithmJobs
+{
+  public:
+    typedef typename _Algorithm::ImageIn  ImageIn;
+    typedef typename _Algorithm::ImageOut ImageOut;
+
+    explicit ImageAlgorithmParallel(size_t _threads = 1)
+     :_Algorithm(),
+      internal::BaseImageAlgorithmJobs(),
+      m_pool(),
+      m_bandStates(),
+      m_imageIn(NULL),
+      m_imageOut(NULL),
+      m_bandsCount(0)
+    {
+      threads(_threads);
+    }
+
+    size_t threads() const
+    {
+      return m_pool.threads();
+    }
+
+    bool threads(size_t _threads)
+    {
+      return m_pool.threads(_threads);
+    }
+
+    bool operator()(const ImageIn& _imageIn,
+                    ImageOut& _imageOut)
+    {
+      if (!_Algorithm::prepare(_imageIn.width(), _imageIn.height(), _imageOut.width(), _imageOut.height()))
+        return false;
+
+      m_bandsCount = std::max<size_t>(1, std::min(threads(), _imageOut.height()));
+      if (m_bandStates.size() < m_bandsCount)
+        m_bandStates.resize(m_bandsCount);
+
+      m_imageIn  = &_imageIn;
+      m_imageOut = &_imageOut;
+      const bool isOk = m_pool.run(*this, m_bandsCount);
+      m_imageIn  = NULL;
+      m_imageOut = NULL;
+
+      return isOk;
+    }
+
+  private:
+    typedef typename _Algorithm::BandState BandState;
+
+    internal::ImageAlgorithmWorkerPool m_pool;
+    std::vector<BandState>             m_bandStates;
+    const ImageIn*                     m_imageIn;
+    ImageOut*                          m_imageOut;
+    size_t                             m_bandsCount;
+
+    virtual bool runJob(size_t _band)
+    {
+      const size_t height = m_imageOut->height();
+      const size_t rowIdxOutBegin = (height * _band)     / m_bandsCount;
+      const size_t rowIdxOutEnd   = (height * (_band+1)) / m_bandsCount;
+
+      return _Algorithm::resampleBand(*m_imageIn, *m_imageOut, rowIdxOutBegin, rowIdxOutEnd, m_bandStates[_band]);
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_PARALLEL_HPP_
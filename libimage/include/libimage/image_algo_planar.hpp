@@ -0,0 +1,571 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_PLANAR_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_PLANAR_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <algorithm>
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+#include <libimage/image_planar.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Interpolating resample of one plane, samples are filtered as single component values.
+ * Input is ImagePlane or any view with the same row() and sample() access, output is ImagePlane.
+ * Horizontal first: every input row of vertical window is filtered once into a ring of output width rows,
+ * then output row is vertical combine of ring rows.
+ */
+template <typename _VerticalInterpolation, typename _HorizontalInterpolation>
+class AlgoResamplePlaneVH
+{
+  private:
+    typedef typename _VerticalInterpolation::Component Component;
+    typedef ImagePixelComponents<Component, 1>         Sample;
+
+    typedef AlgoResamplePlan1Dim<_VerticalInterpolation>   VerticalPlan;
+    typedef AlgoResamplePlan1Dim<_HorizontalInterpolation> HorizontalPlan;
+
+    static const size_t s_ringSize    = _VerticalInterpolation::s_windowSize;
+    static const size_t s_ringRowNone = static_cast<size_t>(-1);
+
+  public:
+    explicit AlgoResamplePlaneVH(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena),
+      m_rowIn(typename ImageVector<Sample>::Allocator(_arena)),
+      m_ring(typename ImageVector<Sample>::Allocator(_arena))
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_verticalPlan.build(_heightIn, _heightOut)
+          && m_horizontalPlan.build(_widthIn, _widthOut);
+    }
+
+    template <typename _PlaneIn, typename _UByteCVOut>
+    bool operator()(const _PlaneIn& _planeIn, const ImagePlane<_UByteCVOut>& _planeOut)
+    {
+      if (_planeOut.width() == 0 || _planeOut.height() == 0)
+        return true;
+      if (   _planeIn.width() == 0 || _planeIn.height() == 0
+          || !prepare(_planeIn.width(), _planeIn.height(), _planeOut.width(), _planeOut.height()))
+        return false;
+
+      const size_t widthOut = _planeOut.width();
+      const size_t heightIn = _planeIn.height();
+      m_rowIn.resize(_planeIn.width() + _HorizontalInterpolation::s_windowBefore + _HorizontalInterpolation::s_windowAfter);
+      m_ring.resize(s_ringSize * widthOut);
+
+      size_t ringRows[s_ringSize];
+      for (size_t slot = 0; slot < s_ringSize; ++slot)
+        ringRows[slot] = s_ringRowNone;
+
+      bool isOk = true;
+      for (size_t rowIdxOut = 0; rowIdxOut < _planeOut.height(); ++rowIdxOut)
+      {
+        // window positions are consecutive, so position modulo ring size never collides within one window
+        const Sample* windowRows[s_ringSize];
+        for (size_t idx = 0; idx < s_ringSize; ++idx)
+        {
+          const size_t position = m_verticalPlan.index(rowIdxOut) + idx;
+          const size_t slot     = position % s_ringSize;
+          const size_t rowIdxIn = std::min(position < _VerticalInterpolation::s_windowBefore ? 0 : position - _VerticalInterpolation::s_windowBefore,
+                                           heightIn-1);
+          if (ringRows[slot] != rowIdxIn)
+          {
+            isOk &= resampleRowHorizontal(_planeIn, rowIdxIn, &m_ring[slot * widthOut], widthOut);
+            ringRows[slot] = rowIdxIn;
+          }
+          windowRows[idx] = &m_ring[slot * widthOut];
+        }
+
+        isOk &= combineRowVertical(windowRows, _planeOut, rowIdxOut);
+      }
+
+      return isOk;
+    }
+
+  private:
+    template <typename _PlaneIn>
+    bool resampleRowHorizontal(const _PlaneIn& _planeIn, size_t _rowIdxIn,
+                               Sample* TRIK_LIBIMAGE_RESTRICT _rowOut, size_t _widthOut)
+    {
+      const size_t widthIn = _planeIn.width();
+      const size_t before  = _HorizontalInterpolation::s_windowBefore;
+      const size_t after   = _HorizontalInterpolation::s_windowAfter;
+      typename _PlaneIn::UByteCV* TRIK_LIBIMAGE_RESTRICT rowIn = _planeIn.row(_rowIdxIn);
+
+      Sample* const samples = &m_rowIn[before];
+      for (size_t colIdxIn = 0; colIdxIn < widthIn; ++colIdxIn)
+        samples[colIdxIn][0] = Component::load(_planeIn.sample(rowIn, colIdxIn));
+
+      for (size_t idx = 0; idx < before; ++idx)
+        m_rowIn[idx] = samples[0];
+      for (size_t idx = 0; idx < after; ++idx)
+        samples[widthIn + idx] = samples[widthIn-1];
+
+      ImagePixelRowView<Sample, _HorizontalInterpolation::s_windowSize> window(&m_rowIn[0]);
+      bool isOk = true;
+      for (size_t colIdxOut = 0; colIdxOut < _widthOut; ++colIdxOut)
+      {
+        ImagePixelResultView<Sample> result(_rowOut[colIdxOut]);
+        window.first(m_horizontalPlan.index(colIdxOut));
+        isOk &= m_horizontalPlan.interpolation(colIdxOut)(window, result);
+      }
+
+      return isOk;
+    }
+
+    template <typename _UByteCVOut>
+    bool combineRowVertical(const Sample* const* _windowRows, const ImagePlane<_UByteCVOut>& _planeOut, size_t _rowIdxOut) const
+    {
+      const size_t step = _planeOut.step();
+      _UByteCVOut* TRIK_LIBIMAGE_RESTRICT rowOut = _planeOut.row(_rowIdxOut);
+
+      const _VerticalInterpolation& verticalInterpolation = m_verticalPlan.interpolation(_rowIdxOut);
+      ImagePixelColumnView<Sample, _VerticalInterpolation::s_windowSize> column(_windowRows);
+      bool isOk = true;
+      for (size_t colIdxOut = 0; colIdxOut < _planeOut.width(); ++colIdxOut)
+      {
+        Sample sample;
+        ImagePixelResultView<Sample> result(sample);
+        column.column(colIdxOut);
+        isOk &= verticalInterpolation(column, result);
+        rowOut[colIdxOut * step] = Component::store(sample[0], 0xff);
+      }
+
+      return isOk;
+    }
+
+    VerticalPlan        m_verticalPlan;
+    HorizontalPlan      m_horizontalPlan;
+    typename ImageVector<Sample>::Type m_rowIn;
+    typename ImageVector<Sample>::Type m_ring;
+};
+
+
+
+
+/*
+ * Area averaging resample of one plane, see AlgoResampleArea.
+ * Last row of one footprint is usually first row of the next one, so it is integrated once and kept.
+ */
+template <typename _Component>
+class AlgoResamplePlaneArea
+{
+  private:
+    typedef AlgoResampleAreaPlan1Dim<_Component> Plan;
+    typedef typename _Component::Value           Value;
+
+    static const size_t s_rowNone = static_cast<size_t>(-1);
+
+  public:
+    explicit AlgoResamplePlaneArea(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena),
+      m_first(typename ImageVector<Value>::Allocator(_arena)),
+      m_last(typename ImageVector<Value>::Allocator(_arena)),
+      m_sum(typename ImageVector<Value>::Allocator(_arena)),
+      m_lastRow(s_rowNone)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_verticalPlan.build(_heightIn, _heightOut)
+          && m_horizontalPlan.build(_widthIn, _widthOut);
+    }
+
+    template <typename _PlaneIn, typename _UByteCVOut>
+    bool operator()(const _PlaneIn& _planeIn, const ImagePlane<_UByteCVOut>& _planeOut)
+    {
+      if (_planeOut.width() == 0 || _planeOut.height() == 0)
+        return true;
+      if (!prepare(_planeIn.width(), _planeIn.height(), _planeOut.width(), _planeOut.height()))
+        return false;
+
+      const size_t widthOut = _planeOut.width();
+      m_first.resize(widthOut);
+      m_last.resize(widthOut);
+      m_sum.resize(widthOut);
+      m_lastRow = s_rowNone;
+
+      for (size_t rowIdxOut = 0; rowIdxOut < _planeOut.height(); ++rowIdxOut)
+      {
+        const size_t rowFirst = m_verticalPlan.first(rowIdxOut);
+        const size_t rowCount = m_verticalPlan.count(rowIdxOut);
+        const size_t rowLast  = rowFirst + rowCount - 1;
+
+        if (m_lastRow != rowFirst)
+          integrateRowHorizontal(_planeIn, rowFirst, &m_last.front(), false);
+        m_lastRow = rowFirst;
+
+        if (rowCount > 1)
+        {
+          m_first.swap(m_last);
+          for (size_t rowIdxIn = rowFirst+1; rowIdxIn < rowLast; ++rowIdxIn)
+            integrateRowHorizontal(_planeIn, rowIdxIn, &m_sum.front(), rowIdxIn != rowFirst+1);
+          integrateRowHorizontal(_planeIn, rowLast, &m_last.front(), false);
+          m_lastRow = rowLast;
+        }
+
+        combineRowVertical(rowCount > 1 ? &m_first.front() : &m_last.front(), &m_last.front(), &m_sum.front(),
+                           _planeOut, rowIdxOut);
+      }
+
+      return true;
+    }
+
+  private:
+    template <typename _PlaneIn>
+    void integrateRowHorizontal(const _PlaneIn& _planeIn, size_t _rowIdxIn,
+                                Value* TRIK_LIBIMAGE_RESTRICT _rowOut, bool _accumulate) const
+    {
+      typename _PlaneIn::UByteCV* TRIK_LIBIMAGE_RESTRICT rowIn = _planeIn.row(_rowIdxIn);
+
+      for (size_t colIdxOut = 0; colIdxOut < m_horizontalPlan.sizeOut(); ++colIdxOut)
+      {
+        const size_t first = m_horizontalPlan.first(colIdxOut);
+        const size_t count = m_horizontalPlan.count(colIdxOut);
+
+        Value result = _Component::multiply(_Component::load(_planeIn.sample(rowIn, first)), m_horizontalPlan.weightFirst(colIdxOut));
+        if (count > 1)
+          result += _Component::multiply(_Component::load(_planeIn.sample(rowIn, first+count-1)), m_horizontalPlan.weightLast(colIdxOut));
+        if (count > 2)
+        {
+          Value inner = Value();
+          for (size_t colIdxIn = first+1; colIdxIn < first+count-1; ++colIdxIn)
+            inner += _Component::load(_planeIn.sample(rowIn, colIdxIn));
+          result += _Component::multiply(inner, m_horizontalPlan.weightInner(colIdxOut));
+        }
+
+        if (_accumulate)
+          _rowOut[colIdxOut] += result;
+        else
+          _rowOut[colIdxOut] = result;
+      }
+    }
+
+    template <typename _UByteCVOut>
+    void combineRowVertical(const Value* TRIK_LIBIMAGE_RESTRICT _first, const Value* TRIK_LIBIMAGE_RESTRICT _last,
+                            const Value* TRIK_LIBIMAGE_RESTRICT _sum,
+                            const ImagePlane<_UByteCVOut>& _planeOut, size_t _rowIdxOut) const
+    {
+      const size_t step = _planeOut.step();
+      _UByteCVOut* TRIK_LIBIMAGE_RESTRICT rowOut = _planeOut.row(_rowIdxOut);
+
+      const size_t rowCount = m_verticalPlan.count(_rowIdxOut);
+      const typename Plan::Weight& weightFirst = m_verticalPlan.weightFirst(_rowIdxOut);
+      const typename Plan::Weight& weightInner = m_verticalPlan.weightInner(_rowIdxOut);
+      const typename Plan::Weight& weightLast  = m_verticalPlan.weightLast(_rowIdxOut);
+
+      for (size_t colIdxOut = 0; colIdxOut < _planeOut.width(); ++colIdxOut)
+      {
+        Value result = _Component::multiply(_first[colIdxOut], weightFirst);
+        if (rowCount > 1)
+          result += _Component::multiply(_last[colIdxOut], weightLast);
+        if (rowCount > 2)
+          result += _Component::multiply(_sum[colIdxOut], weightInner);
+
+        rowOut[colIdxOut * step] = _Component::store(result, 0xff);
+      }
+    }
+
+    Plan               m_verticalPlan;
+    Plan               m_horizontalPlan;
+    typename ImageVector<Value>::Type m_first;
+    typename ImageVector<Value>::Type m_last;
+    typename ImageVector<Value>::Type m_sum;
+    size_t             m_lastRow;
+};
+
+
+
+
+/*
+ * Nearest resample of one plane, plain sample copy; same size is exact copy of plane
+ */
+class AlgoResamplePlaneNearest
+{
+  public:
+    explicit AlgoResamplePlaneNearest(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_verticalPlan.build(_heightIn, _heightOut)
+          && m_horizontalPlan.build(_widthIn, _widthOut);
+    }
+
+    template <typename _PlaneIn, typename _UByteCVOut>
+    bool operator()(const _PlaneIn& _planeIn, const ImagePlane<_UByteCVOut>& _planeOut)
+    {
+      if (_planeOut.width() == 0 || _planeOut.height() == 0)
+        return true;
+      if (!prepare(_planeIn.width(), _planeIn.height(), _planeOut.width(), _planeOut.height()))
+        return false;
+
+      const size_t stepOut = _planeOut.step();
+      for (size_t rowIdxOut = 0; rowIdxOut < _planeOut.height(); ++rowIdxOut)
+      {
+        typename _PlaneIn::UByteCV* TRIK_LIBIMAGE_RESTRICT rowIn  = _planeIn.row(m_verticalPlan.index(rowIdxOut));
+        _UByteCVOut*                TRIK_LIBIMAGE_RESTRICT rowOut = _planeOut.row(rowIdxOut);
+        for (size_t colIdxOut = 0; colIdxOut < _planeOut.width(); ++colIdxOut)
+          rowOut[colIdxOut * stepOut] = _planeIn.sample(rowIn, m_horizontalPlan.index(colIdxOut));
+      }
+
+      return true;
+    }
+
+  private:
+    AlgoResampleNearestPlan1Dim m_verticalPlan;
+    AlgoResampleNearestPlan1Dim m_horizontalPlan;
+};
+
+
+
+
+/*
+ * Planar image resample: Y, U and V planes are resampled independently by single channel plane algorithm,
+ * so any planar layout converts to any other; both chroma planes go through one plane algorithm of chroma geometry
+ */
+template <typename _PlaneAlgorithm, typename _ImageIn, typename _ImageOut>
+class AlgoResamplePlanar
+{
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    // plans and scratch rows of both plane algorithms are allocated from given arena, heap by default
+    explicit AlgoResamplePlanar(ImageMemoryArena* _arena = NULL)
+     :m_luma(_arena),
+      m_chroma(_arena)
+    {
+    }
+
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      return m_luma.prepare(_widthIn, _heightIn, _widthOut, _heightOut)
+          && m_chroma.prepare(BaseImagePlanar::chromaSize(_widthIn),  BaseImagePlanar::chromaSize(_heightIn),
+                              BaseImagePlanar::chromaSize(_widthOut), BaseImagePlanar::chromaSize(_heightOut));
+    }
+
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut& _imageOut)
+    {
+      if (!_imageIn.isValid() || !_imageOut.isValid())
+        return false;
+
+      return m_luma(_imageIn.plane(BaseImagePlanar::PlaneY), _imageOut.plane(BaseImagePlanar::PlaneY))
+          && m_chroma(_imageIn.plane(BaseImagePlanar::PlaneU), _imageOut.plane(BaseImagePlanar::PlaneU))
+          && m_chroma(_imageIn.plane(BaseImagePlanar::PlaneV), _imageOut.plane(BaseImagePlanar::PlaneV));
+    }
+
+  private:
+    _PlaneAlgorithm m_luma;
+    _PlaneAlgorithm m_chroma;
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat>,
+                                                                     internal::AlgoInterpolationCubic<internal::ImagePixelComponentFloat> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicFixed, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed>,
+                                                                     internal::AlgoInterpolationCubic<internal::ImagePixelComponentFixed> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubicCompact, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact>,
+                                                                     internal::AlgoInterpolationCubic<internal::ImagePixelComponentCompact> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinear, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat>,
+                                                                     internal::AlgoInterpolationLinear<internal::ImagePixelComponentFloat> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearFixed, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed>,
+                                                                     internal::AlgoInterpolationLinear<internal::ImagePixelComponentFixed> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinearCompact, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact>,
+                                                                     internal::AlgoInterpolationLinear<internal::ImagePixelComponentCompact> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos2, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat>,
+                                                                     internal::AlgoInterpolationLanczos<2, internal::ImagePixelComponentFloat> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleLanczos3, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneVH<internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat>,
+                                                                     internal::AlgoInterpolationLanczos<3, internal::ImagePixelComponentFloat> >,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleArea, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneArea<internal::ImagePixelComponentFloat>,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResampleNearest, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneNearest,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+// nearest of the same size copies every sample, also moves chroma between planar layouts
+template <BaseImagePlanar::PlanarType _PTIn,  typename _UByteCVIn,
+          BaseImagePlanar::PlanarType _PTOut, typename _UByteCVOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoConvert, ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePlanar<internal::AlgoResamplePlaneNearest,
+                                       ImagePlanar<_PTIn, _UByteCVIn>, ImagePlanar<_PTOut, _UByteCVOut> >
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePlanar(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_PLANAR_HPP_
@@ -0,0 +1,183 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ALGO_PYRAMID_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ALGO_PYRAMID_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+
+#include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
+#include <libimage/image_algo.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * Pyramid of 1/2, 1/4, ... 1/2^N copies in one pass over input.
+ * Every level is 2x2 box average of previous one, odd last row and column are dropped.
+ * Input rows are consumed in order; as soon as a level row is complete it is written out and pushed,
+ * still unpacked, to next level, so no level is ever read back from its output image.
+ */
+template <typename _Component, typename _ImageIn, typename _ImageOut>
+class AlgoResamplePyramid
+{
+  private:
+    typedef ImagePixel<_ImageIn::PT,  _Component> PixelIn;
+    typedef ImagePixel<_ImageOut::PT, _Component> PixelOut;
+
+    typedef ImagePixelConvertion<PixelIn, PixelOut> PixelIn2OutConvertion;
+
+    typedef typename ImageVector<PixelIn>::Type LevelRow;
+
+  public:
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    // level rows are allocated from given arena, heap by default
+    explicit AlgoResamplePyramid(ImageMemoryArena* _arena = NULL)
+     :m_levelSums(typename ImageVector<LevelRow>::Allocator(_arena)),
+      m_levelRows(typename ImageVector<LevelRow>::Allocator(_arena))
+    {
+    }
+
+    /*
+     * _levels[idx] must be exactly half of previous level (of input for idx 0), rounded down
+     */
+    bool operator()(const _ImageIn& _imageIn,
+                    _ImageOut* _levels,
+                    size_t _levelsCount)
+    {
+      if (   (_levels == NULL && _levelsCount > 0)
+          || !_imageIn.isValid())
+        return false;
+
+      size_t width  = _imageIn.width();
+      size_t height = _imageIn.height();
+      for (size_t level = 0; level < _levelsCount; ++level)
+      {
+        width  /= 2;
+        height /= 2;
+        if (   _levels[level].width() != width
+            || _levels[level].height() != height
+            || !_levels[level].isValid())
+          return false;
+      }
+
+      // new level rows take arena of outer vectors
+      const LevelRow levelRow(typename ImageVector<PixelIn>::Allocator(m_levelSums.get_allocator()));
+      m_levelSums.resize(_levelsCount, levelRow);
+      m_levelRows.resize(_levelsCount, levelRow);
+      for (size_t level = 0; level < _levelsCount; ++level)
+      {
+        m_levelSums[level].resize(_levels[level].width());
+        m_levelRows[level].resize(_levels[level].width());
+      }
+
+      if (_levelsCount == 0)
+        return true;
+
+      for (size_t rowIdxIn = 0; rowIdxIn < _imageIn.height(); ++rowIdxIn)
+      {
+        typename _ImageIn::UncheckedRowType rowIn;
+        if (!_imageIn.getRow(rowIn, rowIdxIn))
+          return false;
+
+        if (!pushRow(rowIn, rowIdxIn, _levels, _levelsCount, 0))
+          return false;
+      }
+
+      return true;
+    }
+
+  private:
+    // _rowIdx is index of row in previous level (or input) which is being pushed into _level
+    template <typename _RowIn>
+    bool pushRow(_RowIn& _rowIn, size_t _rowIdx,
+                 _ImageOut* _levels, size_t _levelsCount, size_t _level)
+    {
+      _ImageOut& imageOut = _levels[_level];
+      if (_rowIdx >= imageOut.height()*2 || imageOut.width() == 0)
+        return true;
+
+      PixelIn* const sums = &m_levelSums[_level].front();
+      bool isOk = true;
+
+      if (_rowIdx % 2 == 0)
+      {
+        for (size_t colIdx = 0; colIdx < imageOut.width(); ++colIdx)
+        {
+          PixelIn pixel;
+          isOk &= _rowIn.readPixel(sums[colIdx]);
+          isOk &= _rowIn.readPixel(pixel);
+          sums[colIdx] += pixel;
+        }
+
+        return isOk;
+      }
+
+      typename _ImageOut::UncheckedRowType rowOut;
+      if (!imageOut.getRow(rowOut, _rowIdx/2))
+        return false;
+
+      const PixelIn2OutConvertion convertion;
+      const typename _Component::Weight weight = _Component::weight(0.25f);
+      PixelIn* const row = &m_levelRows[_level].front();
+
+      for (size_t colIdx = 0; colIdx < imageOut.width(); ++colIdx)
+      {
+        PixelIn pixel;
+        PixelIn sum = sums[colIdx];
+        isOk &= _rowIn.readPixel(pixel);
+        sum += pixel;
+        isOk &= _rowIn.readPixel(pixel);
+        sum += pixel;
+        row[colIdx] = sum * weight;
+
+        PixelOut pixelOut;
+        isOk &= convertion(row[colIdx], pixelOut);
+        isOk &= rowOut.writePixel(pixelOut);
+      }
+
+      if (!isOk)
+        return false;
+
+      if (_level+1 == _levelsCount)
+        return true;
+
+      ImageRowUnpacked<PixelIn> rowNext(row, imageOut.width());
+      return pushRow(rowNext, _rowIdx/2, _levels, _levelsCount, _level+1);
+    }
+
+    typename ImageVector<LevelRow>::Type m_levelSums;
+    typename ImageVector<LevelRow>::Type m_levelRows;
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _ImageIn, typename _ImageOut>
+class ImageAlgorithm<BaseImageAlgorithm::AlgoResamplePyramid, _ImageIn, _ImageOut>
+ : public BaseImageAlgorithm,
+   public internal::AlgoResamplePyramid<internal::ImagePixelComponentFloat, _ImageIn, _ImageOut>
+{
+  public:
+    explicit ImageAlgorithm(ImageMemoryArena* _arena = NULL)
+     :ImageAlgorithm::AlgoResamplePyramid(_arena)
+    {
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ALGO_PYRAMID_HPP_
@@ -6,10 +6,10 @@
 #endif
 
 
-#include <map>
-#include <utility>
+#include <algorithm>
 
 #include <libimage/stdcpp.hpp>
+#include <libimage/image_memory.hpp>
 #include <libimage/image_algo.hpp>
 
 
@@ -18,12 +18,14 @@
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
 
 
-template <size_t _windowBefore, size_t _windowAfter>
+template <size_t _windowBefore, size_t _windowAfter, typename _Component>
 class BaseAlgoInterpolation1Dim
 {
   public:
     static const size_t s_isAlgorithmInterpolation1Dim = true;
 
+    typedef _Component Component;
+
   protected:
     static const size_t s_windowBefore = _windowBefore;
     static const size_t s_windowAfter  = _windowAfter;
@@ -32,14 +34,271 @@ class BaseAlgoInterpolation1Dim
     template <typename _VertialInterpolation, typename _HorizontalInterpolation,
               typename _ImageIn, typename _ImageOut>
     friend class AlgoResampleVH;
+
+    template <typename _VertialInterpolation, typename _HorizontalInterpolation>
+    friend class AlgoResamplePlaneVH;
+};
+
+
+
+
+/*
+ * Resample plan for single dimension: source index and interpolation weights for every output index.
+ * Built once for given input/output sizes and reused until sizes change.
+ */
+template <typename _Interpolation>
+class AlgoResamplePlan1Dim
+{
+  public:
+    explicit AlgoResamplePlan1Dim(ImageMemoryArena* _arena = NULL)
+     :m_sizeIn(0),
+      m_sizeOut(0),
+      m_entries(typename ImageVector<Entry>::Allocator(_arena))
+    {
+    }
+
+    bool build(size_t _sizeIn, size_t _sizeOut)
+    {
+      if (   m_sizeIn  == _sizeIn
+          && m_sizeOut == _sizeOut
+          && m_entries.size() == _sizeOut)
+        return true;
+
+      m_sizeIn  = 0;
+      m_sizeOut = 0;
+      m_entries.clear();
+      m_entries.reserve(_sizeOut);
+
+      const float in2outFactor = _sizeOut == 0 ? 0.0f : static_cast<float>(_sizeIn) / static_cast<float>(_sizeOut);
+      for (size_t idxOut = 0; idxOut < _sizeOut; ++idxOut)
+      {
+        size_t idxIn;
+        float idxInFract;
+        if (!convertCoord(idxOut, in2outFactor, idxIn, idxInFract))
+          return false;
+
+        m_entries.push_back(Entry(idxIn, _Interpolation(idxInFract)));
+      }
+
+      m_sizeIn  = _sizeIn;
+      m_sizeOut = _sizeOut;
+      return true;
+    }
+
+    const size_t& sizeIn() const
+    {
+      return m_sizeIn;
+    }
+
+    const size_t& sizeOut() const
+    {
+      return m_sizeOut;
+    }
+
+    const size_t& index(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_index;
+    }
+
+    const _Interpolation& interpolation(size_t _idxOut) const
+    {
+      return m_entries[_idxOut].m_interpolation;
+    }
+
+  private:
+    struct Entry
+    {
+      Entry(size_t _index, const _Interpolation& _interpolation)
+       :m_index(_index),
+        m_interpolation(_interpolation)
+      {
+      }
+
+      size_t         m_index;
+      _Interpolation m_interpolation;
+    };
+
+    size_t             m_sizeIn;
+    size_t             m_sizeOut;
+    typename ImageVector<Entry>::Type m_entries;
+
+    static bool convertCoord(size_t _idx1, float _factor, size_t& _idx2, float& _fract)
+    {
+      const float idx2f = _idx1 * _factor;
+      _idx2 = /*trunc*/idx2f;
+      _fract = idx2f - _idx2;
+      return true;
+    }
+};
+
+
+
+
+/*
+ * Pixel set view over one column of several rows, lets interpolation run directly on cached rows
+ */
+template <typename _Pixel, size_t _pixelsCount>
+class ImagePixelColumnView
+{
+  public:
+    typedef _Pixel Pixel;
+
+    ImagePixelColumnView(const Pixel* const* _rows)
+     :m_rows(_rows),
+      m_column(0)
+    {
+    }
+
+    void column(size_t _column)
+    {
+      m_column = _column;
+    }
+
+    size_t pixelsCount() const
+    {
+      return _pixelsCount;
+    }
+
+    const Pixel& operator[](size_t _index) const
+    {
+      return m_rows[_index][m_column];
+    }
+
+  private:
+    const Pixel* const* m_rows;
+    size_t              m_column;
+};
+
+
+/*
+ * Pixel set view over consecutive pixels of one row, and single pixel output of interpolation
+ */
+template <typename _Pixel, size_t _pixelsCount>
+class ImagePixelRowView
+{
+  public:
+    typedef _Pixel Pixel;
+
+    ImagePixelRowView(const Pixel* _row)
+     :m_row(_row),
+      m_first(0)
+    {
+    }
+
+    void first(size_t _first)
+    {
+      m_first = _first;
+    }
+
+    size_t pixelsCount() const
+    {
+      return _pixelsCount;
+    }
+
+    const Pixel& operator[](size_t _index) const
+    {
+      return m_row[m_first + _index];
+    }
+
+  private:
+    const Pixel* m_row;
+    size_t       m_first;
+};
+
+template <typename _Pixel>
+class ImagePixelResultView
+{
+  public:
+    typedef _Pixel Pixel;
+
+    ImagePixelResultView(Pixel& _pixel)
+     :m_pixel(_pixel)
+    {
+    }
+
+    Pixel& insertNewPixel()
+    {
+      return m_pixel;
+    }
+
+  private:
+    Pixel& m_pixel;
 };
 
 
 
 
 /*
- * First interpolate one column from row set using single dimension vertical interpolation algorithm
- * Then interpolate one row of results using horizontal interpolation algorithm to get single output point
+ * Few components of one plane with pixel arithmetic, so that interpolation can filter planes separately
+ */
+template <typename _Component, size_t _componentsCount>
+class ImagePixelComponents
+{
+  public:
+    typedef typename _Component::Value  Value;
+    typedef typename _Component::Weight Weight;
+
+    ImagePixelComponents()
+     :m_values()
+    {
+    }
+
+    Value& operator[](size_t _index)
+    {
+      return m_values[_index];
+    }
+
+    const Value& operator[](size_t _index) const
+    {
+      return m_values[_index];
+    }
+
+    ImagePixelComponents operator*(const Weight& _w) const
+    {
+      ImagePixelComponents p;
+      for (size_t idx = 0; idx < _componentsCount; ++idx)
+        p.m_values[idx] = _Component::multiply(m_values[idx], _w);
+      return p;
+    }
+
+    ImagePixelComponents& operator+=(const ImagePixelComponents& _p)
+    {
+      for (size_t idx = 0; idx < _componentsCount; ++idx)
+        m_values[idx] += _p.m_values[idx];
+      return *this;
+    }
+
+    ImagePixelComponents& accumulate(const ImagePixelComponents& _p, const Weight& _w)
+    {
+      for (size_t idx = 0; idx < _componentsCount; ++idx)
+        m_values[idx] += _Component::product(_p.m_values[idx], _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      for (size_t idx = 0; idx < _componentsCount; ++idx)
+        m_values[idx] = _Component::reduce(m_values[idx]);
+    }
+
+  private:
+    Value m_values[_componentsCount];
+};
+
+
+
+
+/*
+ * Separable resample, two schedules are available:
+ * - vertical first: interpolate one column from row set using single dimension vertical interpolation algorithm,
+ *   then interpolate one row of results using horizontal interpolation algorithm to get single output point;
+ * - horizontal first: each required input row is horizontally interpolated exactly once into a ring of
+ *   output-width rows, then every output row is a vertical combine of rows in the ring.
+ * Same size and exact 2:1, 3:1 and 4:1 reductions have zero phase everywhere, where interpolating kernels
+ * are identity, so they are converted or decimated directly: same output, without touching skipped pixels.
+ * YUV422 input is always resampled horizontal first on separate planes: luma at full width, chroma of pixel
+ * pairs at half width of both input and output, so chroma is filtered at its native resolution with half
+ * the arithmetic; output pixel pair shares its chroma sample.
  * Then output point is converted from input color space to output
  */
 template <typename _VerticalInterpolation, typename _HorizontalInterpolation,
@@ -48,28 +307,474 @@ class AlgoResampleVH : private assert_inst<(   _VerticalInterpolation::s_isAlgor
                                             || _HorizontalInterpolation::s_isAlgorithmInterpolation1Dim)> // algorithm kind sanity check
 {
   private:
-    typedef ImageRowSet<_ImageIn::PT,  typename _ImageIn::UByteCV,  _VerticalInterpolation::s_windowSize> RowSetIn;
-    typedef ImageRowSet<_ImageOut::PT, typename _ImageOut::UByteCV, 1>                                    RowSetOut;
+    typedef ImageRowSet<_ImageIn::PT,  typename _ImageIn::UByteCV,  _VerticalInterpolation::s_windowSize, false> RowSetIn;
+    typedef ImageRowSet<_ImageOut::PT, typename _ImageOut::UByteCV, 1,                                    false> RowSetOut;
 
-    typedef ImagePixelSet<_ImageIn::PT,  _VerticalInterpolation::s_windowSize>   PixelSetInVertical;
-    typedef ImagePixelSet<_ImageIn::PT,  _HorizontalInterpolation::s_windowSize> PixelSetInHorizontal;
-    typedef ImagePixelSet<_ImageIn::PT,  1>                                      PixelSetInResult;
-    typedef ImagePixelSet<_ImageOut::PT, 1>                                      PixelSetOutResult;
+    typedef typename _VerticalInterpolation::Component Component;
+
+    typedef ImagePixelSet<_ImageIn::PT,  _VerticalInterpolation::s_windowSize,   Component> PixelSetInVertical;
+    typedef ImagePixelSet<_ImageIn::PT,  _HorizontalInterpolation::s_windowSize, Component> PixelSetInHorizontal;
+    typedef ImagePixelSet<_ImageIn::PT,  1,                                      Component> PixelSetInResult;
+    typedef ImagePixelSet<_ImageOut::PT, 1,                                      Component> PixelSetOutResult;
 
     typedef ImagePixelSetConvertion<PixelSetInResult, PixelSetOutResult> PixelSetIn2OutConvertion;
 
-    typedef std::map<float, _VerticalInterpolation>   VerticalInterpolationCache;
-    typedef std::map<float, _HorizontalInterpolation> HorizontalInterpolationCache;
+    typedef typename PixelSetInResult::Pixel                                                 PixelIn;
+    typedef ImagePixelColumnView<PixelIn, _VerticalInterpolation::s_windowSize>              PixelColumnIn;
+
+    typedef AlgoResamplePlan1Dim<_VerticalInterpolation>   VerticalPlan;
+    typedef AlgoResamplePlan1Dim<_HorizontalInterpolation> HorizontalPlan;
+
+    typedef ImagePixelComponents<Component, 1> LumaIn;
+    typedef ImagePixelComponents<Component, 2> ChromaIn;
+
+    static const size_t s_ringRowNone = static_cast<size_t>(-1);
+    static const bool   s_chromaPlanes = _ImageIn::PT == BaseImagePixel::PixelYUV422;
+
+    /*
+     * Horizontally interpolated rows of vertical window, as whole pixels or as luma and chroma planes;
+     * planes also keep one decoded input row, padded by horizontal window on both sides
+     */
+    class Ring
+    {
+      public:
+        explicit Ring(ImageMemoryArena* _arena)
+         :m_pixels(typename ImageVector<PixelIn>::Allocator(_arena)),
+          m_luma(typename ImageVector<LumaIn>::Allocator(_arena)),
+          m_chroma(typename ImageVector<ChromaIn>::Allocator(_arena)),
+          m_lumaIn(typename ImageVector<LumaIn>::Allocator(_arena)),
+          m_chromaIn(typename ImageVector<ChromaIn>::Allocator(_arena))
+        {
+        }
+
+      private:
+        typename ImageVector<PixelIn>::Type  m_pixels;
+        typename ImageVector<LumaIn>::Type   m_luma;
+        typename ImageVector<ChromaIn>::Type m_chroma;
+        typename ImageVector<LumaIn>::Type   m_lumaIn;
+        typename ImageVector<ChromaIn>::Type m_chromaIn;
+
+        friend class AlgoResampleVH;
+    };
 
   public:
-    AlgoResampleVH()
+    typedef _ImageIn  ImageIn;
+    typedef _ImageOut ImageOut;
+
+    enum Schedule
+    {
+      ScheduleAuto,
+      ScheduleVerticalFirst,
+      ScheduleHorizontalFirst
+    };
+
+    /*
+     * Scratch state of one band of output rows; bands with distinct states can be resampled concurrently
+     */
+    class BandState
+    {
+      public:
+        explicit BandState(ImageMemoryArena* _arena = NULL)
+         :m_ring(_arena)
+        {
+        }
+
+      private:
+        Ring m_ring;
+
+        friend class AlgoResampleVH;
+    };
+
+    typedef PixelIn UnpackedPixelIn;
+
+    /*
+     * State of one output fed row by row, see streamRow() and streamRows(); holds ring of window size rows only
+     */
+    class StreamState
+    {
+      public:
+        explicit StreamState(ImageMemoryArena* _arena = NULL)
+         :m_ring(_arena),
+          m_rowIdxInNext(0),
+          m_rowIdxOutNext(0)
+        {
+        }
+
+      private:
+        Ring   m_ring;
+        size_t m_ringRows[_VerticalInterpolation::s_windowSize];
+        size_t m_rowIdxInNext;
+        size_t m_rowIdxOutNext;
+
+        friend class AlgoResampleVH;
+    };
+
+    // plans and scratch rows are allocated from given arena, heap by default
+    explicit AlgoResampleVH(ImageMemoryArena* _arena = NULL)
+     :m_verticalPlan(_arena),
+      m_horizontalPlan(_arena),
+      m_chromaPlan(_arena),
+      m_schedule(ScheduleAuto),
+      m_scheduleValid(false),
+      m_horizontalFirst(false),
+      m_decimationColumns(0),
+      m_decimationRows(0),
+      m_bandState(_arena)
     {
-      // TODO build interpolation algorithms cache now?
     }
 
+    void schedule(Schedule _schedule)
+    {
+      m_schedule = _schedule;
+      m_scheduleValid = false;
+    }
+
+    /*
+     * Build resample plan for given geometry in advance; operator() rebuilds it only when geometry changes
+     */
+    bool prepare(size_t _widthIn,  size_t _heightIn,
+                 size_t _widthOut, size_t _heightOut)
+    {
+      if (   m_scheduleValid
+          && m_verticalPlan.sizeIn()    == _heightIn
+          && m_verticalPlan.sizeOut()   == _heightOut
+          && m_horizontalPlan.sizeIn()  == _widthIn
+          && m_horizontalPlan.sizeOut() == _widthOut)
+        return true;
+
+      m_scheduleValid = false;
+      if (   !m_verticalPlan.build(_heightIn, _heightOut)
+          || !m_horizontalPlan.build(_widthIn, _widthOut)
+          || (s_chromaPlanes && !m_chromaPlan.build(chromaWidth(_widthIn), chromaWidth(_widthOut))))
+        return false;
+
+      m_decimationColumns = decimationFactor(m_horizontalPlan);
+      m_decimationRows    = decimationFactor(m_verticalPlan);
+      if (m_decimationRows == 0 || (s_chromaPlanes && decimationFactor(m_chromaPlan) == 0))
+        m_decimationColumns = 0;
+
+      switch (m_schedule)
+      {
+        case ScheduleVerticalFirst:   m_horizontalFirst = false; break;
+        case ScheduleHorizontalFirst: m_horizontalFirst = true;  break;
+        default:                      m_horizontalFirst = isHorizontalFirstCheaper(); break;
+      }
+      m_horizontalFirst |= s_chromaPlanes;
+
+      m_scheduleValid = true;
+      return true;
+    }
+
+    // path of prepared geometry: 1 to 4 for same size copy or exact reduction, 0 when interpolated
+    size_t decimation() const
+    {
+      return m_scheduleValid ? m_decimationColumns : 0;
+    }
+
+    // order of interpolated path of prepared geometry
+    bool horizontalFirst() const
+    {
+      return m_scheduleValid && m_horizontalFirst;
+    }
 
     bool operator()(const _ImageIn& _imageIn,
-                    _ImageOut& _imageOut) const
+                    _ImageOut& _imageOut)
+    {
+      if (!prepare(_imageIn.width(), _imageIn.height(), _imageOut.width(), _imageOut.height()))
+        return false;
+
+      return resampleBand(_imageIn, _imageOut, 0, _imageOut.height(), m_bandState);
+    }
+
+    /*
+     * Resample output rows [_rowIdxOutBegin, _rowIdxOutEnd) only; plan must be already prepared for the geometry.
+     * Does not modify algorithm itself, so distinct bands may run in parallel, each with its own state.
+     */
+    bool resampleBand(const _ImageIn& _imageIn,
+                      _ImageOut& _imageOut,
+                      size_t _rowIdxOutBegin,
+                      size_t _rowIdxOutEnd,
+                      BandState& _bandState) const
+    {
+      if (   !m_scheduleValid
+          || m_verticalPlan.sizeIn()    != _imageIn.height()
+          || m_verticalPlan.sizeOut()   != _imageOut.height()
+          || m_horizontalPlan.sizeIn()  != _imageIn.width()
+          || m_horizontalPlan.sizeOut() != _imageOut.width()
+          || _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > _imageOut.height()
+          || !_imageIn.isValid()
+          || !_imageOut.isValid())
+        return false;
+
+      switch (m_decimationColumns)
+      {
+        case 1: return resampleDecimated<1>(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd);
+        case 2: return resampleDecimated<2>(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd);
+        case 3: return resampleDecimated<3>(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd);
+        case 4: return resampleDecimated<4>(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd);
+        default: break;
+      }
+
+      if (m_horizontalFirst)
+        return resampleHorizontalFirst(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd, _bandState.m_ring);
+      else
+        return resampleVerticalFirst(_imageIn, _imageOut, _rowIdxOutBegin, _rowIdxOutEnd);
+    }
+
+    /*
+     * Input rows [_rowIdxInBegin, _rowIdxInEnd) read by output rows [_rowIdxOutBegin, _rowIdxOutEnd) in any schedule,
+     * including whole interpolation window; plan must be prepared
+     */
+    bool bandRowsIn(size_t _rowIdxOutBegin, size_t _rowIdxOutEnd,
+                    size_t& _rowIdxInBegin, size_t& _rowIdxInEnd) const
+    {
+      if (   !m_scheduleValid
+          || _rowIdxOutBegin > _rowIdxOutEnd
+          || _rowIdxOutEnd > m_verticalPlan.sizeOut())
+        return false;
+
+      if (_rowIdxOutBegin == _rowIdxOutEnd)
+      {
+        _rowIdxInBegin = _rowIdxInEnd = 0;
+        return true;
+      }
+
+      _rowIdxInBegin = windowRow(_rowIdxOutBegin, 0);
+      _rowIdxInEnd   = windowRow(_rowIdxOutEnd-1, _VerticalInterpolation::s_windowSize-1) + 1;
+      return true;
+    }
+
+    /*
+     * Row-driven alternative to resampleBand(): input rows are passed in increasing order, either unpacked by caller,
+     * so one unpacked row may feed several outputs, or as slices of packed rows as soon as they are captured.
+     * Every row is horizontally interpolated into the ring once, output row is written as soon as last row
+     * of its window has arrived. Output is identical to operator() with horizontal first schedule.
+     */
+    bool streamBegin(const _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (   !m_scheduleValid
+          || m_verticalPlan.sizeOut()   != _imageOut.height()
+          || m_horizontalPlan.sizeOut() != _imageOut.width()
+          || !_imageOut.isValid())
+        return false;
+
+      resizeRing(_streamState.m_ring, _imageOut.width());
+      for (size_t slot = 0; slot < _VerticalInterpolation::s_windowSize; ++slot)
+        _streamState.m_ringRows[slot] = s_ringRowNone;
+      _streamState.m_rowIdxInNext  = 0;
+      _streamState.m_rowIdxOutNext = 0;
+
+      return true;
+    }
+
+    // rows outside of every remaining window are not interpolated at all, caller may skip unpacking them
+    bool streamRowNeeded(size_t _rowIdxIn, const StreamState& _streamState) const
+    {
+      return _streamState.m_rowIdxOutNext < m_verticalPlan.sizeOut()
+          && windowRow(_streamState.m_rowIdxOutNext, 0) <= _rowIdxIn;
+    }
+
+    bool streamRow(const UnpackedPixelIn* _rowIn, size_t _rowWidthIn, size_t _rowIdxIn,
+                   _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      ImageRowUnpacked<PixelIn> rowIn(_rowIn, _rowWidthIn);
+      return streamRowImpl(rowIn, _rowIdxIn, _imageOut, _streamState);
+    }
+
+    /*
+     * Slice holds input rows [_rowIdxInFirst, _rowIdxInFirst + _slice.height()) of full frame, e.g. one DMA block
+     */
+    bool streamRows(const _ImageIn& _slice, size_t _rowIdxInFirst,
+                    _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (   _slice.width() != m_horizontalPlan.sizeIn()
+          || !_slice.isValid())
+        return false;
+
+      for (size_t rowIdx = 0; rowIdx < _slice.height(); ++rowIdx)
+      {
+        if (!streamRowNeeded(_rowIdxInFirst + rowIdx, _streamState))
+          continue;
+
+        typename _ImageIn::UncheckedRowType rowIn;
+        if (   !_slice.getRow(rowIn, rowIdx)
+            || !streamRowImpl(rowIn, _rowIdxInFirst + rowIdx, _imageOut, _streamState))
+          return false;
+      }
+
+      return true;
+    }
+
+    bool streamEnd(const _ImageOut& _imageOut, const StreamState& _streamState) const
+    {
+      return _streamState.m_rowIdxOutNext == _imageOut.height();
+    }
+
+  private:
+    template <typename _RowIn>
+    bool streamRowImpl(_RowIn& _rowIn, size_t _rowIdxIn,
+                       _ImageOut& _imageOut, StreamState& _streamState) const
+    {
+      if (   _rowIdxIn < _streamState.m_rowIdxInNext
+          || _rowIdxIn >= m_verticalPlan.sizeIn())
+        return false;
+
+      _streamState.m_rowIdxInNext = _rowIdxIn + 1;
+      if (!streamRowNeeded(_rowIdxIn, _streamState))
+        return true;
+
+      const size_t ringSize = _VerticalInterpolation::s_windowSize;
+      const size_t widthOut = _imageOut.width();
+      const size_t slot     = _rowIdxIn % ringSize;
+
+      _streamState.m_ringRows[slot] = s_ringRowNone;
+      if (!fillRingRow(_rowIn, _streamState.m_ring, slot, widthOut))
+        return false;
+      _streamState.m_ringRows[slot] = _rowIdxIn;
+
+      size_t windowSlots[ringSize];
+      size_t& rowIdxOut = _streamState.m_rowIdxOutNext;
+      for (/*rowIdxOut*/; rowIdxOut < m_verticalPlan.sizeOut() && windowRow(rowIdxOut, ringSize-1) <= _rowIdxIn; ++rowIdxOut)
+      {
+        for (size_t idx = 0; idx < ringSize; ++idx)
+        {
+          const size_t rowIdxWindow = windowRow(rowIdxOut, idx);
+          if (_streamState.m_ringRows[rowIdxWindow % ringSize] != rowIdxWindow)
+            return false;
+
+          windowSlots[idx] = rowIdxWindow % ringSize;
+        }
+
+        if (!combineRing(_streamState.m_ring, windowSlots, _imageOut, rowIdxOut))
+          return false;
+      }
+
+      return true;
+    }
+
+    // input row of vertical window position _idx for output row, clamped to image
+    size_t windowRow(size_t _rowIdxOut, size_t _idx) const
+    {
+      const size_t rowIdxIn = m_verticalPlan.index(_rowIdxOut) + _idx;
+      const size_t heightIn = m_verticalPlan.sizeIn();
+      return std::min(rowIdxIn < _VerticalInterpolation::s_windowBefore ? 0 : rowIdxIn - _VerticalInterpolation::s_windowBefore,
+                      heightIn == 0 ? 0 : heightIn-1);
+    }
+
+    /*
+     * Rough per-frame cost in pixel reads and interpolation taps.
+     * Vertical first filters every input column for every output row,
+     * horizontal first filters every distinct input row once and then combines rows.
+     */
+    bool isHorizontalFirstCheaper() const
+    {
+      const size_t widthIn   = m_horizontalPlan.sizeIn();
+      const size_t widthOut  = m_horizontalPlan.sizeOut();
+      const size_t heightIn  = m_verticalPlan.sizeIn();
+      const size_t heightOut = m_verticalPlan.sizeOut();
+      if (heightIn == 0)
+        return false;
+
+      size_t rowsIn = 0;
+      size_t rowInNext = 0;
+      for (size_t rowIdxOut = 0; rowIdxOut < heightOut; ++rowIdxOut)
+      {
+        const size_t rowIdxIn = m_verticalPlan.index(rowIdxOut);
+        const size_t rowFirst = rowIdxIn < _VerticalInterpolation::s_windowBefore ? 0 : rowIdxIn - _VerticalInterpolation::s_windowBefore;
+        const size_t rowLast  = std::min(rowIdxIn + _VerticalInterpolation::s_windowAfter, heightIn-1);
+        const size_t rowFrom  = std::max(rowFirst, rowInNext);
+        if (rowLast >= rowFrom)
+        {
+          rowsIn += rowLast - rowFrom + 1;
+          rowInNext = rowLast + 1;
+        }
+      }
+
+      const size_t costVerticalFirst   = heightOut * (  widthIn  * 2 * _VerticalInterpolation::s_windowSize
+                                                      + widthOut * _HorizontalInterpolation::s_windowSize);
+      const size_t costHorizontalFirst = rowsIn    * (  widthIn
+                                                      + widthOut * _HorizontalInterpolation::s_windowSize)
+                                       + heightOut * widthOut * _VerticalInterpolation::s_windowSize;
+
+      return costHorizontalFirst < costVerticalFirst;
+    }
+
+    // 1 to 4 when every output index maps to input index idxOut*factor with zero phase, 0 otherwise
+    template <typename _Plan>
+    static size_t decimationFactor(const _Plan& _plan)
+    {
+      const size_t sizeIn  = _plan.sizeIn();
+      const size_t sizeOut = _plan.sizeOut();
+      if (sizeOut == 0 || sizeIn % sizeOut != 0)
+        return 0;
+
+      const size_t factor = sizeIn / sizeOut;
+      if (factor < 1 || factor > 4)
+        return 0;
+
+      for (size_t idxOut = 0; idxOut < sizeOut; ++idxOut)
+        if (_plan.index(idxOut) != idxOut * factor)
+          return 0;
+
+      return factor;
+    }
+
+    template <size_t _columnsFactor>
+    bool resampleDecimated(const _ImageIn& _imageIn,
+                           _ImageOut& _imageOut,
+                           size_t _rowIdxOutBegin,
+                           size_t _rowIdxOutEnd) const
+    {
+      const PixelSetIn2OutConvertion resultPixelSetConvertion;
+      const size_t widthOut = _imageOut.width();
+
+      for (size_t rowIdxOut = _rowIdxOutBegin; rowIdxOut < _rowIdxOutEnd; ++rowIdxOut)
+      {
+        typename _ImageIn::UncheckedRowType rowIn;
+        RowSetOut rowSetOut;
+        if (   !_imageIn.getRow(rowIn, m_verticalPlan.index(rowIdxOut))
+            || !_imageOut.template getRowSet<0, 0>(rowSetOut, rowIdxOut))
+          return false;
+
+        bool isOk = true;
+        typename Component::Value y = 0;
+        typename Component::Value u = 0;
+        typename Component::Value v = 0;
+        typename Component::Value unused;
+        for (size_t colIdxOut = 0; colIdxOut < widthOut; ++colIdxOut)
+        {
+          PixelSetInResult  resIn;
+          PixelSetOutResult resOut;
+
+          if (_columnsFactor > 1 && colIdxOut > 0)
+            isOk &= rowIn.skipPixels(_columnsFactor-1);
+          isOk &= rowIn.readPixel(resIn[0]);
+
+          // output pixel pair shares chroma, as in resampleRowPlanes()
+          if (s_chromaPlanes && colIdxOut%2 == 0)
+            resIn[0].toComponents(y, u, v);
+          else if (s_chromaPlanes)
+          {
+            resIn[0].toComponents(y, unused, unused);
+            resIn[0].fromComponents(y, u, v);
+          }
+
+          isOk &= resultPixelSetConvertion(resIn, resOut);
+          isOk &= rowSetOut.writePixelSet(resOut);
+        }
+
+        if (!isOk)
+          return false;
+      }
+
+      return true;
+    }
+
+    bool resampleVerticalFirst(const _ImageIn& _imageIn,
+                               _ImageOut& _imageOut,
+                               size_t _rowIdxOutBegin,
+                               size_t _rowIdxOutEnd) const
     {
       RowSetIn    rowSetIn;
       RowSetOut   rowSetOut;
@@ -77,59 +782,318 @@ class AlgoResampleVH : private assert_inst<(   _VerticalInterpolation::s_isAlgor
       PixelSetInHorizontal horizontalPixelSet;
       const PixelSetIn2OutConvertion resultPixelSetConvertion;
 
-      VerticalInterpolationCache verticalInterpolationCache;
-      HorizontalInterpolationCache horizontalInterpolationCache;
-
-      const float in2outCFactor = static_cast<float>(_imageIn.width())  / static_cast<float>(_imageOut.width() );
-      const float in2outRFactor = static_cast<float>(_imageIn.height()) / static_cast<float>(_imageOut.height());
-
-      for (size_t rowIdxOut = 0; rowIdxOut < _imageOut.height(); ++rowIdxOut)
+      for (size_t rowIdxOut = _rowIdxOutBegin; rowIdxOut < _rowIdxOutEnd; ++rowIdxOut)
       {
-        size_t rowIdxIn;
-        float rowIdxInFract;
-        if (!convertCoord(rowIdxOut, in2outRFactor, rowIdxIn, rowIdxInFract))
-          return false;
+        const size_t rowIdxIn = m_verticalPlan.index(rowIdxOut);
 
         if (!prepareRowSet(_imageIn, rowSetIn, rowIdxIn, _imageOut, rowSetOut, rowIdxOut))
           return false;
 
-        const _VerticalInterpolation& verticalInterpolation = getInterpolationCache(verticalInterpolationCache,
-                                                                                    rowIdxInFract);
+        const _VerticalInterpolation& verticalInterpolation = m_verticalPlan.interpolation(rowIdxOut);
 
         size_t colIdxInLast;
-        if (!initializeHorizontalPixelSet(rowSetIn, horizontalPixelSet, verticalInterpolation, colIdxInLast))
+        size_t remainIn;
+        if (!initializeHorizontalPixelSet(rowSetIn, horizontalPixelSet, verticalInterpolation, colIdxInLast, remainIn))
           return false;
 
         for (size_t colIdxOut = 0; colIdxOut < _imageOut.width(); ++colIdxOut)
         {
-          size_t colIdxIn;
-          float colIdxInFract;
-          if (!convertCoord(colIdxOut, in2outCFactor, colIdxIn, colIdxInFract))
+          if (!updateHorizontalPixelSet(rowSetIn, horizontalPixelSet, verticalInterpolation,
+                                        colIdxInLast, m_horizontalPlan.index(colIdxOut), remainIn))
             return false;
 
-          if (!updateHorizontalPixelSet(rowSetIn, horizontalPixelSet, verticalInterpolation, colIdxInLast, colIdxIn))
+          if (!outputHorizontalPixelSet(horizontalPixelSet, rowSetOut,
+                                        m_horizontalPlan.interpolation(colIdxOut), resultPixelSetConvertion))
             return false;
+        }
+      }
 
-          const _HorizontalInterpolation& horizontalInterpolation = getInterpolationCache(horizontalInterpolationCache,
-                                                                                          colIdxInFract);
+      return true;
+    }
 
-          if (!outputHorizontalPixelSet(horizontalPixelSet, rowSetOut, horizontalInterpolation, resultPixelSetConvertion))
-            return false;
+    bool resampleHorizontalFirst(const _ImageIn& _imageIn,
+                                 _ImageOut& _imageOut,
+                                 size_t _rowIdxOutBegin,
+                                 size_t _rowIdxOutEnd,
+                                 Ring& _ring) const
+    {
+      const size_t widthOut = _imageOut.width();
+      const size_t ringSize = _VerticalInterpolation::s_windowSize;
+      resizeRing(_ring, widthOut);
+
+      size_t ringRows[ringSize];
+      for (size_t slot = 0; slot < ringSize; ++slot)
+        ringRows[slot] = s_ringRowNone;
+
+      size_t windowSlots[ringSize];
+
+      for (size_t rowIdxOut = _rowIdxOutBegin; rowIdxOut < _rowIdxOutEnd; ++rowIdxOut)
+      {
+        // consecutive clamped rows are distinct modulo ring size, so every row of the window owns a slot
+        for (size_t idx = 0; idx < ringSize; ++idx)
+        {
+          const size_t rowIdxWindow = windowRow(rowIdxOut, idx);
+          const size_t slot = rowIdxWindow % ringSize;
+
+          if (ringRows[slot] != rowIdxWindow)
+          {
+            typename _ImageIn::UncheckedRowType rowIn;
+            if (   !_imageIn.getRow(rowIn, rowIdxWindow)
+                || !fillRingRow(rowIn, _ring, slot, widthOut))
+              return false;
+            ringRows[slot] = rowIdxWindow;
+          }
+
+          windowSlots[idx] = slot;
         }
+
+        if (!combineRing(_ring, windowSlots, _imageOut, rowIdxOut))
+          return false;
       }
 
       return true;
     }
 
-  private:
-    static bool convertCoord(size_t _idx1, float _factor, size_t& _idx2, float& _fract)
+    static size_t chromaWidth(size_t _width)
     {
-      const float idx2f = _idx1 * _factor;
-      _idx2 = /*trunc*/idx2f;
-      _fract = idx2f - _idx2;
+      return (_width + 1) / 2;
+    }
+
+    void resizeRing(Ring& _ring, size_t _widthOut) const
+    {
+      const size_t ringSize = _VerticalInterpolation::s_windowSize;
+      const size_t padding  = _HorizontalInterpolation::s_windowBefore + _HorizontalInterpolation::s_windowAfter;
+
+      if (s_chromaPlanes)
+      {
+        _ring.m_luma.resize(ringSize * _widthOut);
+        _ring.m_chroma.resize(ringSize * chromaWidth(_widthOut));
+        _ring.m_lumaIn.resize(m_horizontalPlan.sizeIn() + padding);
+        _ring.m_chromaIn.resize(m_chromaPlan.sizeIn() + padding);
+      }
+      else
+        _ring.m_pixels.resize(ringSize * _widthOut);
+    }
+
+    template <typename _RowIn>
+    bool fillRingRow(_RowIn& _rowIn, Ring& _ring, size_t _slot, size_t _widthOut) const
+    {
+      if (!s_chromaPlanes)
+        return resampleRowHorizontal(_rowIn, &_ring.m_pixels[_slot * _widthOut], _widthOut);
+
+      return decodeRowPlanes(_rowIn, _ring)
+          && resampleRowPlanes(_ring, &_ring.m_luma[_slot * _widthOut], &_ring.m_chroma[_slot * chromaWidth(_widthOut)], _widthOut);
+    }
+
+    bool combineRing(const Ring& _ring, const size_t* _windowSlots, _ImageOut& _imageOut, size_t _rowIdxOut) const
+    {
+      const size_t ringSize = _VerticalInterpolation::s_windowSize;
+      const size_t widthOut = _imageOut.width();
+
+      if (!s_chromaPlanes)
+      {
+        const PixelIn* windowRows[ringSize];
+        for (size_t idx = 0; idx < ringSize; ++idx)
+          windowRows[idx] = &_ring.m_pixels[_windowSlots[idx] * widthOut];
+        return combineRowVertical(windowRows, _imageOut, _rowIdxOut);
+      }
+
+      const LumaIn*   lumaRows[ringSize];
+      const ChromaIn* chromaRows[ringSize];
+      for (size_t idx = 0; idx < ringSize; ++idx)
+      {
+        lumaRows[idx]   = &_ring.m_luma[_windowSlots[idx] * widthOut];
+        chromaRows[idx] = &_ring.m_chroma[_windowSlots[idx] * chromaWidth(widthOut)];
+      }
+      return combineRowPlanes(lumaRows, chromaRows, _imageOut, _rowIdxOut);
+    }
+
+    // pixel pair chroma is averaged, which is exact for packed YUV422 rows where both pixels carry the same chroma
+    template <typename _RowIn>
+    bool decodeRowPlanes(_RowIn& _rowIn, Ring& _ring) const
+    {
+      const size_t widthIn      = m_horizontalPlan.sizeIn();
+      const size_t widthInPairs = m_chromaPlan.sizeIn();
+      const size_t before       = _HorizontalInterpolation::s_windowBefore;
+      const size_t after        = _HorizontalInterpolation::s_windowAfter;
+      const typename Component::Weight half = Component::weight(0.5f);
+
+      if (widthIn == 0)
+        return false;
+
+      LumaIn*   luma   = &_ring.m_lumaIn[before];
+      ChromaIn* chroma = &_ring.m_chromaIn[before];
+      bool isOk = true;
+
+      for (size_t pair = 0; pair < widthInPairs; ++pair)
+      {
+        PixelIn pixel;
+        typename Component::Value u;
+        typename Component::Value v;
+
+        isOk &= _rowIn.readPixel(pixel);
+        pixel.toComponents(luma[pair*2][0], chroma[pair][0], chroma[pair][1]);
+
+        if (pair*2+1 < widthIn)
+        {
+          isOk &= _rowIn.readPixel(pixel);
+          pixel.toComponents(luma[pair*2+1][0], u, v);
+          chroma[pair][0] = Component::multiply(chroma[pair][0] + u, half);
+          chroma[pair][1] = Component::multiply(chroma[pair][1] + v, half);
+        }
+      }
+
+      for (size_t idx = 0; idx < before; ++idx)
+      {
+        _ring.m_lumaIn[idx]   = luma[0];
+        _ring.m_chromaIn[idx] = chroma[0];
+      }
+
+      for (size_t idx = 0; idx < after; ++idx)
+      {
+        luma[widthIn + idx]        = luma[widthIn-1];
+        chroma[widthInPairs + idx] = chroma[widthInPairs-1];
+      }
+
+      return isOk;
+    }
+
+    bool resampleRowPlanes(const Ring& _ring, LumaIn* _lumaOut, ChromaIn* _chromaOut, size_t _widthOut) const
+    {
+      ImagePixelRowView<LumaIn,   _HorizontalInterpolation::s_windowSize> lumaWindow(&_ring.m_lumaIn[0]);
+      ImagePixelRowView<ChromaIn, _HorizontalInterpolation::s_windowSize> chromaWindow(&_ring.m_chromaIn[0]);
+      bool isOk = true;
+
+      for (size_t colIdxOut = 0; colIdxOut < _widthOut; ++colIdxOut)
+      {
+        ImagePixelResultView<LumaIn> result(_lumaOut[colIdxOut]);
+        lumaWindow.first(m_horizontalPlan.index(colIdxOut));
+        isOk &= m_horizontalPlan.interpolation(colIdxOut)(lumaWindow, result);
+      }
+
+      for (size_t pairIdxOut = 0; pairIdxOut < chromaWidth(_widthOut); ++pairIdxOut)
+      {
+        ImagePixelResultView<ChromaIn> result(_chromaOut[pairIdxOut]);
+        chromaWindow.first(m_chromaPlan.index(pairIdxOut));
+        isOk &= m_chromaPlan.interpolation(pairIdxOut)(chromaWindow, result);
+      }
+
+      return isOk;
+    }
+
+    bool combineRowPlanes(const LumaIn* const* _lumaRows, const ChromaIn* const* _chromaRows,
+                          _ImageOut& _imageOut, size_t _rowIdxOut) const
+    {
+      RowSetOut rowSetOut;
+      if (!_imageOut.template getRowSet<0, 0>(rowSetOut, _rowIdxOut))
+        return false;
+
+      const PixelSetIn2OutConvertion resultPixelSetConvertion;
+      const _VerticalInterpolation& verticalInterpolation = m_verticalPlan.interpolation(_rowIdxOut);
+      ImagePixelColumnView<LumaIn,   _VerticalInterpolation::s_windowSize> lumaColumn(_lumaRows);
+      ImagePixelColumnView<ChromaIn, _VerticalInterpolation::s_windowSize> chromaColumn(_chromaRows);
+      ChromaIn chroma;
+      bool isOk = true;
+
+      for (size_t colIdxOut = 0; colIdxOut < _imageOut.width(); ++colIdxOut)
+      {
+        if (colIdxOut%2 == 0)
+        {
+          ImagePixelResultView<ChromaIn> chromaResult(chroma);
+          chromaColumn.column(colIdxOut/2);
+          isOk &= verticalInterpolation(chromaColumn, chromaResult);
+        }
+
+        LumaIn luma;
+        ImagePixelResultView<LumaIn> lumaResult(luma);
+        lumaColumn.column(colIdxOut);
+        isOk &= verticalInterpolation(lumaColumn, lumaResult);
+
+        PixelSetInResult  resIn;
+        PixelSetOutResult resOut;
+        resIn[0].fromComponents(luma[0], chroma[0], chroma[1]);
+        isOk &= resultPixelSetConvertion(resIn, resOut);
+        isOk &= rowSetOut.writePixelSet(resOut);
+      }
+
+      return isOk;
+    }
+
+    bool combineRowVertical(const PixelIn* const* _windowRows, _ImageOut& _imageOut, size_t _rowIdxOut) const
+    {
+      RowSetOut rowSetOut;
+      if (!_imageOut.template getRowSet<0, 0>(rowSetOut, _rowIdxOut))
+        return false;
+
+      const PixelSetIn2OutConvertion resultPixelSetConvertion;
+      const _VerticalInterpolation& verticalInterpolation = m_verticalPlan.interpolation(_rowIdxOut);
+      PixelColumnIn pixelColumn(_windowRows);
+
+      for (size_t colIdxOut = 0; colIdxOut < _imageOut.width(); ++colIdxOut)
+      {
+        PixelSetInResult  resIn;
+        PixelSetOutResult resOut;
+
+        pixelColumn.column(colIdxOut);
+        if (!verticalInterpolation(pixelColumn, resIn))
+          return false;
+
+        if (!resultPixelSetConvertion(resIn, resOut))
+          return false;
+
+        if (!rowSetOut.writePixelSet(resOut))
+          return false;
+      }
+
       return true;
     }
 
+    template <typename _RowIn>
+    bool resampleRowHorizontal(_RowIn& _rowIn, PixelIn* _rowOut, size_t _widthOut) const
+    {
+      size_t remainIn = m_horizontalPlan.sizeIn();
+      PixelSetInHorizontal pixelSetH;
+      if (remainIn == 0 || !_rowIn.readPixel(pixelSetH.insertNewPixel()))
+        return false;
+      --remainIn;
+
+      bool isOk = true;
+      for (size_t idx = 0; idx < _HorizontalInterpolation::s_windowBefore; ++idx)
+        isOk &= pixelSetH.insertLastPixelCopy();
+
+      for (size_t idx = 0; idx < _HorizontalInterpolation::s_windowAfter; ++idx)
+        isOk &= readNextRowPixel(_rowIn, pixelSetH, remainIn);
+
+      size_t colIdxInLast = 0;
+      for (size_t colIdxOut = 0; colIdxOut < _widthOut; ++colIdxOut)
+      {
+        for (const size_t colIdxIn = m_horizontalPlan.index(colIdxOut); colIdxInLast < colIdxIn; ++colIdxInLast)
+          isOk &= readNextRowPixel(_rowIn, pixelSetH, remainIn);
+
+        PixelSetInResult resIn;
+        isOk &= m_horizontalPlan.interpolation(colIdxOut)(pixelSetH, resIn);
+        _rowOut[colIdxOut] = resIn[0];
+      }
+
+      return isOk;
+    }
+
+    // past the end of row last pixel is repeated; unchecked rows cannot tell the end themselves, so it is counted
+    template <typename _RowIn>
+    bool readNextRowPixel(_RowIn& _rowIn, PixelSetInHorizontal& _pixelSetH, size_t& _remainIn) const
+    {
+      PixelIn pixel;
+
+      if (_remainIn > 0 && _rowIn.readPixel(pixel))
+      {
+        --_remainIn;
+        _pixelSetH.insertNewPixel() = pixel;
+        return true;
+      }
+      else
+        return _pixelSetH.insertLastPixelCopy();
+    }
+
     bool prepareRowSet(const _ImageIn& _imageIn,  RowSetIn&  _rowSetIn,  size_t _rowIdxIn,
                        _ImageOut&      _imageOut, RowSetOut& _rowSetOut, size_t _rowIdxOut) const
     {
@@ -143,32 +1107,42 @@ class AlgoResampleVH : private assert_inst<(   _VerticalInterpolation::s_isAlgor
       return true;
     }
 
+    // past the end of rows last column is repeated, see readNextRowPixel()
     bool readNextHorizontalPixel(RowSetIn& _rowSetIn, PixelSetInHorizontal& _pixelSetH,
-                                 const _VerticalInterpolation& _interpolation) const
+                                 const _VerticalInterpolation& _interpolation,
+                                 size_t& _remainIn) const
     {
       PixelSetInVertical pixelSetV;
 
-      if (_rowSetIn.readPixelSet(pixelSetV))
+      if (_remainIn > 0 && _rowSetIn.readPixelSet(pixelSetV))
+      {
+        --_remainIn;
         return _interpolation(pixelSetV, _pixelSetH);
+      }
       else
         return _pixelSetH.insertLastPixelCopy();
     }
 
     bool initializeHorizontalPixelSet(RowSetIn& _rowSetIn, PixelSetInHorizontal& _pixelSetH,
                                       const _VerticalInterpolation& _interpolation,
-                                      size_t& _colIdxLast) const
+                                      size_t& _colIdxLast, size_t& _remainIn) const
     {
+      _remainIn = m_horizontalPlan.sizeIn();
+      if (_remainIn == 0)
+        return false;
+      --_remainIn;
+
       bool isOk = true;
       PixelSetInVertical pixelSetV;
 
       isOk &= _rowSetIn.readPixelSet(pixelSetV);
       isOk &= _interpolation(pixelSetV, _pixelSetH);
 
-      for (size_t idx = 0; idx < _VerticalInterpolation::s_windowBefore; ++idx)
+      for (size_t idx = 0; idx < _HorizontalInterpolation::s_windowBefore; ++idx)
         isOk &= _pixelSetH.insertLastPixelCopy();
 
-      for (size_t idx = 0; idx < _VerticalInterpolation::s_windowAfter; ++idx)
-        isOk &= readNextHorizontalPixel(_rowSetIn, _pixelSetH, _interpolation);
+      for (size_t idx = 0; idx < _HorizontalInterpolation::s_windowAfter; ++idx)
+        isOk &= readNextHorizontalPixel(_rowSetIn, _pixelSetH, _interpolation, _remainIn);
 
       _colIdxLast = 0;
       return isOk;
@@ -176,11 +1150,11 @@ class AlgoResampleVH : private assert_inst<(   _VerticalInterpolation::s_isAlgor
 
     bool updateHorizontalPixelSet(RowSetIn& _rowSetIn, PixelSetInHorizontal& _pixelSetH,
                                   const _VerticalInterpolation& _interpolation,
-                                  size_t& _colIdxLast, size_t _colIdxDesired) const
+                                  size_t& _colIdxLast, size_t _colIdxDesired, size_t& _remainIn) const
     {
       bool isOk = true;
       for (/*_colIdxLast*/; _colIdxLast < _colIdxDesired; ++_colIdxLast)
-        isOk &= readNextHorizontalPixel(_rowSetIn, _pixelSetH, _interpolation);
+        isOk &= readNextHorizontalPixel(_rowSetIn, _pixelSetH, _interpolation, _remainIn);
       return true;
     }
 
@@ -204,17 +1178,15 @@ class AlgoResampleVH : private assert_inst<(   _VerticalInterpolation::s_isAlgor
       return true;
     }
 
-    template <typename _InterpolationCache>
-    const typename _InterpolationCache::mapped_type& getInterpolationCache(_InterpolationCache& _cache,
-                                                                           float _fract) const
-    {
-      const typename _InterpolationCache::const_iterator it(_cache.find(_fract));
-      if (it != _cache.end())
-        return it->second;
-
-      return _cache.insert(std::make_pair(_fract, typename _InterpolationCache::mapped_type(_fract))).first->second;
-    }
-
+    VerticalPlan         m_verticalPlan;
+    HorizontalPlan       m_horizontalPlan;
+    HorizontalPlan       m_chromaPlan;
+    Schedule             m_schedule;
+    bool                 m_scheduleValid;
+    bool                 m_horizontalFirst;
+    size_t               m_decimationColumns;
+    size_t               m_decimationRows;
+    BandState            m_bandState;
 };
 
 
@@ -0,0 +1,74 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_BUFFER_HPP_
+#define TRIK_LIBIMAGE_IMAGE_BUFFER_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <stdint.h>
+#include <vector>
+
+#include <libimage/stdcpp.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+
+
+/*
+ * Owned image memory starting at cache line, for images which are not given buffers by driver or codec.
+ * Together with Image::calcAlignedLineLength() every row starts at cache line.
+ */
+class ImageBuffer : private noncopyable
+{
+  public:
+    explicit ImageBuffer(size_t _size = 0, size_t _alignment = s_cacheLineSize)
+     :m_storage(),
+      m_offset(0),
+      m_size(0),
+      m_alignment(_alignment)
+    {
+      resize(_size);
+    }
+
+    // contents are not preserved
+    void resize(size_t _size)
+    {
+      if (_size == m_size && !m_storage.empty())
+        return;
+
+      m_storage.resize(_size + m_alignment - 1);
+      const uintptr_t base = reinterpret_cast<uintptr_t>(&m_storage.front());
+      m_offset = alignSize(base, m_alignment) - base;
+      m_size   = _size;
+    }
+
+    uint8_t* data()
+    {
+      return &m_storage.front() + m_offset;
+    }
+
+    const uint8_t* data() const
+    {
+      return &m_storage.front() + m_offset;
+    }
+
+    const size_t& size() const
+    {
+      return m_size;
+    }
+
+  private:
+    std::vector<uint8_t> m_storage;
+    size_t               m_offset;
+    size_t               m_size;
+    size_t               m_alignment;
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_BUFFER_HPP_
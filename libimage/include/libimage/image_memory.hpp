@@ -0,0 +1,228 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_MEMORY_HPP_
+#define TRIK_LIBIMAGE_IMAGE_MEMORY_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <stdint.h>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <libimage/stdcpp.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+
+
+/*
+ * Memory for algorithm plans and scratch rows. It comes from heap unless owner of algorithms passes
+ * arena over its own memory block, e.g. codec over IALG memTab, to their constructors. Arena is first
+ * fit over blocks with headers, adjacent free blocks are merged. Arena is not locked: algorithms sharing
+ * one arena must not run concurrently, algorithms over distinct arenas are independent.
+ */
+class ImageMemoryArena : private noncopyable
+{
+  public:
+    // every block is aligned for any scalar type of C674x, ARM and x86
+    static const size_t s_alignment = 8;
+
+    ImageMemoryArena(void* _memory, size_t _size)
+     :m_begin(NULL),
+      m_end(NULL),
+      m_used(0),
+      m_peak(0)
+    {
+      const uintptr_t begin = alignSize(reinterpret_cast<uintptr_t>(_memory), s_alignment);
+      const uintptr_t end   = reinterpret_cast<uintptr_t>(_memory) + _size;
+      if (_memory == NULL || end < begin + s_headerSize + s_alignment)
+        return;
+
+      m_begin = reinterpret_cast<uint8_t*>(begin);
+      m_end   = m_begin + ((end - begin) & ~(s_alignment - 1));
+      header(m_begin)->m_size = m_end - m_begin - s_headerSize;
+      header(m_begin)->m_free = true;
+    }
+
+    // NULL when no free block is large enough
+    void* allocate(size_t _size)
+    {
+      const size_t size = alignSize(_size == 0 ? 1 : _size, s_alignment);
+
+      for (uint8_t* block = m_begin; block != NULL && block < m_end; block = next(block))
+      {
+        Header* const blockHeader = header(block);
+        if (!blockHeader->m_free)
+          continue;
+
+        // merge free neighbours lazily, deallocate() stays O(1)
+        for (uint8_t* following = next(block); following < m_end && header(following)->m_free; following = next(block))
+          blockHeader->m_size += s_headerSize + header(following)->m_size;
+
+        if (blockHeader->m_size < size)
+          continue;
+
+        if (blockHeader->m_size >= size + s_headerSize + s_alignment)
+        {
+          uint8_t* const rest = block + s_headerSize + size;
+          header(rest)->m_size = blockHeader->m_size - size - s_headerSize;
+          header(rest)->m_free = true;
+          blockHeader->m_size = size;
+        }
+
+        blockHeader->m_free = false;
+        m_used += s_headerSize + blockHeader->m_size;
+        m_peak  = std::max(m_peak, m_used);
+        return block + s_headerSize;
+      }
+
+      return NULL;
+    }
+
+    // false when pointer was not allocated by this arena
+    bool deallocate(void* _ptr)
+    {
+      if (!owns(_ptr))
+        return false;
+
+      Header* const blockHeader = header(static_cast<uint8_t*>(_ptr) - s_headerSize);
+      assert(!blockHeader->m_free);
+      blockHeader->m_free = true;
+      m_used -= s_headerSize + blockHeader->m_size;
+      return true;
+    }
+
+    bool owns(const void* _ptr) const
+    {
+      return _ptr >= m_begin && _ptr < m_end;
+    }
+
+    // including block headers
+    const size_t& used() const { return m_used; }
+    const size_t& peak() const { return m_peak; }
+
+    // arena which has to give out blocks of given sizes needs this much memory, not counting alignment of its start
+    static size_t blockSize(size_t _size)
+    {
+      return s_headerSize + alignSize(_size == 0 ? 1 : _size, s_alignment);
+    }
+
+  private:
+    struct Header
+    {
+      size_t m_size;
+      bool   m_free;
+    };
+
+    static const size_t s_headerSize = (sizeof(Header) + s_alignment - 1) & ~(s_alignment - 1);
+
+    uint8_t* m_begin;
+    uint8_t* m_end;
+    size_t   m_used;
+    size_t   m_peak;
+
+    static Header* header(uint8_t* _block)
+    {
+      return reinterpret_cast<Header*>(_block);
+    }
+
+    static uint8_t* next(uint8_t* _block)
+    {
+      return _block + s_headerSize + header(_block)->m_size;
+    }
+};
+
+
+// standard allocator over given arena, NULL arena means heap; request which arena cannot satisfy goes
+// to heap, so undersized arena costs allocations, not failures; block returns to arena it came from
+template <typename _T>
+class ImageAllocator
+{
+  public:
+    typedef _T              value_type;
+    typedef _T*             pointer;
+    typedef const _T*       const_pointer;
+    typedef _T&             reference;
+    typedef const _T&       const_reference;
+    typedef size_t          size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    template <typename _U>
+    struct rebind
+    {
+      typedef ImageAllocator<_U> other;
+    };
+
+    explicit ImageAllocator(ImageMemoryArena* _arena = NULL)
+     :m_arena(_arena)
+    {
+    }
+
+    template <typename _U>
+    ImageAllocator(const ImageAllocator<_U>& _other)
+     :m_arena(_other.arena())
+    {
+    }
+
+    ImageMemoryArena* arena() const { return m_arena; }
+
+    pointer       address(reference _value) const       { return &_value; }
+    const_pointer address(const_reference _value) const { return &_value; }
+
+    pointer allocate(size_type _count, const void* = NULL)
+    {
+      void* const ptr = m_arena == NULL ? NULL : m_arena->allocate(_count * sizeof(_T));
+      return static_cast<pointer>(ptr != NULL ? ptr : ::operator new(_count * sizeof(_T)));
+    }
+
+    void deallocate(pointer _ptr, size_type)
+    {
+      if (m_arena == NULL || !m_arena->deallocate(_ptr))
+        ::operator delete(_ptr);
+    }
+
+    size_type max_size() const
+    {
+      return static_cast<size_type>(-1) / sizeof(_T);
+    }
+
+    void construct(pointer _ptr, const _T& _value)
+    {
+      new (static_cast<void*>(_ptr)) _T(_value);
+    }
+
+    void destroy(pointer _ptr)
+    {
+      _ptr->~_T();
+    }
+
+  private:
+    ImageMemoryArena* m_arena;
+};
+
+// blocks of one arena may be released through any allocator over it
+template <typename _T, typename _U>
+inline bool operator==(const ImageAllocator<_T>& _a, const ImageAllocator<_U>& _b) { return _a.arena() == _b.arena(); }
+
+template <typename _T, typename _U>
+inline bool operator!=(const ImageAllocator<_T>& _a, const ImageAllocator<_U>& _b) { return _a.arena() != _b.arena(); }
+
+
+// container of algorithm state, see ImageMemoryArena
+template <typename _T>
+class ImageVector
+{
+  public:
+    typedef ImageAllocator<_T>             Allocator;
+    typedef std::vector<_T, Allocator>     Type;
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_MEMORY_HPP_
@@ -6,7 +6,9 @@
 #endif
 
 
+#include <stdint.h>
 #include <climits>
+#include <cmath>
 #include <iostream>
 
 #include <libimage/stdcpp.hpp>
@@ -55,6 +57,241 @@ class BaseImagePixelAccessor
 };
 
 
+
+
+/*
+ * Pixel component representation policies.
+ * Value is how single color component is kept in ImagePixel, Weight is what interpolation multiplies it by.
+ * Interpolation sums product() of every tap and reduce() brings the sum back to Value precision once.
+ */
+class ImagePixelComponentFloat
+{
+  public:
+    typedef float Value;
+    typedef float Weight;
+
+    static Value load(unsigned _value)
+    {
+      return _value;
+    }
+
+    static unsigned store(const Value& _value, unsigned _max)
+    {
+      return roundf(std::min(static_cast<float>(_max), std::max(0.0f, _value)));
+    }
+
+    // nearest multiple of 2^-_fractBits, in Q_fractBits, not saturated
+    static int32_t round(const Value& _value, size_t _fractBits)
+    {
+      const float rounded = _value * static_cast<float>(1u << _fractBits) + 0.5f;
+      const int32_t truncated = static_cast<int32_t>(rounded);
+      return rounded < truncated ? truncated - 1 : truncated;
+    }
+
+    static float normalize(const Value& _value, unsigned _max)
+    {
+      return _value / static_cast<float>(_max);
+    }
+
+    static Value denormalize(const float& _normalized, unsigned _max)
+    {
+      return _normalized * static_cast<float>(_max);
+    }
+
+    static Weight weight(const float& _weight)
+    {
+      return _weight;
+    }
+
+    static void fixupWeights(Weight* _weights, size_t _weightsCount)
+    {
+      (void)_weights;
+      (void)_weightsCount;
+    }
+
+    static Value multiply(const Value& _value, const Weight& _weight)
+    {
+      return _value * _weight;
+    }
+
+    static Value product(const Value& _value, const Weight& _weight)
+    {
+      return _value * _weight;
+    }
+
+    static Value reduce(const Value& _sum)
+    {
+      return _sum;
+    }
+};
+
+
+/*
+ * Fixed point components: values in Q6 (8-bit component fits int16), weights in Q14,
+ * products are computed in 32 bits, store saturates to component range. multiply() rounds its product
+ * back to Q6, interpolation sums Q20 products and rounds the sum once: 8-bit component with Lanczos3
+ * overshoot times sum of absolute weights stays well within int32.
+ */
+class ImagePixelComponentFixed
+{
+  public:
+    typedef int32_t Value;
+    typedef int32_t Weight;
+
+    static const size_t s_valueFractBits  = 6;
+    static const size_t s_weightFractBits = 14;
+
+    static Value load(unsigned _value)
+    {
+      return static_cast<Value>(_value) << s_valueFractBits;
+    }
+
+    static unsigned store(const Value& _value, unsigned _max)
+    {
+      const Value rounded = (_value + (static_cast<Value>(1) << (s_valueFractBits-1))) >> s_valueFractBits;
+      if (rounded < 0)
+        return 0;
+      if (static_cast<unsigned>(rounded) > _max)
+        return _max;
+      return rounded;
+    }
+
+    // _fractBits must be below s_valueFractBits
+    static int32_t round(const Value& _value, size_t _fractBits)
+    {
+      const size_t shift = s_valueFractBits - _fractBits;
+      return (_value + (static_cast<Value>(1) << (shift-1))) >> shift;
+    }
+
+    static float normalize(const Value& _value, unsigned _max)
+    {
+      return static_cast<float>(_value) / (static_cast<float>(_max) * (1u << s_valueFractBits));
+    }
+
+    static Value denormalize(const float& _normalized, unsigned _max)
+    {
+      return floorf(_normalized * static_cast<float>(_max) * (1u << s_valueFractBits) + 0.5f);
+    }
+
+    static Weight weight(const float& _weight)
+    {
+      return floorf(_weight * (1u << s_weightFractBits) + 0.5f);
+    }
+
+    // rounded weights must still sum to exactly 1.0, otherwise flat areas drift; correct the largest one
+    static void fixupWeights(Weight* _weights, size_t _weightsCount)
+    {
+      if (_weightsCount == 0)
+        return;
+
+      Weight sum = 0;
+      size_t largest = 0;
+      for (size_t idx = 0; idx < _weightsCount; ++idx)
+      {
+        sum += _weights[idx];
+        if (_weights[idx] > _weights[largest])
+          largest = idx;
+      }
+
+      _weights[largest] += (static_cast<Weight>(1) << s_weightFractBits) - sum;
+    }
+
+    static Value multiply(const Value& _value, const Weight& _weight)
+    {
+      return (_value * _weight + (static_cast<Value>(1) << (s_weightFractBits-1))) >> s_weightFractBits;
+    }
+
+    static Value product(const Value& _value, const Weight& _weight)
+    {
+      return _value * _weight;
+    }
+
+    static Value reduce(const Value& _sum)
+    {
+      return (_sum + (static_cast<Value>(1) << (s_weightFractBits-1))) >> s_weightFractBits;
+    }
+};
+
+
+/*
+ * Compact fixed point components: same Q6 values, Q14 weights and rounding as ImagePixelComponentFixed,
+ * but kept in int16, so 3-component intermediate pixel takes 6 bytes instead of 12.
+ * Products are still computed in 32 bits. Q6 int16 holds 8-bit components with linear and cubic overshoot,
+ * wider kernels may overflow it. Q20 product does not fit int16, so every product is rounded to Q6 before summing.
+ */
+class ImagePixelComponentCompact
+{
+  public:
+    typedef int16_t Value;
+    typedef int16_t Weight;
+
+    static const size_t s_valueFractBits  = ImagePixelComponentFixed::s_valueFractBits;
+    static const size_t s_weightFractBits = ImagePixelComponentFixed::s_weightFractBits;
+
+    static Value load(unsigned _value)
+    {
+      return static_cast<Value>(ImagePixelComponentFixed::load(_value));
+    }
+
+    static unsigned store(const Value& _value, unsigned _max)
+    {
+      return ImagePixelComponentFixed::store(_value, _max);
+    }
+
+    static int32_t round(const Value& _value, size_t _fractBits)
+    {
+      return ImagePixelComponentFixed::round(_value, _fractBits);
+    }
+
+    static float normalize(const Value& _value, unsigned _max)
+    {
+      return ImagePixelComponentFixed::normalize(_value, _max);
+    }
+
+    static Value denormalize(const float& _normalized, unsigned _max)
+    {
+      return static_cast<Value>(ImagePixelComponentFixed::denormalize(_normalized, _max));
+    }
+
+    static Weight weight(const float& _weight)
+    {
+      return static_cast<Weight>(ImagePixelComponentFixed::weight(_weight));
+    }
+
+    static void fixupWeights(Weight* _weights, size_t _weightsCount)
+    {
+      if (_weightsCount == 0)
+        return;
+
+      int32_t sum = 0;
+      size_t largest = 0;
+      for (size_t idx = 0; idx < _weightsCount; ++idx)
+      {
+        sum += _weights[idx];
+        if (_weights[idx] > _weights[largest])
+          largest = idx;
+      }
+
+      _weights[largest] += (static_cast<int32_t>(1) << s_weightFractBits) - sum;
+    }
+
+    static Value multiply(const Value& _value, const Weight& _weight)
+    {
+      return static_cast<Value>(ImagePixelComponentFixed::multiply(_value, _weight));
+    }
+
+    static Value product(const Value& _value, const Weight& _weight)
+    {
+      return multiply(_value, _weight);
+    }
+
+    static Value reduce(const Value& _sum)
+    {
+      return _sum;
+    }
+};
+
+
 } /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
 
 
@@ -69,7 +306,11 @@ class BaseImagePixel
       PixelRGB565X,
       PixelRGB888,
       PixelYUV444,
-      PixelYUV422
+      PixelYUV422,
+      PixelGRAY8,
+      PixelRGBA8888,
+      PixelBGRA8888,
+      PixelXRGB8888
     };
 
   protected:
@@ -77,7 +318,7 @@ class BaseImagePixel
 };
 
 
-template <BaseImagePixel::PixelType _PT>
+template <BaseImagePixel::PixelType _PT, typename _Component = internal::ImagePixelComponentFloat>
 class ImagePixel : public BaseImagePixel,
                    private internal::BaseImagePixelAccessor,
                    private assert_inst<false> // Generic instance, non-functional
@@ -96,12 +337,13 @@ class BaseImagePixelSet
 
 
 
-template <BaseImagePixel::PixelType _PT, size_t _pixelsCount>
+template <BaseImagePixel::PixelType _PT, size_t _pixelsCount,
+          typename _Component = internal::ImagePixelComponentFloat>
 class ImagePixelSet : public BaseImagePixelSet,
                       private assert_inst<(_pixelsCount > 0)> // sanity check
 {
   public:
-    typedef ImagePixel<_PT> Pixel;
+    typedef ImagePixel<_PT, _Component> Pixel;
 
     ImagePixelSet()
      :BaseImagePixelSet(),
@@ -170,13 +412,15 @@ class ImagePixelSet : public BaseImagePixelSet,
 
 
 
-template <typename _PixelType1, typename _PixelType2>
-class ImagePixelConvertion
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+// convertion through normalized RGB, suits any pair of pixel types
+template <typename _PixelType1, typename _PixelType2, bool _byTable>
+class ImagePixelConvertionImpl
 {
   public:
-    ImagePixelConvertion() {}
-
-    bool operator()(const _PixelType1& _p1, _PixelType2& _p2) const
+    static bool convert(const _PixelType1& _p1, _PixelType2& _p2)
     {
       float nr;
       float ng;
@@ -187,6 +431,45 @@ class ImagePixelConvertion
     }
 };
 
+// 8 bit YUV to RGB goes through integer tables instead, see image_pixel_yuv.hpp
+template <typename _PixelType1, typename _PixelType2>
+class ImagePixelConvertionByTable
+{
+  public:
+    static const bool s_value = false;
+};
+
+template <BaseImagePixel::PixelType _PT1, BaseImagePixel::PixelType _PT2, typename _Component>
+class ImagePixelConvertionByTable<ImagePixel<_PT1, _Component>, ImagePixel<_PT2, _Component> >
+{
+  public:
+    static const bool s_value = (   _PT1 == BaseImagePixel::PixelYUV444
+                                 || _PT1 == BaseImagePixel::PixelYUV422)
+                             && (   _PT2 == BaseImagePixel::PixelRGB565
+                                 || _PT2 == BaseImagePixel::PixelRGB565X
+                                 || _PT2 == BaseImagePixel::PixelRGB888
+                                 || _PT2 == BaseImagePixel::PixelRGBA8888
+                                 || _PT2 == BaseImagePixel::PixelBGRA8888
+                                 || _PT2 == BaseImagePixel::PixelXRGB8888);
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+template <typename _PixelType1, typename _PixelType2>
+class ImagePixelConvertion
+{
+  public:
+    ImagePixelConvertion() {}
+
+    bool operator()(const _PixelType1& _p1, _PixelType2& _p2) const
+    {
+      return internal::ImagePixelConvertionImpl<_PixelType1, _PixelType2,
+                                                internal::ImagePixelConvertionByTable<_PixelType1, _PixelType2>::s_value>::convert(_p1, _p2);
+    }
+};
+
 template <typename _PixelType>
 class ImagePixelConvertion<_PixelType, _PixelType> // specialization for same type copy
 {
@@ -233,6 +516,7 @@ class ImagePixelSetConvertion
 
 #include <libimage/image_pixel_rgb.hpp>
 #include <libimage/image_pixel_yuv.hpp>
+#include <libimage/image_pixel_gray.hpp>
 
 
 #endif // !TRIK_LIBIMAGE_IMAGE_PIXEL_HPP_
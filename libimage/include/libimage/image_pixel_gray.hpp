@@ -0,0 +1,216 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_PIXEL_GRAY_HPP_
+#define TRIK_LIBIMAGE_IMAGE_PIXEL_GRAY_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <stdio.h>
+#include <cmath>
+#include <iostream>
+
+#include <libimage/stdcpp.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+template <size_t _YBits, typename _Component>
+class ImagePixelGrayAccessor : private assert_inst<(_YBits>=1)>
+{
+  public:
+    bool toNormalizedRGB(float& _nr, float& _ng, float& _nb) const
+    {
+      _nr = _ng = _nb = range(0.0f, _Component::normalize(m_y, yMax()), 1.0f);
+      return true;
+    }
+
+    // same luma as YUV fromNormalizedRGB()
+    bool fromNormalizedRGB(const float& _nr, const float& _ng, const float& _nb)
+    {
+      m_y = _Component::denormalize(0.2990*_nr + 0.5870*_ng + 0.1140*_nb, yMax());
+      return true;
+    }
+
+    void toComponents(typename _Component::Value& _y) const
+    {
+      _y = m_y;
+    }
+
+    void fromComponents(const typename _Component::Value& _y)
+    {
+      m_y = _y;
+    }
+
+  protected:
+    typedef typename _Component::Value  Value;
+    typedef typename _Component::Weight Weight;
+
+    ImagePixelGrayAccessor()
+     :m_y()
+    {
+    }
+
+    ImagePixelGrayAccessor(const ImagePixelGrayAccessor& _src)
+     :m_y(_src.m_y)
+    {
+    }
+
+    void loadY(unsigned _y)
+    {
+      m_y = _Component::load(_y);
+    }
+
+    unsigned storeY() const
+    {
+      return _Component::store(m_y, yMax());
+    }
+
+    void operatorMultiplyImpl(const Weight& _w)
+    {
+      m_y = _Component::multiply(m_y, _w);
+    }
+
+    void operatorIncrementImpl(const ImagePixelGrayAccessor& _p)
+    {
+      m_y += _p.m_y;
+    }
+
+    void operatorAccumulateImpl(const ImagePixelGrayAccessor& _p, const Weight& _w)
+    {
+      m_y += _Component::product(_p.m_y, _w);
+    }
+
+    void operatorReduceImpl()
+    {
+      m_y = _Component::reduce(m_y);
+    }
+
+    void operatorExtractImpl(std::ostream& _os) const
+    {
+      float nr;
+      float ng;
+      float nb;
+
+      toNormalizedRGB(nr, ng, nb);
+      _os << '(' << nr << ')';
+    }
+
+  private:
+    Value m_y;
+
+    static unsigned yMax() { return (1u<<_YBits) - 1; }
+    static float range(float _min, float _val, float _max) { return std::min(_max, std::max(_min, _val)); }
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+
+
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelGRAY8, _Component> : public BaseImagePixel,
+                                                           private internal::BaseImagePixelAccessor,
+                                                           public internal::ImagePixelGrayAccessor<8, _Component>
+{
+  public:
+    ImagePixel() {}
+
+    template <typename UByte>
+    bool unpack(const UByte& _b1)
+    {
+      this->loadY(utypeGet<UByte, true>(_b1, 8, 0));
+      return true;
+    }
+
+    template <typename UByte>
+    bool pack(UByte& _b1) const
+    {
+      _b1 = utypeValue<UByte, true>(this->storeY(), 8, 0);
+      return true;
+    }
+
+    ImagePixel operator*(const typename _Component::Weight& _w) const
+    {
+      ImagePixel p(*this);
+      p.operatorMultiplyImpl(_w);
+      return p;
+    }
+
+    ImagePixel& operator+=(const ImagePixel& _p)
+    {
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
+  private:
+    friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
+    {
+      _p.operatorExtractImpl(_os);
+      return _os;
+    }
+};
+
+
+
+
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+// YUV already carries luma, it is taken as is instead of going through RGB
+template <typename _Component>
+class ImagePixelConvertionImpl<ImagePixel<BaseImagePixel::PixelYUV444, _Component>, ImagePixel<BaseImagePixel::PixelGRAY8, _Component>, false>
+{
+  public:
+    static bool convert(const ImagePixel<BaseImagePixel::PixelYUV444, _Component>& _p1, ImagePixel<BaseImagePixel::PixelGRAY8, _Component>& _p2)
+    {
+      typename _Component::Value y;
+      typename _Component::Value u;
+      typename _Component::Value v;
+
+      _p1.toComponents(y, u, v);
+      _p2.fromComponents(y);
+      return true;
+    }
+};
+
+template <typename _Component>
+class ImagePixelConvertionImpl<ImagePixel<BaseImagePixel::PixelYUV422, _Component>, ImagePixel<BaseImagePixel::PixelGRAY8, _Component>, false>
+{
+  public:
+    static bool convert(const ImagePixel<BaseImagePixel::PixelYUV422, _Component>& _p1, ImagePixel<BaseImagePixel::PixelGRAY8, _Component>& _p2)
+    {
+      typename _Component::Value y;
+      typename _Component::Value u;
+      typename _Component::Value v;
+
+      _p1.toComponents(y, u, v);
+      _p2.fromComponents(y);
+      return true;
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_PIXEL_GRAY_HPP_
@@ -18,32 +18,60 @@
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
 
 
-template <size_t _RBits, size_t _GBits, size_t _BBits>
-class ImagePixelRGBAccessor : protected BaseImagePixelAccessor,
-                              private assert_inst<(_RBits>=1 && _GBits>=1 && _BBits>=1)>
+template <size_t _RBits, size_t _GBits, size_t _BBits, typename _Component>
+class ImagePixelRGBAccessor : private assert_inst<(_RBits>=1 && _GBits>=1 && _BBits>=1)>
 {
   public:
+    static const size_t s_rBits = _RBits;
+    static const size_t s_gBits = _GBits;
+    static const size_t s_bBits = _BBits;
+
     bool toNormalizedRGB(float& _nr, float& _ng, float& _nb) const
     {
-      _nr = range(0.0f, m_r / rMax(), 1.0f);
-      _ng = range(0.0f, m_g / gMax(), 1.0f);
-      _nb = range(0.0f, m_b / bMax(), 1.0f);
+      _nr = range(0.0f, _Component::normalize(m_r, rMax()), 1.0f);
+      _ng = range(0.0f, _Component::normalize(m_g, gMax()), 1.0f);
+      _nb = range(0.0f, _Component::normalize(m_b, bMax()), 1.0f);
       return true;
     }
 
     bool fromNormalizedRGB(const float& _nr, const float& _ng, const float& _nb)
     {
-      m_r = _nr * rMax();
-      m_g = _ng * gMax();
-      m_b = _nb * bMax();
+      m_r = _Component::denormalize(_nr, rMax());
+      m_g = _Component::denormalize(_ng, gMax());
+      m_b = _Component::denormalize(_nb, bMax());
       return true;
     }
 
+    void toComponents(typename _Component::Value& _r, typename _Component::Value& _g, typename _Component::Value& _b) const
+    {
+      _r = m_r;
+      _g = m_g;
+      _b = m_b;
+    }
+
+    void fromComponents(const typename _Component::Value& _r, const typename _Component::Value& _g, const typename _Component::Value& _b)
+    {
+      m_r = _r;
+      m_g = _g;
+      m_b = _b;
+    }
+
+    // channels already in _RBits, _GBits, _BBits range, see ImagePixelYUV2RGBTables
+    void loadRGB(unsigned _r, unsigned _g, unsigned _b)
+    {
+      loadR(_r);
+      loadG(_g);
+      loadB(_b);
+    }
+
   protected:
+    typedef typename _Component::Value  Value;
+    typedef typename _Component::Weight Weight;
+
     ImagePixelRGBAccessor()
-     :m_r(0.0),
-      m_g(0.0),
-      m_b(0.0)
+     :m_r(),
+      m_g(),
+      m_b()
     {
     }
 
@@ -56,39 +84,39 @@ class ImagePixelRGBAccessor : protected BaseImagePixelAccessor,
 
     void loadR(unsigned _r)
     {
-      m_r = _r;
+      m_r = _Component::load(_r);
     }
 
     void loadG(unsigned _g)
     {
-      m_g = _g;
+      m_g = _Component::load(_g);
     }
 
     void loadB(unsigned _b)
     {
-      m_b = _b;
+      m_b = _Component::load(_b);
     }
 
     unsigned storeR() const
     {
-      return roundf(range(0.0f, m_r, rMax()));
+      return _Component::store(m_r, rMax());
     }
 
     unsigned storeG() const
     {
-      return roundf(range(0.0f, m_g, gMax()));
+      return _Component::store(m_g, gMax());
     }
 
     unsigned storeB() const
     {
-      return roundf(range(0.0f, m_b, bMax()));
+      return _Component::store(m_b, bMax());
     }
 
-    void operatorMultiplyImpl(const float& _f)
+    void operatorMultiplyImpl(const Weight& _w)
     {
-      m_r *= _f;
-      m_g *= _f;
-      m_b *= _f;
+      m_r = _Component::multiply(m_r, _w);
+      m_g = _Component::multiply(m_g, _w);
+      m_b = _Component::multiply(m_b, _w);
     }
 
     void operatorIncrementImpl(const ImagePixelRGBAccessor& _p)
@@ -98,6 +126,20 @@ class ImagePixelRGBAccessor : protected BaseImagePixelAccessor,
       m_b += _p.m_b;
     }
 
+    void operatorAccumulateImpl(const ImagePixelRGBAccessor& _p, const Weight& _w)
+    {
+      m_r += _Component::product(_p.m_r, _w);
+      m_g += _Component::product(_p.m_g, _w);
+      m_b += _Component::product(_p.m_b, _w);
+    }
+
+    void operatorReduceImpl()
+    {
+      m_r = _Component::reduce(m_r);
+      m_g = _Component::reduce(m_g);
+      m_b = _Component::reduce(m_b);
+    }
+
     void operatorExtractImpl(std::ostream& _os) const
     {
       float nr;
@@ -109,13 +151,13 @@ class ImagePixelRGBAccessor : protected BaseImagePixelAccessor,
     }
 
   private:
-    float m_r;
-    float m_g;
-    float m_b;
+    Value m_r;
+    Value m_g;
+    Value m_b;
 
-    static float rMax() { return (1u<<_RBits) - 1; }
-    static float gMax() { return (1u<<_GBits) - 1; }
-    static float bMax() { return (1u<<_BBits) - 1; }
+    static unsigned rMax() { return (1u<<_RBits) - 1; }
+    static unsigned gMax() { return (1u<<_GBits) - 1; }
+    static unsigned bMax() { return (1u<<_BBits) - 1; }
     static float range(float _min, float _val, float _max) { return std::min(_max, std::max(_min, _val)); }
 };
 
@@ -125,9 +167,10 @@ class ImagePixelRGBAccessor : protected BaseImagePixelAccessor,
 
 
 
-template <>
-class ImagePixel<BaseImagePixel::PixelRGB565> : public BaseImagePixel,
-                                                public internal::ImagePixelRGBAccessor<5, 6, 5>
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelRGB565, _Component> : public BaseImagePixel,
+                                                            private internal::BaseImagePixelAccessor,
+                                                            public internal::ImagePixelRGBAccessor<5, 6, 5, _Component>
 {
   public:
     ImagePixel() {}
@@ -135,36 +178,47 @@ class ImagePixel<BaseImagePixel::PixelRGB565> : public BaseImagePixel,
     template <typename UByte>
     bool unpack(const UByte& _b1, const UByte& _b2)
     {
-      loadR(  utypeGet<UByte,  true>(_b1, 5, 3));
-      loadG(  utypeGet<UByte, false>(_b1, 3, 3)
+      this->loadR(  utypeGet<UByte,  true>(_b1, 5, 3));
+      this->loadG(  utypeGet<UByte, false>(_b1, 3, 3)
             | utypeGet<UByte,  true>(_b2, 3, 5));
-      loadB(  utypeGet<UByte,  true>(_b2, 5, 0));
+      this->loadB(  utypeGet<UByte,  true>(_b2, 5, 0));
       return true;
     }
 
     template <typename UByte>
     bool pack(UByte& _b1, UByte& _b2) const
     {
-      _b1 = utypeValue<UByte,  true>(storeR(), 5, 3)
-          | utypeValue<UByte, false>(storeG(), 3, 3);
-      _b2 = utypeValue<UByte,  true>(storeG(), 3, 5)
-          | utypeValue<UByte,  true>(storeB(), 5, 0);
+      _b1 = utypeValue<UByte,  true>(this->storeR(), 5, 3)
+          | utypeValue<UByte, false>(this->storeG(), 3, 3);
+      _b2 = utypeValue<UByte,  true>(this->storeG(), 3, 5)
+          | utypeValue<UByte,  true>(this->storeB(), 5, 0);
       return true;
     }
 
-    ImagePixel operator*(const float& _f) const
+    ImagePixel operator*(const typename _Component::Weight& _w) const
     {
       ImagePixel p(*this);
-      p.operatorMultiplyImpl(_f);
+      p.operatorMultiplyImpl(_w);
       return p;
     }
 
     ImagePixel& operator+=(const ImagePixel& _p)
     {
-      operatorIncrementImpl(_p);
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
       return *this;
     }
 
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
   private:
     friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
     {
@@ -176,9 +230,10 @@ class ImagePixel<BaseImagePixel::PixelRGB565> : public BaseImagePixel,
 
 
 
-template <>
-class ImagePixel<BaseImagePixel::PixelRGB565X> : public BaseImagePixel,
-                                                 public internal::ImagePixelRGBAccessor<5, 6, 5>
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelRGB565X, _Component> : public BaseImagePixel,
+                                                             private internal::BaseImagePixelAccessor,
+                                                             public internal::ImagePixelRGBAccessor<5, 6, 5, _Component>
 {
   public:
     ImagePixel() {}
@@ -186,36 +241,47 @@ class ImagePixel<BaseImagePixel::PixelRGB565X> : public BaseImagePixel,
     template <typename UByte>
     bool unpack(const UByte& _b1, const UByte& _b2)
     {
-      loadR(  utypeGet<UByte,  true>(_b1, 5, 0));
-      loadG(  utypeGet<UByte,  true>(_b1, 3, 5)
+      this->loadR(  utypeGet<UByte,  true>(_b1, 5, 0));
+      this->loadG(  utypeGet<UByte,  true>(_b1, 3, 5)
             | utypeGet<UByte, false>(_b2, 3, 3));
-      loadB(  utypeGet<UByte,  true>(_b2, 5, 3));
+      this->loadB(  utypeGet<UByte,  true>(_b2, 5, 3));
       return true;
     }
 
     template <typename UByte>
     bool pack(UByte& _b1, UByte& _b2) const
     {
-      _b1 = utypeValue<UByte,  true>(storeR(), 5, 0)
-          | utypeValue<UByte,  true>(storeG(), 3, 5);
-      _b2 = utypeValue<UByte, false>(storeG(), 3, 3)
-          | utypeValue<UByte,  true>(storeB(), 5, 3);
+      _b1 = utypeValue<UByte,  true>(this->storeR(), 5, 0)
+          | utypeValue<UByte,  true>(this->storeG(), 3, 5);
+      _b2 = utypeValue<UByte, false>(this->storeG(), 3, 3)
+          | utypeValue<UByte,  true>(this->storeB(), 5, 3);
       return true;
     }
 
-    ImagePixel operator*(const float& _f) const
+    ImagePixel operator*(const typename _Component::Weight& _w) const
     {
       ImagePixel p(*this);
-      p.operatorMultiplyImpl(_f);
+      p.operatorMultiplyImpl(_w);
       return p;
     }
 
     ImagePixel& operator+=(const ImagePixel& _p)
     {
-      operatorIncrementImpl(_p);
+      this->operatorIncrementImpl(_p);
       return *this;
     }
 
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
   private:
     friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
     {
@@ -225,9 +291,10 @@ class ImagePixel<BaseImagePixel::PixelRGB565X> : public BaseImagePixel,
 };
 
 
-template <>
-class ImagePixel<BaseImagePixel::PixelRGB888> : public BaseImagePixel,
-                                                public internal::ImagePixelRGBAccessor<8, 8, 8>
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelRGB888, _Component> : public BaseImagePixel,
+                                                            private internal::BaseImagePixelAccessor,
+                                                            public internal::ImagePixelRGBAccessor<8, 8, 8, _Component>
 {
   public:
     ImagePixel() {}
@@ -235,9 +302,9 @@ class ImagePixel<BaseImagePixel::PixelRGB888> : public BaseImagePixel,
     template <typename UByte>
     bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3)
     {
-      loadR(utypeGet<UByte, true>(_b1, 8, 0));
-      loadG(utypeGet<UByte, true>(_b2, 8, 0));
-      loadB(utypeGet<UByte, true>(_b3, 8, 0));
+      this->loadR(utypeGet<UByte, true>(_b1, 8, 0));
+      this->loadG(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadB(utypeGet<UByte, true>(_b3, 8, 0));
 
       return true;
     }
@@ -245,26 +312,229 @@ class ImagePixel<BaseImagePixel::PixelRGB888> : public BaseImagePixel,
     template <typename UByte>
     bool pack(UByte& _b1, UByte& _b2, UByte& _b3) const
     {
-      _b1 = utypeValue<UByte, true>(storeR(), 8, 0);
-      _b2 = utypeValue<UByte, true>(storeG(), 8, 0);
-      _b3 = utypeValue<UByte, true>(storeB(), 8, 0);
+      _b1 = utypeValue<UByte, true>(this->storeR(), 8, 0);
+      _b2 = utypeValue<UByte, true>(this->storeG(), 8, 0);
+      _b3 = utypeValue<UByte, true>(this->storeB(), 8, 0);
+
+      return true;
+    }
+
+    ImagePixel operator*(const typename _Component::Weight& _w) const
+    {
+      ImagePixel p(*this);
+      p.operatorMultiplyImpl(_w);
+      return p;
+    }
+
+    ImagePixel& operator+=(const ImagePixel& _p)
+    {
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
+  private:
+    friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
+    {
+      _p.operatorExtractImpl(_os);
+      return _os;
+    }
+};
+
+
+// 32 bit pixel, bytes in memory are R, G, B, A; alpha is written opaque
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelRGBA8888, _Component> : public BaseImagePixel,
+                                                              private internal::BaseImagePixelAccessor,
+                                                              public internal::ImagePixelRGBAccessor<8, 8, 8, _Component>
+{
+  public:
+    ImagePixel() {}
+
+    template <typename UByte>
+    bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3, const UByte& _b4)
+    {
+      (void)_b4;
+      this->loadR(utypeGet<UByte, true>(_b1, 8, 0));
+      this->loadG(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadB(utypeGet<UByte, true>(_b3, 8, 0));
+
+      return true;
+    }
+
+    template <typename UByte>
+    bool pack(UByte& _b1, UByte& _b2, UByte& _b3, UByte& _b4) const
+    {
+      _b1 = utypeValue<UByte, true>(this->storeR(), 8, 0);
+      _b2 = utypeValue<UByte, true>(this->storeG(), 8, 0);
+      _b3 = utypeValue<UByte, true>(this->storeB(), 8, 0);
+      _b4 = 0xff;
+
+      return true;
+    }
+
+    ImagePixel operator*(const typename _Component::Weight& _w) const
+    {
+      ImagePixel p(*this);
+      p.operatorMultiplyImpl(_w);
+      return p;
+    }
+
+    ImagePixel& operator+=(const ImagePixel& _p)
+    {
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
+  private:
+    friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
+    {
+      _p.operatorExtractImpl(_os);
+      return _os;
+    }
+};
+
+
+// 32 bit pixel, bytes in memory are B, G, R, A, as little-endian XRGB word of Linux framebuffer
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelBGRA8888, _Component> : public BaseImagePixel,
+                                                              private internal::BaseImagePixelAccessor,
+                                                              public internal::ImagePixelRGBAccessor<8, 8, 8, _Component>
+{
+  public:
+    ImagePixel() {}
+
+    template <typename UByte>
+    bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3, const UByte& _b4)
+    {
+      (void)_b4;
+      this->loadB(utypeGet<UByte, true>(_b1, 8, 0));
+      this->loadG(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadR(utypeGet<UByte, true>(_b3, 8, 0));
 
       return true;
     }
 
-    ImagePixel operator*(const float& _f) const
+    template <typename UByte>
+    bool pack(UByte& _b1, UByte& _b2, UByte& _b3, UByte& _b4) const
+    {
+      _b1 = utypeValue<UByte, true>(this->storeB(), 8, 0);
+      _b2 = utypeValue<UByte, true>(this->storeG(), 8, 0);
+      _b3 = utypeValue<UByte, true>(this->storeR(), 8, 0);
+      _b4 = 0xff;
+
+      return true;
+    }
+
+    ImagePixel operator*(const typename _Component::Weight& _w) const
     {
       ImagePixel p(*this);
-      p.operatorMultiplyImpl(_f);
+      p.operatorMultiplyImpl(_w);
       return p;
     }
 
     ImagePixel& operator+=(const ImagePixel& _p)
     {
-      operatorIncrementImpl(_p);
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
       return *this;
     }
 
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
+  private:
+    friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
+    {
+      _p.operatorExtractImpl(_os);
+      return _os;
+    }
+};
+
+
+// 32 bit pixel, bytes in memory are X, R, G, B; padding byte is written zero
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelXRGB8888, _Component> : public BaseImagePixel,
+                                                              private internal::BaseImagePixelAccessor,
+                                                              public internal::ImagePixelRGBAccessor<8, 8, 8, _Component>
+{
+  public:
+    ImagePixel() {}
+
+    template <typename UByte>
+    bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3, const UByte& _b4)
+    {
+      (void)_b1;
+      this->loadR(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadG(utypeGet<UByte, true>(_b3, 8, 0));
+      this->loadB(utypeGet<UByte, true>(_b4, 8, 0));
+
+      return true;
+    }
+
+    template <typename UByte>
+    bool pack(UByte& _b1, UByte& _b2, UByte& _b3, UByte& _b4) const
+    {
+      _b1 = 0;
+      _b2 = utypeValue<UByte, true>(this->storeR(), 8, 0);
+      _b3 = utypeValue<UByte, true>(this->storeG(), 8, 0);
+      _b4 = utypeValue<UByte, true>(this->storeB(), 8, 0);
+
+      return true;
+    }
+
+    ImagePixel operator*(const typename _Component::Weight& _w) const
+    {
+      ImagePixel p(*this);
+      p.operatorMultiplyImpl(_w);
+      return p;
+    }
+
+    ImagePixel& operator+=(const ImagePixel& _p)
+    {
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
   private:
     friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
     {
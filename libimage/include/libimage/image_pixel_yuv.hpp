@@ -18,16 +18,15 @@
 /* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
 
 
-template <size_t _YBits, size_t _UBits, size_t _VBits>
-class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
-                              private assert_inst<(_YBits>=1 && _UBits>=1 && _VBits>=1)>
+template <size_t _YBits, size_t _UBits, size_t _VBits, typename _Component>
+class ImagePixelYUVAccessor : private assert_inst<(_YBits>=1 && _UBits>=1 && _VBits>=1)>
 {
   public:
     bool toNormalizedRGB(float& _nr, float& _ng, float& _nb) const
     {
-      const float y = m_y/yMax();
-      const float u = m_u/uMax() - 0.5;
-      const float v = m_v/uMax() - 0.5;
+      const float y = _Component::normalize(m_y, yMax());
+      const float u = _Component::normalize(m_u, uMax()) - 0.5;
+      const float v = _Component::normalize(m_v, uMax()) - 0.5;
 
       _nr = range(0.0f, ( y +  0        +  1.4075*v), 1.0f);
       _ng = range(0.0f, ( y + -0.3455*u + -0.7169*v), 1.0f);
@@ -37,17 +36,43 @@ class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
 
     bool fromNormalizedRGB(const float& _nr, const float& _ng, const float& _nb)
     {
-      m_y =  ( 0.2990*_nr +  0.5870*_ng +  0.1140*_nb) * yMax();
-      m_u = ((-0.1687*_nr + -0.3312*_ng +  0.5000*_nb) + 0.5) * uMax();
-      m_v = (( 0.5000*_nr + -0.4186*_ng + -0.0813*_nb) + 0.5) * vMax();
+      m_y = _Component::denormalize( ( 0.2990*_nr +  0.5870*_ng +  0.1140*_nb),        yMax());
+      m_u = _Component::denormalize(((-0.1687*_nr + -0.3312*_ng +  0.5000*_nb) + 0.5), uMax());
+      m_v = _Component::denormalize((( 0.5000*_nr + -0.4186*_ng + -0.0813*_nb) + 0.5), vMax());
       return true;
     }
 
+    // components as interpolation holds them, for planes filtered separately
+    void toComponents(typename _Component::Value& _y, typename _Component::Value& _u, typename _Component::Value& _v) const
+    {
+      _y = m_y;
+      _u = m_u;
+      _v = m_v;
+    }
+
+    void fromComponents(const typename _Component::Value& _y, const typename _Component::Value& _u, const typename _Component::Value& _v)
+    {
+      m_y = _y;
+      m_u = _u;
+      m_v = _v;
+    }
+
+    // components in Q_fractBits, rounded but not saturated, overshoot of interpolation is kept; see ImagePixelYUV2RGBTables
+    void storeYUV(int32_t& _y, int32_t& _u, int32_t& _v, size_t _fractBits) const
+    {
+      _y = _Component::round(m_y, _fractBits);
+      _u = _Component::round(m_u, _fractBits);
+      _v = _Component::round(m_v, _fractBits);
+    }
+
   protected:
+    typedef typename _Component::Value  Value;
+    typedef typename _Component::Weight Weight;
+
     ImagePixelYUVAccessor()
-     :m_y(0.0),
-      m_u(0.0),
-      m_v(0.0)
+     :m_y(),
+      m_u(),
+      m_v()
     {
     }
 
@@ -60,39 +85,39 @@ class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
 
     void loadY(unsigned _y)
     {
-      m_y = _y;
+      m_y = _Component::load(_y);
     }
 
     void loadU(unsigned _u)
     {
-      m_u = _u;
+      m_u = _Component::load(_u);
     }
 
     void loadV(unsigned _v)
     {
-      m_v = _v;
+      m_v = _Component::load(_v);
     }
 
     unsigned storeY() const
     {
-      return roundf(range(0.0f, m_y, yMax()));
+      return _Component::store(m_y, yMax());
     }
 
     unsigned storeU() const
     {
-      return roundf(range(0.0f, m_u, uMax()));
+      return _Component::store(m_u, uMax());
     }
 
     unsigned storeV() const
     {
-      return roundf(range(0.0f, m_v, vMax()));
+      return _Component::store(m_v, vMax());
     }
 
-    void operatorMultiplyImpl(const float& _f)
+    void operatorMultiplyImpl(const Weight& _w)
     {
-      m_y *= _f;
-      m_u *= _f;
-      m_v *= _f;
+      m_y = _Component::multiply(m_y, _w);
+      m_u = _Component::multiply(m_u, _w);
+      m_v = _Component::multiply(m_v, _w);
     }
 
     void operatorIncrementImpl(const ImagePixelYUVAccessor& _p)
@@ -102,6 +127,20 @@ class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
       m_v += _p.m_v;
     }
 
+    void operatorAccumulateImpl(const ImagePixelYUVAccessor& _p, const Weight& _w)
+    {
+      m_y += _Component::product(_p.m_y, _w);
+      m_u += _Component::product(_p.m_u, _w);
+      m_v += _Component::product(_p.m_v, _w);
+    }
+
+    void operatorReduceImpl()
+    {
+      m_y = _Component::reduce(m_y);
+      m_u = _Component::reduce(m_u);
+      m_v = _Component::reduce(m_v);
+    }
+
     void operatorExtractImpl(std::ostream& _os) const
     {
       float nr;
@@ -113,13 +152,13 @@ class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
     }
 
   private:
-    float m_y;
-    float m_u;
-    float m_v;
+    Value m_y;
+    Value m_u;
+    Value m_v;
 
-    static float yMax() { return (1u<<_YBits) - 1; }
-    static float uMax() { return (1u<<_UBits) - 1; }
-    static float vMax() { return (1u<<_VBits) - 1; }
+    static unsigned yMax() { return (1u<<_YBits) - 1; }
+    static unsigned uMax() { return (1u<<_UBits) - 1; }
+    static unsigned vMax() { return (1u<<_VBits) - 1; }
     static float range(float _min, float _val, float _max) { return std::min(_max, std::max(_min, _val)); }
 };
 
@@ -129,9 +168,10 @@ class ImagePixelYUVAccessor : protected BaseImagePixelAccessor,
 
 
 
-template <>
-class ImagePixel<BaseImagePixel::PixelYUV444> : public BaseImagePixel,
-                                                public internal::ImagePixelYUVAccessor<8, 8, 8>
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelYUV444, _Component> : public BaseImagePixel,
+                                                            private internal::BaseImagePixelAccessor,
+                                                            public internal::ImagePixelYUVAccessor<8, 8, 8, _Component>
 {
   public:
     ImagePixel() {}
@@ -140,9 +180,9 @@ class ImagePixel<BaseImagePixel::PixelYUV444> : public BaseImagePixel,
     bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3, const UByte& _b4)
     {
       (void)_b1;
-      loadY(utypeGet<UByte, true>(_b2, 8, 0));
-      loadU(utypeGet<UByte, true>(_b3, 8, 0));
-      loadV(utypeGet<UByte, true>(_b4, 8, 0));
+      this->loadY(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadU(utypeGet<UByte, true>(_b3, 8, 0));
+      this->loadV(utypeGet<UByte, true>(_b4, 8, 0));
 
       return true;
     }
@@ -151,26 +191,37 @@ class ImagePixel<BaseImagePixel::PixelYUV444> : public BaseImagePixel,
     bool pack(UByte& _b1, UByte& _b2, UByte& _b3, UByte& _b4) const
     {
       _b1 = 0;
-      _b2 = utypeValue<UByte, true>(storeY(), 8, 0);
-      _b3 = utypeValue<UByte, true>(storeU(), 8, 0);
-      _b4 = utypeValue<UByte, true>(storeV(), 8, 0);
+      _b2 = utypeValue<UByte, true>(this->storeY(), 8, 0);
+      _b3 = utypeValue<UByte, true>(this->storeU(), 8, 0);
+      _b4 = utypeValue<UByte, true>(this->storeV(), 8, 0);
 
       return true;
     }
 
-    ImagePixel operator*(const float& _f) const
+    ImagePixel operator*(const typename _Component::Weight& _w) const
     {
       ImagePixel p(*this);
-      p.operatorMultiplyImpl(_f);
+      p.operatorMultiplyImpl(_w);
       return p;
     }
 
     ImagePixel& operator+=(const ImagePixel& _p)
     {
-      operatorIncrementImpl(_p);
+      this->operatorIncrementImpl(_p);
+      return *this;
+    }
+
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
       return *this;
     }
 
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
   private:
     friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
     {
@@ -182,9 +233,10 @@ class ImagePixel<BaseImagePixel::PixelYUV444> : public BaseImagePixel,
 
 
 
-template <>
-class ImagePixel<BaseImagePixel::PixelYUV422> : public BaseImagePixel,
-                                                public internal::ImagePixelYUVAccessor<8, 8, 8>
+template <typename _Component>
+class ImagePixel<BaseImagePixel::PixelYUV422, _Component> : public BaseImagePixel,
+                                                            private internal::BaseImagePixelAccessor,
+                                                            public internal::ImagePixelYUVAccessor<8, 8, 8, _Component>
 {
   public:
     ImagePixel() {}
@@ -192,9 +244,9 @@ class ImagePixel<BaseImagePixel::PixelYUV422> : public BaseImagePixel,
     template <typename UByte>
     bool unpack(const UByte& _b1, const UByte& _b2, const UByte& _b3)
     {
-      loadY(utypeGet<UByte, true>(_b1, 8, 0));
-      loadU(utypeGet<UByte, true>(_b2, 8, 0));
-      loadV(utypeGet<UByte, true>(_b3, 8, 0));
+      this->loadY(utypeGet<UByte, true>(_b1, 8, 0));
+      this->loadU(utypeGet<UByte, true>(_b2, 8, 0));
+      this->loadV(utypeGet<UByte, true>(_b3, 8, 0));
 
       return true;
     }
@@ -202,34 +254,45 @@ class ImagePixel<BaseImagePixel::PixelYUV422> : public BaseImagePixel,
     template <typename UByte>
     bool pack(UByte& _b1, UByte& _b2, UByte& _b3, bool _inc) const
     {
-      _b1 = utypeValue<UByte, true>(storeY(), 8, 0);
+      _b1 = utypeValue<UByte, true>(this->storeY(), 8, 0);
       if (_inc)
       {
-        _b2 += utypeValue<UByte, true>(storeU(), 8, 0) / 2;
-        _b3 += utypeValue<UByte, true>(storeV(), 8, 0) / 2;
+        _b2 += utypeValue<UByte, true>(this->storeU(), 8, 0) / 2;
+        _b3 += utypeValue<UByte, true>(this->storeV(), 8, 0) / 2;
       }
       else
       {
-        _b2 = utypeValue<UByte, true>(storeU(), 8, 0) / 2;
-        _b3 = utypeValue<UByte, true>(storeV(), 8, 0) / 2;
+        _b2 = utypeValue<UByte, true>(this->storeU(), 8, 0) / 2;
+        _b3 = utypeValue<UByte, true>(this->storeV(), 8, 0) / 2;
       }
 
       return true;
     }
 
-    ImagePixel operator*(const float& _f) const
+    ImagePixel operator*(const typename _Component::Weight& _w) const
     {
       ImagePixel p(*this);
-      p.operatorMultiplyImpl(_f);
+      p.operatorMultiplyImpl(_w);
       return p;
     }
 
     ImagePixel& operator+=(const ImagePixel& _p)
     {
-      operatorIncrementImpl(_p);
+      this->operatorIncrementImpl(_p);
       return *this;
     }
 
+    ImagePixel& accumulate(const ImagePixel& _p, const typename _Component::Weight& _w)
+    {
+      this->operatorAccumulateImpl(_p, _w);
+      return *this;
+    }
+
+    void reduce()
+    {
+      this->operatorReduceImpl();
+    }
+
   private:
     friend std::ostream& operator<<(std::ostream& _os, const ImagePixel& _p)
     {
@@ -241,6 +304,120 @@ class ImagePixel<BaseImagePixel::PixelYUV422> : public BaseImagePixel,
 
 
 
+/* **** **** **** **** **** */ namespace internal /* **** **** **** **** **** */ {
+
+
+/*
+ * 8 bit YUV to RGB with given channel widths, same coefficients as toNormalizedRGB().
+ * Chroma contributions are tabulated in output channel units, Q16, over 8 bit range widened by half
+ * on both sides to cover interpolation overshoot; luma is single multiplier.
+ * Components come in half units: whole units cost interpolated U up to 0.9 LSB of 8 bit B before the
+ * final rounding, half units keep table path within 1 LSB of float one.
+ * Sum is saturated to channel range and rounded. Tables are built once per RGB format.
+ */
+template <size_t _RBits, size_t _GBits, size_t _BBits>
+class ImagePixelYUV2RGBTables : private noncopyable
+{
+  public:
+    static const ImagePixelYUV2RGBTables& instance()
+    {
+      static const ImagePixelYUV2RGBTables s_tables;
+      return s_tables;
+    }
+
+    static const size_t s_indexFractBits = 1;
+
+    // components in Q_indexFractBits, see ImagePixelYUVAccessor::storeYUV()
+    void convert(int32_t _y, int32_t _u, int32_t _v, unsigned& _r, unsigned& _g, unsigned& _b) const
+    {
+      // std::min/max take references, local copies keep in-class constants from being odr-used
+      const int32_t chromaMin = s_chromaMin * (1 << s_indexFractBits);
+      const int32_t chromaMax = s_chromaMax * (1 << s_indexFractBits);
+      const size_t u = std::min(chromaMax, std::max(chromaMin, _u)) - chromaMin;
+      const size_t v = std::min(chromaMax, std::max(chromaMin, _v)) - chromaMin;
+
+      _r = channel(_y*m_yR + m_vR[v],            rMax());
+      _g = channel(_y*m_yG + m_uG[u] + m_vG[v], gMax());
+      _b = channel(_y*m_yB + m_uB[u],            bMax());
+    }
+
+  private:
+    static const size_t  s_fractBits = 16;
+    static const int32_t s_chromaMin = -128;
+    static const int32_t s_chromaMax = 383;
+    static const size_t  s_chromaCount = ((s_chromaMax - s_chromaMin) << s_indexFractBits) + 1;
+
+    int32_t m_yR;
+    int32_t m_yG;
+    int32_t m_yB;
+    int32_t m_vR[s_chromaCount];
+    int32_t m_uG[s_chromaCount];
+    int32_t m_vG[s_chromaCount];
+    int32_t m_uB[s_chromaCount];
+
+    ImagePixelYUV2RGBTables()
+     :m_yR(fixed(indexStep()/255.0f, rMax())),
+      m_yG(fixed(indexStep()/255.0f, gMax())),
+      m_yB(fixed(indexStep()/255.0f, bMax()))
+    {
+      for (size_t idx = 0; idx < s_chromaCount; ++idx)
+      {
+        const float c = (static_cast<float>(idx)*indexStep() + s_chromaMin)/255.0f - 0.5f;
+        m_vR[idx] = fixed( 1.4075f*c, rMax());
+        m_uG[idx] = fixed(-0.3455f*c, gMax());
+        m_vG[idx] = fixed(-0.7169f*c, gMax());
+        m_uB[idx] = fixed( 1.7790f*c, bMax());
+      }
+    }
+
+    static unsigned rMax() { return (1u<<_RBits) - 1; }
+    static unsigned gMax() { return (1u<<_GBits) - 1; }
+    static unsigned bMax() { return (1u<<_BBits) - 1; }
+    static float indexStep() { return 1.0f / (1u << s_indexFractBits); }
+
+    static int32_t fixed(float _normalized, unsigned _max)
+    {
+      return floorf(_normalized * static_cast<float>(_max) * (1u << s_fractBits) + 0.5f);
+    }
+
+    static unsigned channel(int32_t _value, unsigned _max)
+    {
+      if (_value <= 0)
+        return 0;
+      if (_value >= static_cast<int32_t>(_max << s_fractBits))
+        return _max;
+      return (_value + (1 << (s_fractBits-1))) >> s_fractBits;
+    }
+};
+
+
+template <typename _PixelType1, typename _PixelType2>
+class ImagePixelConvertionImpl<_PixelType1, _PixelType2, true>
+{
+  public:
+    static bool convert(const _PixelType1& _p1, _PixelType2& _p2)
+    {
+      typedef ImagePixelYUV2RGBTables<_PixelType2::s_rBits, _PixelType2::s_gBits, _PixelType2::s_bBits> Tables;
+
+      int32_t y;
+      int32_t u;
+      int32_t v;
+      _p1.storeYUV(y, u, v, Tables::s_indexFractBits);
+
+      unsigned r;
+      unsigned g;
+      unsigned b;
+      Tables::instance().convert(y, u, v, r, g, b);
+
+      _p2.loadRGB(r, g, b);
+      return true;
+    }
+};
+
+
+} /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
+
+
 } /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
 } /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
 
@@ -0,0 +1,250 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_PLANAR_HPP_
+#define TRIK_LIBIMAGE_IMAGE_PLANAR_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <libimage/stdcpp.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+
+
+/*
+ * Single 8-bit channel of planar image: width x height samples, step bytes apart within row.
+ * Semi-planar chroma is two channels interleaved in one plane, each of them has step 2.
+ */
+template <typename _UByteCV>
+class ImagePlane
+{
+  public:
+    typedef _UByteCV UByteCV;
+
+    ImagePlane()
+     :m_ptr(NULL),
+      m_width(0),
+      m_height(0),
+      m_lineLength(0),
+      m_step(1)
+    {
+    }
+
+    ImagePlane(_UByteCV* _ptr, size_t _width, size_t _height, size_t _lineLength, size_t _step)
+     :m_ptr(_ptr),
+      m_width(_width),
+      m_height(_height),
+      m_lineLength(_lineLength),
+      m_step(_step)
+    {
+    }
+
+    const size_t& width() const
+    {
+      return m_width;
+    }
+
+    const size_t& height() const
+    {
+      return m_height;
+    }
+
+    const size_t& lineLength() const
+    {
+      return m_lineLength;
+    }
+
+    const size_t& step() const
+    {
+      return m_step;
+    }
+
+    // not checked, plane bounds are checked once by ImagePlanar::isValid()
+    _UByteCV* row(size_t _rowIndex) const
+    {
+      return m_ptr + _rowIndex*m_lineLength;
+    }
+
+    unsigned sample(const _UByteCV* _row, size_t _column) const
+    {
+      return _row[_column*m_step];
+    }
+
+  private:
+    _UByteCV* m_ptr;
+    size_t    m_width;
+    size_t    m_height;
+    size_t    m_lineLength;
+    size_t    m_step;
+};
+
+
+
+
+class BaseImagePlanar
+{
+  public:
+    enum PlanarType
+    {
+      PlanarNV12, // Y plane, then interleaved U,V plane at half width and half height
+      PlanarNV21, // as NV12 with V,U order
+      PlanarI420  // Y plane, then U and V planes at half width, height and line length
+    };
+
+    enum PlaneIndex
+    {
+      PlaneY,
+      PlaneU,
+      PlaneV,
+      PlanesCount
+    };
+
+    // chroma of odd width or height covers last luma sample alone
+    static size_t chromaSize(size_t _size)
+    {
+      return (_size + 1) / 2;
+    }
+
+  protected:
+    BaseImagePlanar() {}
+};
+
+
+
+
+/*
+ * Planar YUV 4:2:0 image in single buffer, given line length is of Y plane
+ */
+template <BaseImagePlanar::PlanarType _PT, typename _UByteCV>
+class ImagePlanar : public BaseImagePlanar
+{
+  public:
+    static const BaseImagePlanar::PlanarType PT = _PT;
+    typedef _UByteCV              UByteCV;
+    typedef ImagePlane<_UByteCV>  Plane;
+
+    ImagePlanar()
+     :BaseImagePlanar(),
+      m_ptr(NULL),
+      m_imageSize(0),
+      m_width(0),
+      m_height(0),
+      m_lineLength(0),
+      m_planes()
+    {
+    }
+
+    ImagePlanar(_UByteCV*	_imagePtr,
+                size_t		_imageSize,
+                size_t		_width,
+                size_t		_height,
+                size_t		_lineLength)
+     :BaseImagePlanar(),
+      m_ptr(_imagePtr),
+      m_imageSize(_imageSize),
+      m_width(_width),
+      m_height(_height),
+      m_lineLength(fixupLineLength(_width, _lineLength)),
+      m_planes()
+    {
+      const size_t chromaWidth  = chromaSize(m_width);
+      const size_t chromaHeight = chromaSize(m_height);
+      _UByteCV* const chromaPtr = m_ptr == NULL ? NULL : m_ptr + m_height*m_lineLength;
+
+      m_planes[PlaneY] = Plane(m_ptr, m_width, m_height, m_lineLength, 1);
+      if (_PT == PlanarI420)
+      {
+        const size_t chromaLineLength = chromaLineLengthI420(m_lineLength);
+        m_planes[PlaneU] = Plane(chromaPtr, chromaWidth, chromaHeight, chromaLineLength, 1);
+        m_planes[PlaneV] = Plane(chromaPtr == NULL ? NULL : chromaPtr + chromaHeight*chromaLineLength,
+                                 chromaWidth, chromaHeight, chromaLineLength, 1);
+      }
+      else
+      {
+        const size_t ofsU = _PT == PlanarNV12 ? 0 : 1;
+        m_planes[PlaneU] = Plane(chromaPtr == NULL ? NULL : chromaPtr + ofsU,   chromaWidth, chromaHeight, m_lineLength, 2);
+        m_planes[PlaneV] = Plane(chromaPtr == NULL ? NULL : chromaPtr + 1-ofsU, chromaWidth, chromaHeight, m_lineLength, 2);
+      }
+    }
+
+    bool isValid() const
+    {
+      const size_t chromaRowLength = _PT == PlanarI420 ? chromaSize(m_width) : chromaSize(m_width) * 2;
+      return m_ptr != NULL
+          && m_width <= m_lineLength
+          && chromaRowLength <= m_planes[PlaneU].lineLength()
+          && actualImageSize() <= m_imageSize;
+    }
+
+    const Plane& plane(size_t _index) const
+    {
+      assert(_index < PlanesCount);
+      return m_planes[_index];
+    }
+
+    const size_t& width() const
+    {
+      return m_width;
+    }
+
+    const size_t& height() const
+    {
+      return m_height;
+    }
+
+    const size_t& lineLength() const
+    {
+      return m_lineLength;
+    }
+
+    const size_t& imageSize() const
+    {
+      return m_imageSize;
+    }
+
+    size_t actualImageSize() const
+    {
+      const size_t chromaHeight = chromaSize(m_height);
+      if (_PT == PlanarI420)
+        return m_height*m_lineLength + 2*chromaHeight*chromaLineLengthI420(m_lineLength);
+      else
+        return m_height*m_lineLength + chromaHeight*m_lineLength;
+    }
+
+    // Y line length padded to alignment; I420 chroma lines are half of it, so aligned to half of alignment
+    static size_t calcAlignedLineLength(size_t _width, size_t _alignment = s_cacheLineSize)
+    {
+      return alignSize(fixupLineLength(_width, 0), _alignment);
+    }
+
+  protected:
+    // semi-planar chroma row holds U,V pair for every two luma samples, so odd width is padded
+    static size_t fixupLineLength(size_t _width, size_t _lineLength)
+    {
+      if (_lineLength != 0)
+        return _lineLength;
+      return _PT == PlanarI420 ? _width : chromaSize(_width) * 2;
+    }
+
+    static size_t chromaLineLengthI420(size_t _lineLength)
+    {
+      return chromaSize(_lineLength);
+    }
+
+  private:
+    _UByteCV* m_ptr;
+    size_t    m_imageSize;
+    size_t    m_width;
+    size_t    m_height;
+    size_t    m_lineLength;
+    Plane     m_planes[PlanesCount];
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_PLANAR_HPP_
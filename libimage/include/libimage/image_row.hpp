@@ -53,7 +53,7 @@ class BaseImageRowAccessor
 };
 
 
-template <typename _UByteCV>
+template <typename _UByteCV, bool _checked = true>
 class ImageRowAccessor : private BaseImageRowAccessor
 {
   protected:
@@ -69,7 +69,7 @@ class ImageRowAccessor : private BaseImageRowAccessor
     {
     }
 
-    bool accessPixel(_UByteCV*& _pixelPtr, size_t _bytes, size_t _pixels=1)
+    bool accessPixel(_UByteCV* TRIK_LIBIMAGE_RESTRICT& _pixelPtr, size_t _bytes, size_t _pixels=1)
     {
       if (m_ptr == NULL)
         return false;
@@ -83,7 +83,7 @@ class ImageRowAccessor : private BaseImageRowAccessor
       return true;
     }
 
-    bool accessPixelDontMove(_UByteCV*& _pixelPtr, size_t _bytes, size_t _pixels)
+    bool accessPixelDontMove(_UByteCV* TRIK_LIBIMAGE_RESTRICT& _pixelPtr, size_t _bytes, size_t _pixels)
     {
       if (m_ptr == NULL)
         return false;
@@ -101,6 +101,82 @@ class ImageRowAccessor : private BaseImageRowAccessor
 };
 
 
+/*
+ * Accessor of row which buffer was validated once for whole image, see Image::isValid();
+ * no per-pixel checks and no failures. TRIK_LIBIMAGE_CHECKED turns checks back on for debugging.
+ */
+#ifdef TRIK_LIBIMAGE_CHECKED
+template <typename _UByteCV>
+class ImageRowAccessor<_UByteCV, false> : protected ImageRowAccessor<_UByteCV, true>
+{
+  protected:
+    ImageRowAccessor()
+     :ImageRowAccessor<_UByteCV, true>()
+    {
+    }
+
+    ImageRowAccessor(_UByteCV* _rowPtr, size_t _lineLength, size_t _width)
+     :ImageRowAccessor<_UByteCV, true>(_rowPtr, _lineLength, _width)
+    {
+    }
+};
+#else
+template <typename _UByteCV>
+class ImageRowAccessor<_UByteCV, false>
+{
+  protected:
+    ImageRowAccessor()
+     :m_ptr(NULL)
+    {
+    }
+
+    ImageRowAccessor(_UByteCV* _rowPtr, size_t _lineLength, size_t _width)
+     :m_ptr(_rowPtr)
+    {
+      (void)_lineLength;
+      (void)_width;
+    }
+
+    bool accessPixel(_UByteCV* TRIK_LIBIMAGE_RESTRICT& _pixelPtr, size_t _bytes, size_t _pixels=1)
+    {
+      (void)_pixels;
+      _pixelPtr = m_ptr;
+      m_ptr += _bytes;
+      return true;
+    }
+
+    bool accessPixelDontMove(_UByteCV* TRIK_LIBIMAGE_RESTRICT& _pixelPtr, size_t _bytes, size_t _pixels)
+    {
+      (void)_bytes;
+      (void)_pixels;
+      _pixelPtr = m_ptr;
+      return true;
+    }
+
+  private:
+    _UByteCV* m_ptr;
+};
+#endif
+
+
+/*
+ * Channel value of bulk row write, see ImageRow::writeRow(); rounded and saturated to channel range
+ */
+inline unsigned rowChannelStore(float _value, unsigned _max)
+{
+  return ImagePixelComponentFloat::store(_value, _max);
+}
+
+inline unsigned rowChannelStore(int _value, unsigned _max)
+{
+  if (_value < 0)
+    return 0;
+  if (static_cast<unsigned>(_value) > _max)
+    return _max;
+  return _value;
+}
+
+
 } /* **** **** **** **** **** * namespace internal * **** **** **** **** **** */
 
 
@@ -113,9 +189,18 @@ class BaseImageRow
 };
 
 
-template <BaseImagePixel::PixelType _PT, typename _UByteCV>
+/*
+ * Row of packed pixels; unchecked row (_checked=false) may only be obtained for image which passed Image::isValid()
+ * Besides per pixel readPixel()/writePixel(), every row provides bulk
+ *   template <typename _Value> bool readRow(_Value* _c0, _Value* _c1, _Value* _c2, size_t _pixels);
+ *   template <typename _Value> bool writeRow(const _Value* _c0, const _Value* _c1, const _Value* _c2, size_t _pixels);
+ * which decode or encode _pixels pixels from current position to or from structure-of-arrays channel planes,
+ * native channels of the format (R, G, B or Y, U, V) in channel units (e.g. 0..31 for 5 bit R), as float or int16_t.
+ * Whole span is checked once, then converted in a single loop; bulk and per pixel access may be mixed.
+ */
+template <BaseImagePixel::PixelType _PT, typename _UByteCV, bool _checked = true>
 class ImageRow : public BaseImageRow,
-                 private internal::ImageRowAccessor<_UByteCV>,
+                 private internal::ImageRowAccessor<_UByteCV, _checked>,
                  private assert_inst<false> // Generic instance, non-functional
 {
 };
@@ -130,13 +215,13 @@ class BaseImageRowSet
 };
 
 
-template <BaseImagePixel::PixelType _PT, typename _UByteCV, size_t _rowsCount>
+template <BaseImagePixel::PixelType _PT, typename _UByteCV, size_t _rowsCount, bool _checked = true>
 class ImageRowSet : public BaseImageRowSet,
                     private assert_inst<(_rowsCount > 0)> // sanity check
 {
   public:
-    typedef ImageRow<_PT, _UByteCV>        Row;
-    typedef ImagePixelSet<_PT, _rowsCount> PixelSet;
+    typedef ImageRow<_PT, _UByteCV, _checked> Row;
+    typedef ImagePixelSet<_PT, _rowsCount>    PixelSet;
 
     ImageRowSet()
      :BaseImageRowSet(),
@@ -175,7 +260,8 @@ class ImageRowSet : public BaseImageRowSet,
     }
 
 
-    bool readPixelSet(PixelSet& _pixelSet)
+    template <typename _Component>
+    bool readPixelSet(ImagePixelSet<_PT, _rowsCount, _Component>& _pixelSet)
     {
       bool isOk = true;
       for (size_t index = 0; index < _rowsCount; ++index)
@@ -183,7 +269,8 @@ class ImageRowSet : public BaseImageRowSet,
       return isOk;
     }
 
-    bool writePixelSet(const PixelSet& _pixelSet)
+    template <typename _Component>
+    bool writePixelSet(const ImagePixelSet<_PT, _rowsCount, _Component>& _pixelSet)
     {
       bool isOk = true;
       for (size_t index = 0; index < _rowsCount; ++index)
@@ -204,12 +291,54 @@ class ImageRowSet : public BaseImageRowSet,
 };
 
 
+
+
+/*
+ * Row of already unpacked pixels, read the same way as packed image row, including end of row behaviour
+ */
+template <typename _Pixel>
+class ImageRowUnpacked
+{
+  public:
+    ImageRowUnpacked(const _Pixel* _pixels, size_t _width)
+     :m_pixels(_pixels),
+      m_remainWidth(_width)
+    {
+    }
+
+    bool readPixel(_Pixel& _pixel)
+    {
+      if (m_remainWidth == 0)
+        return false;
+
+      _pixel = *m_pixels++;
+      --m_remainWidth;
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      if (m_remainWidth < _pixels)
+        return false;
+
+      m_pixels += _pixels;
+      m_remainWidth -= _pixels;
+      return true;
+    }
+
+  private:
+    const _Pixel* m_pixels;
+    size_t        m_remainWidth;
+};
+
+
 } /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
 } /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
 
 
 #include <libimage/image_row_rgb.hpp>
 #include <libimage/image_row_yuv.hpp>
+#include <libimage/image_row_gray.hpp>
 
 
 #endif // !TRIK_LIBIMAGE_IMAGE_ROW_HPP_
@@ -0,0 +1,101 @@
+#ifndef TRIK_LIBIMAGE_IMAGE_ROW_GRAY_HPP_
+#define TRIK_LIBIMAGE_IMAGE_ROW_GRAY_HPP_
+
+#ifndef __cplusplus
+#error C++-only header
+#endif
+
+
+#include <libimage/stdcpp.hpp>
+
+
+/* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
+/* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
+
+
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelGRAY8, _UByteCV, _checked> : public BaseImageRow,
+                                                                 private internal::ImageRowAccessor<_UByteCV, _checked>
+{
+  public:
+    typedef ImagePixel<BaseImagePixel::PixelGRAY8> PixelType;
+
+    ImageRow()
+     :BaseImageRow(),
+      ImageRowAccessor()
+    {
+    }
+
+    ImageRow(_UByteCV* _ptr, size_t _lineLength, size_t _width)
+     :BaseImageRow(),
+      ImageRowAccessor(_ptr, _lineLength, _width)
+    {
+    }
+
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelGRAY8, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 1))
+        return false;
+
+      return _pixel.unpack(ptr[0]);
+    }
+
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelGRAY8, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 1))
+        return false;
+
+      return _pixel.pack(ptr[0]);
+    }
+
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _y, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx)
+        _y[idx] = static_cast<_Value>(ptr[idx]);
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _y, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx)
+        ptr[idx] = internal::rowChannelStore(_y[idx], 0xff);
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels, _pixels);
+    }
+
+    static size_t calcLineLength(size_t _width)
+    {
+      return _width;
+    }
+
+  protected:
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
+};
+
+
+} /* **** **** **** **** **** * namespace libimage * **** **** **** **** **** */
+} /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
+
+
+#endif // !TRIK_LIBIMAGE_IMAGE_ROW_GRAY_HPP_
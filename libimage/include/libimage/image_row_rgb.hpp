@@ -13,9 +13,9 @@
 /* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
 
 
-template <typename _UByteCV>
-class ImageRow<BaseImagePixel::PixelRGB565, _UByteCV> : public BaseImageRow,
-                                                        private internal::ImageRowAccessor<_UByteCV>
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelRGB565, _UByteCV, _checked> : public BaseImageRow,
+                                                                  private internal::ImageRowAccessor<_UByteCV, _checked>
 {
   public:
     typedef ImagePixel<BaseImagePixel::PixelRGB565> PixelType;
@@ -32,39 +32,85 @@ class ImageRow<BaseImagePixel::PixelRGB565, _UByteCV> : public BaseImageRow,
     {
     }
 
-    bool readPixel(PixelType& _pixel)
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelRGB565, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 2))
         return false;
 
       return _pixel.unpack(ptr[0], ptr[1]);
     }
 
-    bool writePixel(const PixelType& _pixel)
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelRGB565, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 2))
         return false;
 
       return _pixel.pack(ptr[0], ptr[1]);
     }
 
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 2)
+      {
+        _r[idx] = static_cast<_Value>(ptr[0] >> 3);
+        _g[idx] = static_cast<_Value>(((ptr[0] & 0x07) << 3) | (ptr[1] >> 5));
+        _b[idx] = static_cast<_Value>(ptr[1] & 0x1f);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 2)
+      {
+        const unsigned r = internal::rowChannelStore(_r[idx], 0x1f);
+        const unsigned g = internal::rowChannelStore(_g[idx], 0x3f);
+        const unsigned b = internal::rowChannelStore(_b[idx], 0x1f);
+        ptr[0] = (r << 3) | (g >> 3);
+        ptr[1] = ((g & 0x07) << 5) | b;
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels);
+    }
+
     static size_t calcLineLength(size_t _width)
     {
       return _width * 2;
     }
 
   protected:
-    typedef internal::ImageRowAccessor<_UByteCV> ImageRowAccessor;
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
 };
 
 
 
 
-template <typename _UByteCV>
-class ImageRow<BaseImagePixel::PixelRGB565X, _UByteCV> : public BaseImageRow,
-                                                         private internal::ImageRowAccessor<_UByteCV>
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelRGB565X, _UByteCV, _checked> : public BaseImageRow,
+                                                                   private internal::ImageRowAccessor<_UByteCV, _checked>
 {
   public:
     typedef ImagePixel<BaseImagePixel::PixelRGB565X> PixelType;
@@ -81,39 +127,85 @@ class ImageRow<BaseImagePixel::PixelRGB565X, _UByteCV> : public BaseImageRow,
     {
     }
 
-    bool readPixel(PixelType& _pixel)
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelRGB565X, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 2))
         return false;
 
       return _pixel.unpack(ptr[0], ptr[1]);
     }
 
-    bool writePixel(const PixelType& _pixel)
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelRGB565X, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 2))
         return false;
 
       return _pixel.pack(ptr[0], ptr[1]);
     }
 
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 2)
+      {
+        _r[idx] = static_cast<_Value>(ptr[0] & 0x1f);
+        _g[idx] = static_cast<_Value>((ptr[0] >> 5) | ((ptr[1] & 0x07) << 3));
+        _b[idx] = static_cast<_Value>(ptr[1] >> 3);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 2)
+      {
+        const unsigned r = internal::rowChannelStore(_r[idx], 0x1f);
+        const unsigned g = internal::rowChannelStore(_g[idx], 0x3f);
+        const unsigned b = internal::rowChannelStore(_b[idx], 0x1f);
+        ptr[0] = r | ((g & 0x07) << 5);
+        ptr[1] = (g >> 3) | (b << 3);
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*2, _pixels);
+    }
+
     static size_t calcLineLength(size_t _width)
     {
       return _width * 2;
     }
 
   protected:
-    typedef internal::ImageRowAccessor<_UByteCV> ImageRowAccessor;
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
 };
 
 
 
 
-template <typename _UByteCV>
-class ImageRow<BaseImagePixel::PixelRGB888, _UByteCV> : public BaseImageRow,
-                                                        private internal::ImageRowAccessor<_UByteCV>
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelRGB888, _UByteCV, _checked> : public BaseImageRow,
+                                                                  private internal::ImageRowAccessor<_UByteCV, _checked>
 {
   public:
     typedef ImagePixel<BaseImagePixel::PixelRGB888> PixelType;
@@ -130,31 +222,357 @@ class ImageRow<BaseImagePixel::PixelRGB888, _UByteCV> : public BaseImageRow,
     {
     }
 
-    bool readPixel(PixelType& _pixel)
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelRGB888, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 3))
         return false;
 
       return _pixel.unpack(ptr[0], ptr[1], ptr[2]);
     }
 
-    bool writePixel(const PixelType& _pixel)
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelRGB888, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 3))
         return false;
 
       return _pixel.pack(ptr[0], ptr[1], ptr[2]);
     }
 
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*3, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 3)
+      {
+        _r[idx] = static_cast<_Value>(ptr[0]);
+        _g[idx] = static_cast<_Value>(ptr[1]);
+        _b[idx] = static_cast<_Value>(ptr[2]);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*3, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 3)
+      {
+        ptr[0] = internal::rowChannelStore(_r[idx], 0xff);
+        ptr[1] = internal::rowChannelStore(_g[idx], 0xff);
+        ptr[2] = internal::rowChannelStore(_b[idx], 0xff);
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*3, _pixels);
+    }
+
     static size_t calcLineLength(size_t _width)
     {
       return _width * 3;
     }
 
   protected:
-    typedef internal::ImageRowAccessor<_UByteCV> ImageRowAccessor;
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
+};
+
+
+
+
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelRGBA8888, _UByteCV, _checked> : public BaseImageRow,
+                                                                    private internal::ImageRowAccessor<_UByteCV, _checked>
+{
+  public:
+    typedef ImagePixel<BaseImagePixel::PixelRGBA8888> PixelType;
+
+    ImageRow()
+     :BaseImageRow(),
+      ImageRowAccessor()
+    {
+    }
+
+    ImageRow(_UByteCV* _ptr, size_t _lineLength, size_t _width)
+     :BaseImageRow(),
+      ImageRowAccessor(_ptr, _lineLength, _width)
+    {
+    }
+
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelRGBA8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.unpack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelRGBA8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.pack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        _r[idx] = static_cast<_Value>(ptr[0]);
+        _g[idx] = static_cast<_Value>(ptr[1]);
+        _b[idx] = static_cast<_Value>(ptr[2]);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        ptr[0] = internal::rowChannelStore(_r[idx], 0xff);
+        ptr[1] = internal::rowChannelStore(_g[idx], 0xff);
+        ptr[2] = internal::rowChannelStore(_b[idx], 0xff);
+        ptr[3] = 0xff;
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels);
+    }
+
+    static size_t calcLineLength(size_t _width)
+    {
+      return _width * 4;
+    }
+
+  protected:
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
+};
+
+
+
+
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelBGRA8888, _UByteCV, _checked> : public BaseImageRow,
+                                                                    private internal::ImageRowAccessor<_UByteCV, _checked>
+{
+  public:
+    typedef ImagePixel<BaseImagePixel::PixelBGRA8888> PixelType;
+
+    ImageRow()
+     :BaseImageRow(),
+      ImageRowAccessor()
+    {
+    }
+
+    ImageRow(_UByteCV* _ptr, size_t _lineLength, size_t _width)
+     :BaseImageRow(),
+      ImageRowAccessor(_ptr, _lineLength, _width)
+    {
+    }
+
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelBGRA8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.unpack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelBGRA8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.pack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        _r[idx] = static_cast<_Value>(ptr[2]);
+        _g[idx] = static_cast<_Value>(ptr[1]);
+        _b[idx] = static_cast<_Value>(ptr[0]);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        ptr[0] = internal::rowChannelStore(_b[idx], 0xff);
+        ptr[1] = internal::rowChannelStore(_g[idx], 0xff);
+        ptr[2] = internal::rowChannelStore(_r[idx], 0xff);
+        ptr[3] = 0xff;
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels);
+    }
+
+    static size_t calcLineLength(size_t _width)
+    {
+      return _width * 4;
+    }
+
+  protected:
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
+};
+
+
+
+
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelXRGB8888, _UByteCV, _checked> : public BaseImageRow,
+                                                                    private internal::ImageRowAccessor<_UByteCV, _checked>
+{
+  public:
+    typedef ImagePixel<BaseImagePixel::PixelXRGB8888> PixelType;
+
+    ImageRow()
+     :BaseImageRow(),
+      ImageRowAccessor()
+    {
+    }
+
+    ImageRow(_UByteCV* _ptr, size_t _lineLength, size_t _width)
+     :BaseImageRow(),
+      ImageRowAccessor(_ptr, _lineLength, _width)
+    {
+    }
+
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelXRGB8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.unpack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelXRGB8888, _Component>& _pixel)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, 4))
+        return false;
+
+      return _pixel.pack(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _r, _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        _r[idx] = static_cast<_Value>(ptr[1]);
+        _g[idx] = static_cast<_Value>(ptr[2]);
+        _b[idx] = static_cast<_Value>(ptr[3]);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _r, const _Value* TRIK_LIBIMAGE_RESTRICT _g,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _b, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        ptr[0] = 0;
+        ptr[1] = internal::rowChannelStore(_r[idx], 0xff);
+        ptr[2] = internal::rowChannelStore(_g[idx], 0xff);
+        ptr[3] = internal::rowChannelStore(_b[idx], 0xff);
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels);
+    }
+
+    static size_t calcLineLength(size_t _width)
+    {
+      return _width * 4;
+    }
+
+  protected:
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
 };
 
 
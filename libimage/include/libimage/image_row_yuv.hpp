@@ -13,9 +13,9 @@
 /* **** **** **** **** **** */ namespace libimage /* **** **** **** **** **** */ {
 
 
-template <typename _UByteCV>
-class ImageRow<BaseImagePixel::PixelYUV444, _UByteCV> : public BaseImageRow,
-                                                        private internal::ImageRowAccessor<_UByteCV>
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelYUV444, _UByteCV, _checked> : public BaseImageRow,
+                                                                  private internal::ImageRowAccessor<_UByteCV, _checked>
 {
   public:
     typedef ImagePixel<BaseImagePixel::PixelYUV444> PixelType;
@@ -32,39 +32,84 @@ class ImageRow<BaseImagePixel::PixelYUV444, _UByteCV> : public BaseImageRow,
     {
     }
 
-    bool readPixel(PixelType& _pixel)
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelYUV444, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 4))
         return false;
 
       return _pixel.unpack(ptr[0], ptr[1], ptr[2], ptr[3]);
     }
 
-    bool writePixel(const PixelType& _pixel)
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelYUV444, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (!ImageRowAccessor::accessPixel(ptr, 4))
         return false;
 
       return _pixel.pack(ptr[0], ptr[1], ptr[2], ptr[3]);
     }
 
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _y, _Value* TRIK_LIBIMAGE_RESTRICT _u,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _v, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        _y[idx] = static_cast<_Value>(ptr[1]);
+        _u[idx] = static_cast<_Value>(ptr[2]);
+        _v[idx] = static_cast<_Value>(ptr[3]);
+      }
+
+      return true;
+    }
+
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _y, const _Value* TRIK_LIBIMAGE_RESTRICT _u,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _v, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels))
+        return false;
+
+      for (size_t idx = 0; idx < _pixels; ++idx, ptr += 4)
+      {
+        ptr[0] = 0;
+        ptr[1] = internal::rowChannelStore(_y[idx], 0xff);
+        ptr[2] = internal::rowChannelStore(_u[idx], 0xff);
+        ptr[3] = internal::rowChannelStore(_v[idx], 0xff);
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      return ImageRowAccessor::accessPixel(ptr, _pixels*4, _pixels);
+    }
+
     static size_t calcLineLength(size_t _width)
     {
       return _width * 4;
     }
 
   protected:
-    typedef internal::ImageRowAccessor<_UByteCV> ImageRowAccessor;
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
 };
 
 
 
 
-template <typename _UByteCV>
-class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV> : public BaseImageRow,
-                                                        private internal::ImageRowAccessor<_UByteCV>
+template <typename _UByteCV, bool _checked>
+class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV, _checked> : public BaseImageRow,
+                                                                  private internal::ImageRowAccessor<_UByteCV, _checked>
 {
   public:
     typedef ImagePixel<BaseImagePixel::PixelYUV422> PixelType;
@@ -85,9 +130,10 @@ class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV> : public BaseImageRow,
     {
     }
 
-    bool readPixel(PixelType& _pixel)
+    template <typename _Component>
+    bool readPixel(ImagePixel<BaseImagePixel::PixelYUV422, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (m_readParity)
       {
         if (!ImageRowAccessor::accessPixel(ptr, 4, 2)) // 4 bytes, 2 pixels
@@ -106,9 +152,10 @@ class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV> : public BaseImageRow,
       }
     }
 
-    bool writePixel(const PixelType& _pixel)
+    template <typename _Component>
+    bool writePixel(const ImagePixel<BaseImagePixel::PixelYUV422, _Component>& _pixel)
     {
-      _UByteCV* ptr;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
       if (m_writeParity)
       {
         if (!ImageRowAccessor::accessPixel(ptr, 4, 2)) // 4 bytes, 2 pixels
@@ -127,6 +174,106 @@ class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV> : public BaseImageRow,
       }
     }
 
+    // pair chroma goes to both pixels; row may start or end in the middle of pair, as with readPixel()
+    template <typename _Value>
+    bool readRow(_Value* TRIK_LIBIMAGE_RESTRICT _y, _Value* TRIK_LIBIMAGE_RESTRICT _u,
+                 _Value* TRIK_LIBIMAGE_RESTRICT _v, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (_pixels > 0 && m_readParity)
+      {
+        if (!ImageRowAccessor::accessPixel(ptr, 4, 2))
+          return false;
+
+        m_readParity = false;
+        *_y++ = static_cast<_Value>(ptr[2]);
+        *_u++ = static_cast<_Value>(ptr[1]);
+        *_v++ = static_cast<_Value>(ptr[3]);
+        --_pixels;
+      }
+
+      const size_t pairs = _pixels/2;
+      if (!ImageRowAccessor::accessPixel(ptr, pairs*4, pairs*2))
+        return false;
+
+      for (size_t idx = 0; idx < pairs*2; idx += 2, ptr += 4)
+      {
+        _y[idx]   = static_cast<_Value>(ptr[0]);
+        _y[idx+1] = static_cast<_Value>(ptr[2]);
+        _u[idx]   = _u[idx+1] = static_cast<_Value>(ptr[1]);
+        _v[idx]   = _v[idx+1] = static_cast<_Value>(ptr[3]);
+      }
+
+      if (_pixels%2 != 0)
+      {
+        if (!ImageRowAccessor::accessPixelDontMove(ptr, 4, 2))
+          return false;
+
+        m_readParity = true;
+        _y[pairs*2] = static_cast<_Value>(ptr[0]);
+        _u[pairs*2] = static_cast<_Value>(ptr[1]);
+        _v[pairs*2] = static_cast<_Value>(ptr[3]);
+      }
+
+      return true;
+    }
+
+    // pair chroma is sum of halves of both pixels chroma, exactly as writePixel() packs it
+    template <typename _Value>
+    bool writeRow(const _Value* TRIK_LIBIMAGE_RESTRICT _y, const _Value* TRIK_LIBIMAGE_RESTRICT _u,
+                  const _Value* TRIK_LIBIMAGE_RESTRICT _v, size_t _pixels)
+    {
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (_pixels > 0 && m_writeParity)
+      {
+        if (!ImageRowAccessor::accessPixel(ptr, 4, 2))
+          return false;
+
+        m_writeParity = false;
+        ptr[2]  = internal::rowChannelStore(*_y++, 0xff);
+        ptr[1] += internal::rowChannelStore(*_u++, 0xff) / 2;
+        ptr[3] += internal::rowChannelStore(*_v++, 0xff) / 2;
+        --_pixels;
+      }
+
+      const size_t pairs = _pixels/2;
+      if (!ImageRowAccessor::accessPixel(ptr, pairs*4, pairs*2))
+        return false;
+
+      for (size_t idx = 0; idx < pairs*2; idx += 2, ptr += 4)
+      {
+        ptr[0] = internal::rowChannelStore(_y[idx],   0xff);
+        ptr[2] = internal::rowChannelStore(_y[idx+1], 0xff);
+        ptr[1] = internal::rowChannelStore(_u[idx], 0xff)/2 + internal::rowChannelStore(_u[idx+1], 0xff)/2;
+        ptr[3] = internal::rowChannelStore(_v[idx], 0xff)/2 + internal::rowChannelStore(_v[idx+1], 0xff)/2;
+      }
+
+      if (_pixels%2 != 0)
+      {
+        if (!ImageRowAccessor::accessPixelDontMove(ptr, 4, 2))
+          return false;
+
+        m_writeParity = true;
+        ptr[0] = internal::rowChannelStore(_y[pairs*2], 0xff);
+        ptr[1] = internal::rowChannelStore(_u[pairs*2], 0xff) / 2;
+        ptr[3] = internal::rowChannelStore(_v[pairs*2], 0xff) / 2;
+      }
+
+      return true;
+    }
+
+    bool skipPixels(size_t _pixels)
+    {
+      // pixel pairs share chroma, so only whole pairs are passed, parity keeps position inside pair
+      const size_t position = (m_readParity ? 1 : 0) + _pixels;
+      _UByteCV* TRIK_LIBIMAGE_RESTRICT ptr;
+      if (!ImageRowAccessor::accessPixel(ptr, position/2 * 4, position/2 * 2))
+        return false;
+
+      m_readParity = position%2 != 0;
+      return true;
+    }
+
     static size_t calcLineLength(size_t _width)
     {
       if (_width%2 != 0)
@@ -136,7 +283,7 @@ class ImageRow<BaseImagePixel::PixelYUV422, _UByteCV> : public BaseImageRow,
     }
 
   protected:
-    typedef internal::ImageRowAccessor<_UByteCV> ImageRowAccessor;
+    typedef internal::ImageRowAccessor<_UByteCV, _checked> ImageRowAccessor;
 
   private:
     PixelType m_readCachedPixel;
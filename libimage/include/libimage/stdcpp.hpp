@@ -6,6 +6,19 @@
 #endif
 
 #include <cassert>
+#include <cstddef>
+
+
+/*
+ * restrict in C++: TI compiler accepts C99 keyword, GCC has its own spelling, others go without
+ */
+#if defined(__TI_COMPILER_VERSION__)
+#define TRIK_LIBIMAGE_RESTRICT restrict
+#elif defined(__GNUC__)
+#define TRIK_LIBIMAGE_RESTRICT __restrict__
+#else
+#define TRIK_LIBIMAGE_RESTRICT
+#endif
 
 
 /* **** **** **** **** **** */ namespace trik /* **** **** **** **** **** */ {
@@ -35,6 +48,17 @@ class assert_inst // kind of static_assert for TI compiler
 };
 
 
+// L1D line of C674x, as well as of common ARM and x86 cores
+static const size_t s_cacheLineSize = 64;
+
+// _alignment must be power of two
+inline size_t alignSize(size_t _size, size_t _alignment)
+{
+  assert(_alignment != 0 && (_alignment & (_alignment-1)) == 0);
+  return (_size + _alignment - 1) & ~(_alignment - 1);
+}
+
+
 } /* **** **** **** **** **** * namespace trik * **** **** **** **** **** */
 
 
@@ -0,0 +1,118 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * Fixed point interpolation against float one with the same kernel: weighted sum of every tap is rounded
+ * once, so no output component may differ by more than 1 LSB and under 0.65% may differ at all; rounding
+ * every product separately raises that count by about a third. Source is noise with hard edges, which drives
+ * kernels into overshoot and saturation.
+ */
+static const unsigned s_tolerance = 1;
+static const size_t   s_mismatchPer10k  = 65;
+
+
+// same noise on every host
+static uint8_t noise()
+{
+  static uint32_t s_state = 12345;
+  s_state = s_state * 1103515245u + 12345u;
+  return static_cast<uint8_t>(s_state >> 16);
+}
+
+
+template <typename _Image>
+static void fill(vector<uint8_t>& _buffer, size_t _width)
+{
+  const size_t lineLength = _Image::RowType::calcLineLength(_width);
+  for (size_t idx = 0; idx < _buffer.size(); ++idx)
+  {
+    const size_t row = idx / lineLength;
+    const size_t col = idx % lineLength;
+    const bool edge = ((row / 5) + (col / 7)) % 2 == 0;
+    _buffer[idx] = edge ? noise() % 16 : 240 + noise() % 16;
+    if (row % 11 == 0)
+      _buffer[idx] = noise();
+  }
+}
+
+
+template <template <typename> class _Interpolation, BaseImagePixel::PixelType _PT>
+static bool check(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<_PT, const uint8_t> ImageIn;
+  typedef Image<_PT, uint8_t>       ImageOut;
+  typedef _Interpolation<internal::ImagePixelComponentFloat> InterpolationFloat;
+  typedef _Interpolation<internal::ImagePixelComponentFixed> InterpolationFixed;
+
+  const size_t srcLineLength = ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> srcBuffer(srcLineLength * _srcHeight);
+  vector<uint8_t> dstFloat(dstLineLength * _dstHeight);
+  vector<uint8_t> dstFixed(dstLineLength * _dstHeight);
+  fill<ImageIn>(srcBuffer, _srcWidth);
+
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  ImageOut dstImageFloat(&dstFloat.front(), dstFloat.size(), _dstWidth, _dstHeight, dstLineLength);
+  ImageOut dstImageFixed(&dstFixed.front(), dstFixed.size(), _dstWidth, _dstHeight, dstLineLength);
+
+  internal::AlgoResampleVH<InterpolationFloat, InterpolationFloat, ImageIn, ImageOut> algorithmFloat;
+  internal::AlgoResampleVH<InterpolationFixed, InterpolationFixed, ImageIn, ImageOut> algorithmFixed;
+  bool passed = algorithmFloat(srcImage, dstImageFloat) && algorithmFixed(srcImage, dstImageFixed);
+
+  unsigned maxDiff = 0;
+  size_t mismatches = 0;
+  for (size_t idx = 0; idx < dstFloat.size(); ++idx)
+  {
+    const unsigned diff = abs(static_cast<int>(dstFloat[idx]) - static_cast<int>(dstFixed[idx]));
+    maxDiff = max(maxDiff, diff);
+    mismatches += diff > 0 ? 1 : 0;
+  }
+  passed &= maxDiff <= s_tolerance && mismatches*10000 <= dstFloat.size()*s_mismatchPer10k;
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << ": max diff " << maxDiff << ", " << mismatches << " of " << dstFloat.size() << " differ" << (passed ? ", ok" : ", FAILED") << endl;
+  return passed;
+}
+
+
+template <typename _Component>
+class Lanczos2 : public internal::AlgoInterpolationLanczos<2, _Component>
+{
+  public:
+    Lanczos2(const float& _t) : internal::AlgoInterpolationLanczos<2, _Component>(_t) {}
+};
+
+template <typename _Component>
+class Lanczos3 : public internal::AlgoInterpolationLanczos<3, _Component>
+{
+  public:
+    Lanczos3(const float& _t) : internal::AlgoInterpolationLanczos<3, _Component>(_t) {}
+};
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<internal::AlgoInterpolationCubic, BaseImagePixel::PixelRGB888>("RGB888 bicubic",      320, 240, 213, 160);
+  passed &= check<internal::AlgoInterpolationCubic, BaseImagePixel::PixelRGB888>("RGB888 bicubic",      160, 120, 333, 250);
+  passed &= check<internal::AlgoInterpolationCubic, BaseImagePixel::PixelXRGB8888>("XRGB8888 bicubic",  321, 241, 200, 151);
+  passed &= check<Lanczos2,                         BaseImagePixel::PixelRGB888>("RGB888 lanczos2",     320, 240, 213, 160);
+  passed &= check<Lanczos2,                         BaseImagePixel::PixelXRGB8888>("XRGB8888 lanczos2", 160, 120, 333, 250);
+  passed &= check<Lanczos3,                         BaseImagePixel::PixelRGB888>("RGB888 lanczos3",     320, 240, 213, 160);
+  passed &= check<Lanczos3,                         BaseImagePixel::PixelRGB888>("RGB888 lanczos3",     160, 120, 333, 250);
+  passed &= check<Lanczos3,                         BaseImagePixel::PixelXRGB8888>("XRGB8888 lanczos3", 321, 241, 200, 151);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
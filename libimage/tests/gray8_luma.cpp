@@ -0,0 +1,123 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+#include "reference_resample.hpp"
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * GRAY8 output resamples only luma of input. Reference takes Y bytes of YUV422 as is and integer BT.601 luma
+ * of RGB888, resamples that plane in float and rounds once; output must match within 1 LSB.
+ * Same size RGB565 conversion is checked against float BT.601 of components expanded to 8 bit.
+ */
+static const unsigned s_tolerance = 1;
+
+
+static uint8_t noise()
+{
+  static uint32_t s_state = 7;
+  s_state = s_state * 1103515245u + 12345u;
+  return static_cast<uint8_t>(s_state >> 16);
+}
+
+
+static float luma(BaseImagePixel::PixelType _pt, const uint8_t* _line, size_t _col)
+{
+  switch (_pt)
+  {
+    case BaseImagePixel::PixelYUV422:
+      return _line[_col/2*4 + _col%2*2];
+
+    case BaseImagePixel::PixelRGB888:
+    {
+      const uint8_t* ptr = _line + _col*3;
+      return (ptr[0]*19595u + ptr[1]*38470u + ptr[2]*7471u + (1u<<15)) >> 16;
+    }
+
+    case BaseImagePixel::PixelRGB565:
+    {
+      const uint8_t* ptr = _line + _col*2;
+      const float r = (ptr[0] >> 3) * 255.0f / 31;
+      const float g = (((ptr[0] & 0x07) << 3) | (ptr[1] >> 5)) * 255.0f / 63;
+      const float b = (ptr[1] & 0x1f) * 255.0f / 31;
+      return 0.299f*r + 0.587f*g + 0.114f*b;
+    }
+
+    default:
+      return 0;
+  }
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG, BaseImagePixel::PixelType _PT>
+static bool check(const char* _name, ReferenceKernel _kernel,
+                  size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<_PT, const uint8_t>                         ImageIn;
+  typedef Image<BaseImagePixel::PixelGRAY8, uint8_t>        ImageOut;
+
+  const size_t srcLineLength = ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = idx % 9 < 4 ? noise() : static_cast<uint8_t>(idx*3);
+
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+  ImageAlgorithm<_ALG, ImageIn, ImageOut> algorithm;
+  bool passed = algorithm(srcImage, dstImage);
+
+  ReferencePlane y(_srcWidth, _srcHeight);
+  for (size_t row = 0; row < _srcHeight; ++row)
+    for (size_t col = 0; col < _srcWidth; ++col)
+      y.at(col, row) = luma(_PT, &srcBuffer[row*srcLineLength], col);
+
+  const bool sameSize = _srcWidth == _dstWidth && _srcHeight == _dstHeight;
+  const ReferencePlane yOut = sameSize ? y : referenceResample(y, _dstWidth, _dstHeight, _kernel);
+
+  unsigned maxDiff = 0;
+  for (size_t row = 0; row < _dstHeight; ++row)
+    for (size_t col = 0; col < _dstWidth; ++col)
+    {
+      const int diff = static_cast<int>(dstBuffer[row*dstLineLength + col]) - static_cast<int>(referenceStore(yOut.at(col, row)));
+      maxDiff = max(maxDiff, static_cast<unsigned>(abs(diff)));
+    }
+  passed &= maxDiff <= s_tolerance;
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << ": max diff " << maxDiff << (passed ? ", ok" : ", FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bicubic",  ReferenceCubic,  64, 48, 37, 29);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bicubic",  ReferenceCubic,  34, 17, 15, 9);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bicubic",  ReferenceCubic,  32, 24, 81, 55);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBilinear, BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bilinear", ReferenceLinear, 64, 48, 37, 29);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bicubic",  ReferenceCubic,  2,  1,  5,  3);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelYUV422>("YUV422 -> GRAY8 bicubic",  ReferenceCubic,  64, 48, 32, 24);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bicubic",  ReferenceCubic,  64, 48, 37, 29);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bicubic",  ReferenceCubic,  33, 17, 15, 9);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBilinear, BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bilinear", ReferenceLinear, 33, 17, 70, 41);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bicubic",  ReferenceCubic,  1,  1,  1,  1);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bicubic",  ReferenceCubic,  1,  1,  5,  3);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,  BaseImagePixel::PixelRGB888>("RGB888 -> GRAY8 bicubic",  ReferenceCubic,  5,  3,  1,  1);
+  passed &= check<BaseImageAlgorithm::AlgoConvert,          BaseImagePixel::PixelRGB565>("RGB565 -> GRAY8 convert",  ReferenceLinear, 33, 17, 33, 17);
+  passed &= check<BaseImageAlgorithm::AlgoConvert,          BaseImagePixel::PixelRGB565>("RGB565 -> GRAY8 convert",  ReferenceLinear, 1,  1,  1,  1);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,70 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * Planar bicubic resample of flat NV12 frame: every output plane stays flat at its own value,
+ * so chroma planes are neither swapped nor mixed with luma across layouts.
+ */
+static const unsigned s_values[BaseImagePlanar::PlanesCount] = { 100, 60, 200 };
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG, BaseImagePlanar::PlanarType _PTOut>
+static bool check(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef ImagePlanar<BaseImagePlanar::PlanarNV12, uint8_t>       ImageIn;
+  typedef ImagePlanar<BaseImagePlanar::PlanarNV12, const uint8_t> ImageInConst;
+  typedef ImagePlanar<_PTOut, uint8_t>                            ImageOut;
+
+  vector<uint8_t> srcBuffer(ImageIn(NULL, 0, _srcWidth, _srcHeight, 0).actualImageSize());
+  vector<uint8_t> dstBuffer(ImageOut(NULL, 0, _dstWidth, _dstHeight, 0).actualImageSize());
+
+  const ImageIn srcFill(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, 0);
+  for (size_t planeIdx = 0; planeIdx < BaseImagePlanar::PlanesCount; ++planeIdx)
+  {
+    const typename ImageIn::Plane& plane = srcFill.plane(planeIdx);
+    for (size_t rowIdx = 0; rowIdx < plane.height(); ++rowIdx)
+      for (size_t col = 0; col < plane.width(); ++col)
+        plane.row(rowIdx)[col*plane.step()] = s_values[planeIdx];
+  }
+
+  const ImageInConst srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, 0);
+  ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, 0);
+
+  ImageAlgorithm<_ALG, ImageInConst, ImageOut> algorithm;
+  bool passed = algorithm(srcImage, dstImage);
+
+  for (size_t planeIdx = 0; passed && planeIdx < BaseImagePlanar::PlanesCount; ++planeIdx)
+  {
+    const typename ImageOut::Plane& plane = dstImage.plane(planeIdx);
+    for (size_t rowIdx = 0; rowIdx < plane.height(); ++rowIdx)
+      for (size_t col = 0; col < plane.width(); ++col)
+        passed &= plane.sample(plane.row(rowIdx), col) == s_values[planeIdx];
+  }
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,      BaseImagePlanar::PlanarI420>("NV12 -> I420 float", 64, 48, 33, 25);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,      BaseImagePlanar::PlanarNV21>("NV12 -> NV21 float", 64, 48, 100, 75);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubicFixed, BaseImagePlanar::PlanarI420>("NV12 -> I420 fixed", 64, 48, 33, 25);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubicFixed, BaseImagePlanar::PlanarNV21>("NV12 -> NV21 fixed", 64, 48, 100, 75);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
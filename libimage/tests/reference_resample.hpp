@@ -0,0 +1,117 @@
+#ifndef TRIK_LIBIMAGE_TESTS_REFERENCE_RESAMPLE_HPP_
+#define TRIK_LIBIMAGE_TESTS_REFERENCE_RESAMPLE_HPP_
+
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+
+
+/*
+ * Straightforward separable resample of one plane of float samples, as reference for library output.
+ * Output index maps to input one by sizeIn/sizeOut, taps beyond the edge repeat edge sample,
+ * rows are filtered first and columns then, all in float; only the final store rounds.
+ */
+enum ReferenceKernel
+{
+  ReferenceLinear,
+  ReferenceCubic
+};
+
+
+class ReferencePlane
+{
+  public:
+    ReferencePlane(size_t _width, size_t _height)
+     :m_width(_width),
+      m_height(_height),
+      m_samples(_width*_height)
+    {
+    }
+
+    const size_t& width() const { return m_width; }
+    const size_t& height() const { return m_height; }
+
+    float& at(size_t _col, size_t _row) { return m_samples[_row*m_width + _col]; }
+    const float& at(size_t _col, size_t _row) const { return m_samples[_row*m_width + _col]; }
+
+    // edge sample beyond the plane
+    const float& clamped(long _col, long _row) const
+    {
+      const long col = std::min(std::max(_col, 0L), static_cast<long>(m_width) - 1);
+      const long row = std::min(std::max(_row, 0L), static_cast<long>(m_height) - 1);
+      return at(col, row);
+    }
+
+  private:
+    size_t             m_width;
+    size_t             m_height;
+    std::vector<float> m_samples;
+};
+
+
+// first tap index and weights of output index, returns taps count
+static inline size_t referenceTaps(ReferenceKernel _kernel, size_t _idxOut, size_t _sizeIn, size_t _sizeOut,
+                                   long& _first, float* _weights)
+{
+  const float factor = static_cast<float>(_sizeIn) / static_cast<float>(_sizeOut);
+  const float coord = _idxOut * factor;
+  const long idx = static_cast<long>(coord);
+  const double t = coord - idx;
+
+  if (_kernel == ReferenceLinear)
+  {
+    _first = idx;
+    _weights[0] = 1.0 - t;
+    _weights[1] = t;
+    return 2;
+  }
+
+  // Catmull-Rom
+  _first = idx - 1;
+  _weights[0] = 0.5 * (         -t + 2*t*t -   t*t*t);
+  _weights[1] = 0.5 * (2           - 5*t*t + 3*t*t*t);
+  _weights[2] = 0.5 * (          t + 4*t*t - 3*t*t*t);
+  _weights[3] = 0.5 * (                -t*t +   t*t*t);
+  return 4;
+}
+
+static inline ReferencePlane referenceResample(const ReferencePlane& _in, size_t _widthOut, size_t _heightOut,
+                                               ReferenceKernel _kernel)
+{
+  ReferencePlane rows(_widthOut, _in.height());
+  for (size_t row = 0; row < _in.height(); ++row)
+    for (size_t col = 0; col < _widthOut; ++col)
+    {
+      long first;
+      float weights[4];
+      const size_t taps = referenceTaps(_kernel, col, _in.width(), _widthOut, first, weights);
+      float sum = 0;
+      for (size_t tap = 0; tap < taps; ++tap)
+        sum += _in.clamped(first + tap, row) * weights[tap];
+      rows.at(col, row) = sum;
+    }
+
+  ReferencePlane out(_widthOut, _heightOut);
+  for (size_t row = 0; row < _heightOut; ++row)
+    for (size_t col = 0; col < _widthOut; ++col)
+    {
+      long first;
+      float weights[4];
+      const size_t taps = referenceTaps(_kernel, row, _in.height(), _heightOut, first, weights);
+      float sum = 0;
+      for (size_t tap = 0; tap < taps; ++tap)
+        sum += rows.clamped(col, first + tap) * weights[tap];
+      out.at(col, row) = sum;
+    }
+
+  return out;
+}
+
+// saturated and rounded 8 bit sample
+static inline unsigned referenceStore(float _value)
+{
+  return static_cast<unsigned>(std::min(255.0f, std::max(0.0f, _value)) + 0.5f);
+}
+
+
+#endif // !TRIK_LIBIMAGE_TESTS_REFERENCE_RESAMPLE_HPP_
@@ -0,0 +1,130 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * 32 bit outputs carry exactly RGB888 output of the same algorithm, in their byte order, with alpha 0xff
+ * and X byte 0. Lines are longer than pixels and padded with sentinel, which every format must leave alone.
+ */
+static const size_t  s_linePadding = 12;
+static const uint8_t s_sentinel    = 0xa5;
+
+
+static uint8_t noise()
+{
+  static uint32_t s_state = 3;
+  s_state = s_state * 1103515245u + 12345u;
+  return static_cast<uint8_t>(s_state >> 16);
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG, typename _ImageIn, BaseImagePixel::PixelType _PTOut>
+static bool resample(const _ImageIn& _srcImage, vector<uint8_t>& _dstBuffer, size_t _dstWidth, size_t _dstHeight,
+                     size_t& _dstLineLength)
+{
+  typedef Image<_PTOut, uint8_t> ImageOut;
+
+  _dstLineLength = ImageOut::RowType::calcLineLength(_dstWidth) + s_linePadding;
+  _dstBuffer.assign(_dstLineLength*_dstHeight, s_sentinel);
+
+  ImageOut dstImage(&_dstBuffer.front(), _dstBuffer.size(), _dstWidth, _dstHeight, _dstLineLength);
+  ImageAlgorithm<_ALG, _ImageIn, ImageOut> algorithm;
+  return algorithm(_srcImage, dstImage);
+}
+
+
+// byte offsets of R, G, B and of the fourth byte in 32 bit pixel, and value of that byte
+template <BaseImageAlgorithm::AlgorithmType _ALG, typename _ImageIn, BaseImagePixel::PixelType _PTOut>
+static bool checkFormat(const char* _format, const _ImageIn& _srcImage, const vector<uint8_t>& _rgbBuffer,
+                        size_t _rgbLineLength, size_t _dstWidth, size_t _dstHeight,
+                        size_t _r, size_t _g, size_t _b, size_t _fourth, uint8_t _fourthValue)
+{
+  vector<uint8_t> dstBuffer;
+  size_t dstLineLength;
+  bool passed = resample<_ALG, _ImageIn, _PTOut>(_srcImage, dstBuffer, _dstWidth, _dstHeight, dstLineLength);
+
+  size_t mismatches = 0;
+  for (size_t row = 0; row < _dstHeight; ++row)
+  {
+    const uint8_t* rgb = &_rgbBuffer[row*_rgbLineLength];
+    const uint8_t* dst = &dstBuffer[row*dstLineLength];
+    for (size_t col = 0; col < _dstWidth; ++col, rgb += 3, dst += 4)
+      mismatches += (dst[_r] != rgb[0]) + (dst[_g] != rgb[1]) + (dst[_b] != rgb[2]) + (dst[_fourth] != _fourthValue);
+    for (size_t idx = _dstWidth*4; idx < dstLineLength; ++idx)
+      mismatches += dstBuffer[row*dstLineLength + idx] != s_sentinel;
+  }
+  passed &= mismatches == 0;
+
+  cout << "  " << _format << ": " << mismatches << " bytes differ" << (passed ? ", ok" : ", FAILED") << endl;
+  return passed;
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG, BaseImagePixel::PixelType _PTIn>
+static bool check(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<_PTIn, const uint8_t> ImageIn;
+
+  const size_t srcLineLength = ImageIn::RowType::calcLineLength(_srcWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  for (size_t idx = 0; idx < srcBuffer.size(); ++idx)
+    srcBuffer[idx] = noise();
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight << endl;
+
+  vector<uint8_t> rgbBuffer;
+  size_t rgbLineLength;
+  bool passed = resample<_ALG, ImageIn, BaseImagePixel::PixelRGB888>(srcImage, rgbBuffer, _dstWidth, _dstHeight, rgbLineLength);
+  passed &= checkFormat<_ALG, ImageIn, BaseImagePixel::PixelRGBA8888>("RGBA8888", srcImage, rgbBuffer, rgbLineLength,
+                                                                      _dstWidth, _dstHeight, 0, 1, 2, 3, 0xff);
+  passed &= checkFormat<_ALG, ImageIn, BaseImagePixel::PixelBGRA8888>("BGRA8888", srcImage, rgbBuffer, rgbLineLength,
+                                                                      _dstWidth, _dstHeight, 2, 1, 0, 3, 0xff);
+  passed &= checkFormat<_ALG, ImageIn, BaseImagePixel::PixelXRGB8888>("XRGB8888", srcImage, rgbBuffer, rgbLineLength,
+                                                                      _dstWidth, _dstHeight, 1, 2, 3, 0, 0);
+  return passed;
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG>
+static bool checkGeometries(const char* _name)
+{
+  const string yuv = string("YUV422 -> ") + _name;
+  const string rgb = string("RGB888 -> ") + _name;
+  bool passed = true;
+
+  passed &= check<_ALG, BaseImagePixel::PixelYUV422>(yuv.c_str(), 64, 48, 37, 29);
+  passed &= check<_ALG, BaseImagePixel::PixelYUV422>(yuv.c_str(), 2,  1,  1,  1);
+  passed &= check<_ALG, BaseImagePixel::PixelYUV422>(yuv.c_str(), 2,  1,  3,  3);
+  passed &= check<_ALG, BaseImagePixel::PixelYUV422>(yuv.c_str(), 6,  3,  1,  1);
+  passed &= check<_ALG, BaseImagePixel::PixelRGB888>(rgb.c_str(), 33, 17, 50, 9);
+  passed &= check<_ALG, BaseImagePixel::PixelRGB888>(rgb.c_str(), 1,  1,  1,  1);
+  passed &= check<_ALG, BaseImagePixel::PixelRGB888>(rgb.c_str(), 1,  1,  3,  3);
+  passed &= check<_ALG, BaseImagePixel::PixelRGB888>(rgb.c_str(), 5,  3,  1,  1);
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= checkGeometries<BaseImageAlgorithm::AlgoResampleNearest> ("nearest");
+  passed &= checkGeometries<BaseImageAlgorithm::AlgoResampleBilinear>("bilinear");
+  passed &= checkGeometries<BaseImageAlgorithm::AlgoResampleBicubic> ("bicubic");
+  passed &= checkGeometries<BaseImageAlgorithm::AlgoResampleArea>    ("area");
+  passed &= checkGeometries<BaseImageAlgorithm::AlgoResampleLanczos3>("lanczos3");
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,217 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+#include <libimage/image_algo_parallel.hpp>
+#include <libimage/image_memory.hpp>
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * Algorithm called again with the same geometry reuses plans and scratch rows of the first call:
+ * every operator new after warm-up frame is counted as failure. Algorithm constructed over arena
+ * takes nothing from heap even on warm-up, its arena usage does not grow from frame to frame and
+ * algorithms over distinct arenas, called alternately, never touch each other's arena.
+ */
+static size_t s_heapAllocations = 0;
+
+void* operator new(size_t _size)
+{
+  ++s_heapAllocations;
+  void* const ptr = malloc(_size == 0 ? 1 : _size);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* _ptr) noexcept
+{
+  free(_ptr);
+}
+
+void* operator new[](size_t _size)
+{
+  return operator new(_size);
+}
+
+void operator delete[](void* _ptr) noexcept
+{
+  operator delete(_ptr);
+}
+
+
+static const size_t s_frames = 5;
+
+
+template <typename _Image>
+class TestImage
+{
+  public:
+    TestImage(size_t _width, size_t _height)
+     :m_buffer(_Image::RowType::calcLineLength(_width) * _height),
+      m_image(&m_buffer.front(), m_buffer.size(), _width, _height, _Image::RowType::calcLineLength(_width))
+    {
+      for (size_t idx = 0; idx < m_buffer.size(); ++idx)
+        m_buffer[idx] = static_cast<uint8_t>(idx*7 + idx/_width*3);
+    }
+
+    _Image& image() { return m_image; }
+
+  private:
+    vector<uint8_t> m_buffer;
+    _Image          m_image;
+};
+
+
+// warm-up frame, then frames which must not allocate
+template <typename _Algorithm, typename _ImageIn, typename _ImageOut>
+static bool runFrames(_Algorithm& _algorithm, _ImageIn& _imageIn, _ImageOut& _imageOut, size_t& _allocations)
+{
+  bool isOk = _algorithm(_imageIn, _imageOut);
+
+  const size_t allocationsBefore = s_heapAllocations;
+  for (size_t frame = 0; frame < s_frames; ++frame)
+    isOk &= _algorithm(_imageIn, _imageOut);
+  _allocations = s_heapAllocations - allocationsBefore;
+
+  return isOk;
+}
+
+template <BaseImageAlgorithm::AlgorithmType _ALG, BaseImagePixel::PixelType _PTIn, BaseImagePixel::PixelType _PTOut>
+static bool check(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<_PTIn, const uint8_t> ImageIn;
+  typedef Image<_PTOut, uint8_t>      ImageOut;
+
+  TestImage<ImageIn>  src(_srcWidth, _srcHeight);
+  TestImage<ImageOut> dst(_dstWidth, _dstHeight);
+
+  size_t allocations = 0;
+  ImageAlgorithm<_ALG, ImageIn, ImageOut> algorithm;
+  bool passed = runFrames(algorithm, src.image(), dst.image(), allocations) && allocations == 0;
+
+  // same algorithm state carved from two arenas, instances interleaved
+  vector<uint8_t> arenaMemory[2] = { vector<uint8_t>(1 << 20), vector<uint8_t>(1 << 20) };
+  ImageMemoryArena arena0(&arenaMemory[0].front(), arenaMemory[0].size());
+  ImageMemoryArena arena1(&arenaMemory[1].front(), arenaMemory[1].size());
+  {
+    TestImage<ImageOut> dst1(_dstWidth, _dstHeight);
+    const size_t allocationsBefore = s_heapAllocations;
+    ImageAlgorithm<_ALG, ImageIn, ImageOut> arenaAlgorithm0(&arena0);
+    ImageAlgorithm<_ALG, ImageIn, ImageOut> arenaAlgorithm1(&arena1);
+
+    passed &= arenaAlgorithm0(src.image(), dst.image());
+    const size_t used0 = arena0.used();
+    passed &= arenaAlgorithm1(src.image(), dst1.image());
+    const size_t used1 = arena1.used();
+    passed &= arena0.used() == used0 && used1 == used0;
+    for (size_t frame = 0; frame < s_frames; ++frame)
+    {
+      passed &= arenaAlgorithm1(src.image(), dst1.image());
+      passed &= arenaAlgorithm0(src.image(), dst.image());
+    }
+    passed &= s_heapAllocations == allocationsBefore && arena0.used() == used0 && arena1.used() == used1;
+    // convertion keeps no state at all
+    passed &= used0 > 0 || _ALG == BaseImageAlgorithm::AlgoConvert;
+  }
+  passed &= arena0.used() == 0 && arena1.used() == 0;
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG>
+static bool checkPlanar(const char* _name, size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef ImagePlanar<BaseImagePlanar::PlanarNV12, const uint8_t> ImageIn;
+  typedef ImagePlanar<BaseImagePlanar::PlanarI420, uint8_t>       ImageOut;
+
+  vector<uint8_t> srcBuffer(ImageIn(NULL, 0, _srcWidth, _srcHeight, 0).actualImageSize(), 128);
+  vector<uint8_t> dstBuffer(ImageOut(NULL, 0, _dstWidth, _dstHeight, 0).actualImageSize());
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, 0);
+  ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, 0);
+
+  size_t allocations = 0;
+  ImageAlgorithm<_ALG, ImageIn, ImageOut> algorithm;
+  const bool passed = runFrames(algorithm, srcImage, dstImage, allocations) && allocations == 0;
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+static bool checkMultiOutput(size_t _srcWidth, size_t _srcHeight)
+{
+  typedef Image<BaseImagePixel::PixelYUV422, const uint8_t>                   ImageIn;
+  typedef Image<BaseImagePixel::PixelRGB565X, uint8_t>                        ImageOut;
+  typedef ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, ImageIn, ImageOut>  AlgorithmBicubic;
+  typedef ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBilinear, ImageIn, ImageOut> AlgorithmBilinear;
+
+  TestImage<ImageIn>  src(_srcWidth, _srcHeight);
+  TestImage<ImageOut> dstBicubic(_srcWidth/2, _srcHeight/2);
+  TestImage<ImageOut> dstBilinear(_srcWidth/3, _srcHeight/3);
+
+  ImageAlgorithmOutput<AlgorithmBicubic>  outputBicubic(dstBicubic.image());
+  ImageAlgorithmOutput<AlgorithmBilinear> outputBilinear(dstBilinear.image());
+  ImageAlgorithmMultiOutput<ImageIn> multiOutput;
+  multiOutput.addOutput(outputBicubic);
+  multiOutput.addOutput(outputBilinear);
+
+  bool passed = multiOutput(src.image());
+  const size_t allocationsBefore = s_heapAllocations;
+  for (size_t frame = 0; frame < s_frames; ++frame)
+    passed &= multiOutput(src.image());
+  passed &= s_heapAllocations == allocationsBefore;
+
+  cout << "multi output " << _srcWidth << "x" << _srcHeight << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+static bool checkParallel(size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<BaseImagePixel::PixelYUV422, const uint8_t>  ImageIn;
+  typedef Image<BaseImagePixel::PixelRGB565X, uint8_t>       ImageOut;
+
+  TestImage<ImageIn>  src(_srcWidth, _srcHeight);
+  TestImage<ImageOut> dst(_dstWidth, _dstHeight);
+
+  size_t allocations = 0;
+  ImageAlgorithmParallel<ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, ImageIn, ImageOut> > algorithm(2);
+  const bool passed = runFrames(algorithm, src.image(), dst.image(), allocations) && allocations == 0;
+
+  cout << "parallel bicubic " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic,         BaseImagePixel::PixelYUV422, BaseImagePixel::PixelRGB565X>("YUV422 -> RGB565X bicubic", 320, 240, 213, 160);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubicFixed,    BaseImagePixel::PixelYUV422, BaseImagePixel::PixelRGB565X>("YUV422 -> RGB565X bicubic fixed", 320, 240, 400, 300);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubicCompact,  BaseImagePixel::PixelRGB888, BaseImagePixel::PixelRGB888>("RGB888 -> RGB888 bicubic compact", 320, 240, 213, 160);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBilinear,        BaseImagePixel::PixelRGB888, BaseImagePixel::PixelRGB565>("RGB888 -> RGB565 bilinear", 320, 240, 640, 480);
+  passed &= check<BaseImageAlgorithm::AlgoResampleArea,            BaseImagePixel::PixelYUV422, BaseImagePixel::PixelRGB888>("YUV422 -> RGB888 area", 320, 240, 100, 75);
+  passed &= check<BaseImageAlgorithm::AlgoResampleLanczos3,        BaseImagePixel::PixelRGB888, BaseImagePixel::PixelRGB888>("RGB888 -> RGB888 lanczos3", 320, 240, 213, 160);
+  passed &= check<BaseImageAlgorithm::AlgoResampleNearest,         BaseImagePixel::PixelYUV422, BaseImagePixel::PixelRGB565X>("YUV422 -> RGB565X nearest", 320, 240, 160, 120);
+  passed &= check<BaseImageAlgorithm::AlgoConvert,                 BaseImagePixel::PixelYUV422, BaseImagePixel::PixelRGB888>("YUV422 -> RGB888 convert", 320, 240, 320, 240);
+  passed &= checkPlanar<BaseImageAlgorithm::AlgoResampleBicubic>("NV12 -> I420 bicubic", 320, 240, 213, 160);
+  passed &= checkMultiOutput(320, 240);
+  passed &= checkParallel(320, 240, 213, 160);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
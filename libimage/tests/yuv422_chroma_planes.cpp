@@ -0,0 +1,141 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <vector>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+#include "reference_resample.hpp"
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * YUV422 input is resampled as luma plane at full width and chroma planes of pixel pairs at half width.
+ * Reference filters the same planes independently in float, then output pixel takes luma of its own column
+ * and chroma of its pair and goes through the same YUV to RGB convertion. Covers odd output widths, where
+ * last pair holds one pixel, exact reductions which are decimated and single pixel outputs.
+ * Odd input width has no YUV422 line length and must be refused.
+ */
+static const unsigned s_tolerance = 1;
+
+
+static uint8_t noise()
+{
+  static uint32_t s_state = 1;
+  s_state = s_state * 1103515245u + 12345u;
+  return static_cast<uint8_t>(s_state >> 16);
+}
+
+
+template <BaseImageAlgorithm::AlgorithmType _ALG>
+static bool check(const char* _name, ReferenceKernel _kernel,
+                  size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<BaseImagePixel::PixelYUV422, const uint8_t> ImageIn;
+  typedef Image<BaseImagePixel::PixelRGB888, uint8_t>       ImageOut;
+  typedef ImagePixel<BaseImagePixel::PixelYUV422, internal::ImagePixelComponentFloat> PixelYUV;
+  typedef ImagePixel<BaseImagePixel::PixelRGB888, internal::ImagePixelComponentFloat> PixelRGB;
+
+  const size_t srcPairs = (_srcWidth + 1) / 2;
+  const size_t dstPairs = (_dstWidth + 1) / 2;
+  const size_t srcLineLength = ImageIn::RowType::calcLineLength(_srcWidth);
+  const size_t dstLineLength = ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+
+  // smooth ramps with noise on top, so overshoot and chroma of both pair halves matter
+  for (size_t row = 0; row < _srcHeight; ++row)
+    for (size_t idx = 0; idx < srcLineLength; ++idx)
+      srcBuffer[row*srcLineLength + idx] = static_cast<uint8_t>((idx*5 + row*3) % 256 / 2 + noise() % 128);
+
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+  ImageAlgorithm<_ALG, ImageIn, ImageOut> algorithm;
+  bool passed = algorithm(srcImage, dstImage);
+
+  ReferencePlane y(_srcWidth, _srcHeight);
+  ReferencePlane u(srcPairs, _srcHeight);
+  ReferencePlane v(srcPairs, _srcHeight);
+  for (size_t row = 0; row < _srcHeight; ++row)
+  {
+    const uint8_t* line = &srcBuffer[row*srcLineLength];
+    for (size_t col = 0; col < _srcWidth; ++col)
+      y.at(col, row) = line[col/2*4 + col%2*2];
+    for (size_t pair = 0; pair < srcPairs; ++pair)
+    {
+      u.at(pair, row) = line[pair*4 + 1];
+      v.at(pair, row) = line[pair*4 + 3];
+    }
+  }
+
+  const ReferencePlane yOut = referenceResample(y, _dstWidth, _dstHeight, _kernel);
+  const ReferencePlane uOut = referenceResample(u, dstPairs,  _dstHeight, _kernel);
+  const ReferencePlane vOut = referenceResample(v, dstPairs,  _dstHeight, _kernel);
+
+  unsigned maxDiff = 0;
+  for (size_t row = 0; row < _dstHeight; ++row)
+    for (size_t col = 0; col < _dstWidth; ++col)
+    {
+      PixelYUV yuv;
+      PixelRGB rgb;
+      yuv.fromComponents(yOut.at(col, row), uOut.at(col/2, row), vOut.at(col/2, row));
+      ImagePixelConvertion<PixelYUV, PixelRGB>()(yuv, rgb);
+
+      uint8_t expected[3];
+      rgb.pack(expected[0], expected[1], expected[2]);
+      const uint8_t* actual = &dstBuffer[row*dstLineLength + col*3];
+      for (size_t idx = 0; idx < 3; ++idx)
+        maxDiff = max(maxDiff, static_cast<unsigned>(abs(static_cast<int>(actual[idx]) - static_cast<int>(expected[idx]))));
+    }
+  passed &= maxDiff <= s_tolerance;
+
+  cout << _name << " " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << ": max diff " << maxDiff << (passed ? ", ok" : ", FAILED") << endl;
+  return passed;
+}
+
+
+static bool checkOddWidthRefused(size_t _srcWidth, size_t _srcHeight, size_t _dstWidth, size_t _dstHeight)
+{
+  typedef Image<BaseImagePixel::PixelYUV422, const uint8_t> ImageIn;
+  typedef Image<BaseImagePixel::PixelRGB888, uint8_t>       ImageOut;
+
+  const size_t srcLineLength = ImageIn::RowType::calcLineLength(_srcWidth + 1);
+  const size_t dstLineLength = ImageOut::RowType::calcLineLength(_dstWidth);
+  vector<uint8_t> srcBuffer(srcLineLength*_srcHeight);
+  vector<uint8_t> dstBuffer(dstLineLength*_dstHeight);
+
+  const ImageIn srcImage(&srcBuffer.front(), srcBuffer.size(), _srcWidth, _srcHeight, srcLineLength);
+  ImageOut dstImage(&dstBuffer.front(), dstBuffer.size(), _dstWidth, _dstHeight, dstLineLength);
+  ImageAlgorithm<BaseImageAlgorithm::AlgoResampleBicubic, ImageIn, ImageOut> algorithm;
+  const bool passed = !algorithm(srcImage, dstImage);
+
+  cout << "YUV422 odd width refused " << _srcWidth << "x" << _srcHeight << " -> " << _dstWidth << "x" << _dstHeight
+       << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  64, 48, 37, 29);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  64, 47, 101, 75);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  64, 48, 32, 24);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  66, 48, 33, 24);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  2,  1,  1,  1);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  2,  1,  3,  2);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBicubic> ("YUV422 -> RGB888 bicubic",  ReferenceCubic,  6,  3,  1,  7);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBilinear>("YUV422 -> RGB888 bilinear", ReferenceLinear, 62, 47, 21, 15);
+  passed &= check<BaseImageAlgorithm::AlgoResampleBilinear>("YUV422 -> RGB888 bilinear", ReferenceLinear, 4,  2,  9,  5);
+  passed &= checkOddWidthRefused(63, 47, 100, 75);
+  passed &= checkOddWidthRefused(1,  1,  2,  2);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
@@ -0,0 +1,158 @@
+#include <sysexits.h>
+#include <stdint.h>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include <libimage/image.hpp>
+#include <libimage/image_algo.hpp>
+
+
+using namespace std;
+using namespace trik::libimage;
+
+
+/*
+ * Table YUV to RGB convertion against normalized float one, on bicubic interpolated YUV422 pixels.
+ * Interpolated components overshoot 0..255, and table path rounds them to half units before lookup,
+ * which keeps every channel within 1 LSB. Channels are read back through library unpack(), as RGB565X splits G between bytes.
+ */
+static const size_t s_samples = 200000;
+
+
+static void cubicWeights(float _t, float* _weights)
+{
+  _weights[0] = 0.5f * (        -1*_t +  2*_t*_t + -1*_t*_t*_t);
+  _weights[1] = 0.5f * (2             + -5*_t*_t +  3*_t*_t*_t);
+  _weights[2] = 0.5f * (         1*_t +  4*_t*_t + -3*_t*_t*_t);
+  _weights[3] = 0.5f * (                -1*_t*_t +  1*_t*_t*_t);
+}
+
+template <typename _Component>
+static void componentWeights(float _t, typename _Component::Weight* _weights)
+{
+  float weights[4];
+  cubicWeights(_t, weights);
+  for (size_t idx = 0; idx < 4; ++idx)
+    _weights[idx] = _Component::weight(weights[idx]);
+  _Component::fixupWeights(_weights, 4);
+}
+
+// RGB888 is packed into 3 bytes, RGB565 and RGB565X into 2
+template <typename _Pixel, bool _threeBytes = (_Pixel::s_rBits + _Pixel::s_gBits + _Pixel::s_bBits > 16)>
+class PixelBytes
+{
+  public:
+    static void pack(const _Pixel& _pixel, uint8_t* _bytes)   { _pixel.pack(_bytes[0], _bytes[1], _bytes[2]); }
+    static void unpack(_Pixel& _pixel, const uint8_t* _bytes) { _pixel.unpack(_bytes[0], _bytes[1], _bytes[2]); }
+};
+
+template <typename _Pixel>
+class PixelBytes<_Pixel, false>
+{
+  public:
+    static void pack(const _Pixel& _pixel, uint8_t* _bytes)   { _pixel.pack(_bytes[0], _bytes[1]); }
+    static void unpack(_Pixel& _pixel, const uint8_t* _bytes) { _pixel.unpack(_bytes[0], _bytes[1]); }
+};
+
+template <typename _Pixel>
+static void channels(const uint8_t* _bytes, unsigned* _rgb)
+{
+  _Pixel pixel;
+  PixelBytes<_Pixel>::unpack(pixel, _bytes);
+
+  float nr;
+  float ng;
+  float nb;
+  pixel.toNormalizedRGB(nr, ng, nb);
+  _rgb[0] = floorf(nr * ((1u << _Pixel::s_rBits) - 1) + 0.5f);
+  _rgb[1] = floorf(ng * ((1u << _Pixel::s_gBits) - 1) + 0.5f);
+  _rgb[2] = floorf(nb * ((1u << _Pixel::s_bBits) - 1) + 0.5f);
+}
+
+
+template <BaseImagePixel::PixelType _PT, typename _Component>
+static bool check(const char* _name, unsigned _toleranceLSB)
+{
+  typedef ImagePixel<BaseImagePixel::PixelYUV422, _Component> PixelYUV;
+  typedef ImagePixel<_PT, _Component> PixelRGB;
+  typedef ImagePixel<_PT, internal::ImagePixelComponentFloat> PixelRGBRead;
+
+  srand(1);
+  unsigned maxDiff = 0;
+  size_t overshoots = 0;
+
+  for (size_t sample = 0; sample < s_samples; ++sample)
+  {
+    typename _Component::Weight weightsH[4];
+    typename _Component::Weight weightsV[4];
+    componentWeights<_Component>(rand() / static_cast<float>(RAND_MAX), weightsH);
+    componentWeights<_Component>(rand() / static_cast<float>(RAND_MAX), weightsV);
+
+    // 4x4 window of extreme and random components, to provoke overshoot
+    PixelYUV yuv;
+    for (size_t row = 0; row < 4; ++row)
+    {
+      PixelYUV rowYUV;
+      for (size_t col = 0; col < 4; ++col)
+      {
+        PixelYUV src;
+        const bool extreme = rand() % 2;
+        src.unpack(static_cast<uint8_t>(extreme ? (rand() % 2) * 255 : rand() % 256),
+                   static_cast<uint8_t>(extreme ? (rand() % 2) * 255 : rand() % 256),
+                   static_cast<uint8_t>(extreme ? (rand() % 2) * 255 : rand() % 256));
+        rowYUV += src * weightsH[col];
+      }
+      yuv += rowYUV * weightsV[row];
+    }
+
+    int32_t y;
+    int32_t u;
+    int32_t v;
+    yuv.storeYUV(y, u, v, 0);
+    if (y < 0 || y > 255 || u < 0 || u > 255 || v < 0 || v > 255)
+      ++overshoots;
+
+    PixelRGB byTable;
+    PixelRGB byFloat;
+    ImagePixelConvertion<PixelYUV, PixelRGB>()(yuv, byTable);
+    internal::ImagePixelConvertionImpl<PixelYUV, PixelRGB, false>::convert(yuv, byFloat);
+
+    uint8_t bytesTable[3];
+    uint8_t bytesFloat[3];
+    PixelBytes<PixelRGB>::pack(byTable, bytesTable);
+    PixelBytes<PixelRGB>::pack(byFloat, bytesFloat);
+
+    unsigned rgbTable[3];
+    unsigned rgbFloat[3];
+    channels<PixelRGBRead>(bytesTable, rgbTable);
+    channels<PixelRGBRead>(bytesFloat, rgbFloat);
+
+    for (size_t idx = 0; idx < 3; ++idx)
+    {
+      const unsigned diff = rgbTable[idx] > rgbFloat[idx] ? rgbTable[idx] - rgbFloat[idx] : rgbFloat[idx] - rgbTable[idx];
+      if (diff > maxDiff)
+        maxDiff = diff;
+    }
+  }
+
+  const bool passed = maxDiff <= _toleranceLSB && overshoots > 0;
+  cout << _name << ": max diff " << maxDiff << " LSB, " << overshoots << " of " << s_samples << " samples overshoot"
+       << (passed ? "" : " FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= check<BaseImagePixel::PixelRGB565,  internal::ImagePixelComponentFloat>("YUV422 -> RGB565 float", 1);
+  passed &= check<BaseImagePixel::PixelRGB565X, internal::ImagePixelComponentFloat>("YUV422 -> RGB565X float", 1);
+  passed &= check<BaseImagePixel::PixelRGB888,  internal::ImagePixelComponentFloat>("YUV422 -> RGB888 float", 1);
+  passed &= check<BaseImagePixel::PixelRGB565,  internal::ImagePixelComponentFixed>("YUV422 -> RGB565 fixed", 1);
+  passed &= check<BaseImagePixel::PixelRGB565X, internal::ImagePixelComponentFixed>("YUV422 -> RGB565X fixed", 1);
+  passed &= check<BaseImagePixel::PixelRGB888,  internal::ImagePixelComponentFixed>("YUV422 -> RGB888 fixed", 1);
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
@@ -10,6 +10,8 @@
 #endif
 
 #include <limits.h>
+#include <stddef.h>
+#include <string.h>
 
 #include "trik_vidtranscode_resample.h"
 #include "internal/vidtranscode_resample_iface.h"
@@ -89,8 +91,14 @@ Int TRIK_VIDTRANSCODE_RESAMPLE_alloc(
     algMemTab[0].space		= IALG_EXTERNAL;
     algMemTab[0].attrs		= IALG_PERSIST;
 
+    /* Resample state kept between frames, with plans and scratch rows for maximum geometry of algParams */
+    algMemTab[1].size		= resampleCacheSize((const TRIK_VIDTRANSCODE_RESAMPLE_Params*)algParams);
+    algMemTab[1].alignment	= resampleCacheAlignment();
+    algMemTab[1].space		= IALG_EXTERNAL;
+    algMemTab[1].attrs		= IALG_PERSIST;
+
     /* Return the number of records in the memTab */
-    return 1;
+    return 2;
 }
 
 
@@ -114,8 +122,17 @@ Int TRIK_VIDTRANSCODE_RESAMPLE_free(
     algMemTab[0].space		= IALG_EXTERNAL;
     algMemTab[0].attrs		= IALG_PERSIST;
 
+    algMemTab[1].base		= handle->m_cacheMemory;
+    algMemTab[1].size		= handle->m_cacheMemorySize;
+    algMemTab[1].alignment	= resampleCacheAlignment();
+    algMemTab[1].space		= IALG_EXTERNAL;
+    algMemTab[1].attrs		= IALG_PERSIST;
+
+    resampleCacheDestroy(handle->m_cache);
+    handle->m_cache = NULL;
+
     /* Return the number of records in the memTab */
-    return 1;
+    return 2;
 }
 
 
@@ -138,10 +155,20 @@ Int TRIK_VIDTRANSCODE_RESAMPLE_initObj(
 
     handle->m_params = *params;
     handle->m_dynamicParams = *getDefaultDynamicParams();
+    handle->m_cacheMemory = algMemTab[1].base;
+    handle->m_cacheMemorySize = algMemTab[1].size;
+    handle->m_cache = NULL;
     handleBuildDynamicParams(handle);
     if (!handleVerifyParams(handle))
         return IALG_EFAIL;
 
+    handle->m_cache = resampleCacheCreate(handle->m_cacheMemory, handle->m_cacheMemorySize);
+    if (handle->m_cache == NULL)
+        return IALG_EFAIL;
+
+    /* Plans are built now rather than on first frame; geometry which fails here is reported by process */
+    handlePrepareResample(handle);
+
     return IALG_EOK;
 }
 
@@ -204,6 +231,13 @@ XDAS_Int32 TRIK_VIDTRANSCODE_RESAMPLE_process(
     vidOutArgs->decodedWidth			= handle->m_dynamicParams.inputWidth;
 
 
+    TrikVideoResampleOutput outputs[IVIDTRANSCODE_MAXOUTSTREAMS];
+    if (handle->m_params.base.numOutputStreams > IVIDTRANSCODE_MAXOUTSTREAMS)
+    {
+        XDM_SETUNSUPPORTEDPARAM(vidOutArgs->extendedError);
+        return IVIDTRANSCODE_EFAIL;
+    }
+
     XDAS_Int32 outBufIndex;
     for (outBufIndex = 0; outBufIndex < handle->m_params.base.numOutputStreams; ++outBufIndex)
     {
@@ -219,32 +253,39 @@ XDAS_Int32 TRIK_VIDTRANSCODE_RESAMPLE_process(
             return IVIDTRANSCODE_EFAIL;
         }
 
-        XDAS_Int32 outBufFormat;
-        XDAS_Int32 outBufHeight;
-        XDAS_Int32 outBufWidth;
-        XDAS_Int32 outBufLineLength;
+        TrikVideoResampleOutput* output = &outputs[outBufIndex];
+        output->m_buf		= xdmOutBuf->buf;
+        output->m_bufSize	= xdmOutBuf->bufSize;
+        output->m_bufUsed	= 0;
 
-        if (!handlePickOutputParams(handle, outBufIndex, &outBufFormat, &outBufHeight, &outBufWidth, &outBufLineLength))
+        if (!handlePickOutputParams(handle, outBufIndex, &output->m_format, &output->m_height, &output->m_width,
+                                    &output->m_lineLength, &output->m_algorithm))
         {
             XDM_SETUNSUPPORTEDPARAM(vidOutArgs->extendedError);
             return IVIDTRANSCODE_EFAIL;
         }
+    }
 
-        XDAS_Int32 outBufUsed = 0;
-        TrikVideoResampleStatus result = resampleBuffer(xdmInBuf->buf, vidInArgs->numBytes,
-                                                        inBufFormat, inBufHeight, inBufWidth, inBufLineLength,
-                                                        xdmOutBuf->buf, xdmOutBuf->bufSize, &outBufUsed,
-                                                        outBufFormat, outBufHeight, outBufWidth, outBufLineLength);
-        switch (result)
-        {
-            case TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK:
-                break;
+    /* input is unpacked once for all outputs which can share it */
+    TrikVideoResampleStatus result = resampleBufferMulti(xdmInBuf->buf, vidInArgs->numBytes,
+                                                         inBufFormat, inBufHeight, inBufWidth, inBufLineLength,
+                                                         outputs, handle->m_params.base.numOutputStreams,
+                                                         handle->m_cache);
+    switch (result)
+    {
+        case TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK:
+            break;
 
-            // TODO other statuses
-            default:
-                XDM_SETCORRUPTEDDATA(vidOutArgs->extendedError);
-                return IVIDTRANSCODE_EFAIL;
-        }
+        // TODO other statuses
+        default:
+            XDM_SETCORRUPTEDDATA(vidOutArgs->extendedError);
+            return IVIDTRANSCODE_EFAIL;
+    }
+
+    for (outBufIndex = 0; outBufIndex < handle->m_params.base.numOutputStreams; ++outBufIndex)
+    {
+        XDM1_SingleBufDesc* xdmOutBuf = &vidOutArgs->encodedBuf[outBufIndex];
+        XDAS_Int32 outBufUsed = outputs[outBufIndex].m_bufUsed;
 
         XDM_SETACCESSMODE_WRITE(xdmOutBuf->accessMask);
 
@@ -305,8 +346,20 @@ XDAS_Int32 TRIK_VIDTRANSCODE_RESAMPLE_control(
                 handle->m_dynamicParams = *((TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams*)vidDynParams);
                 retVal = handleVerifyParams(handle) ? IVIDTRANSCODE_EOK : IVIDTRANSCODE_EFAIL;
             }
+            else if (vidDynParams->size == offsetof(TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams, outputAlgorithm))
+            {
+                /* extended params of clients built before outputAlgorithm was added */
+                XDAS_Int32 outIndex;
+                memcpy(&handle->m_dynamicParams, vidDynParams, vidDynParams->size);
+                for (outIndex = 0; outIndex < IVIDTRANSCODE_MAXOUTSTREAMS; ++outIndex)
+                    handle->m_dynamicParams.outputAlgorithm[outIndex] = TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO;
+                retVal = handleVerifyParams(handle) ? IVIDTRANSCODE_EOK : IVIDTRANSCODE_EFAIL;
+            }
             else
                 retVal = IVIDTRANSCODE_EUNSUPPORTED;
+
+            if (retVal == IVIDTRANSCODE_EOK)
+                handlePrepareResample(handle);
             break;
 
         case XDM_RESET:
@@ -315,6 +368,9 @@ XDAS_Int32 TRIK_VIDTRANSCODE_RESAMPLE_control(
             handle->m_dynamicParams = *getDefaultDynamicParams();
             handleBuildDynamicParams(handle);
             retVal = handleVerifyParams(handle) ? IVIDTRANSCODE_EOK : IVIDTRANSCODE_EFAIL;
+
+            if (retVal == IVIDTRANSCODE_EOK)
+                handlePrepareResample(handle);
             break;
 
         case XDM_FLUSH:
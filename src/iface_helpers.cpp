@@ -2,11 +2,13 @@
 
 #include <algorithm>
 #include <cstring>
+#include <new>
 
 #include "internal/vidtranscode_resample_iface.h"
 #include "internal/vidtranscode_resample_helpers.h"
 #include <libimage/image.hpp>
 #include <libimage/image_algo.hpp>
+#include <libimage/image_memory.hpp>
 
 
 static const char s_trikVideoResampleVersion[] = "1.00.00.00";
@@ -113,6 +115,10 @@ const TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams* getDefaultDynamicParams(void)
     {
       -1,							/* outputLineLength - default, to be calculated base on width */
       -1,							/* outputLineLength - default, to be calculated base on width */
+    },
+    {
+      TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO,		/* outputAlgorithm - pick by scale factor */
+      TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO,		/* outputAlgorithm - pick by scale factor */
     }
   };
 
@@ -126,8 +132,13 @@ void handleBuildDynamicParams(TrikVideoResampleHandle* _handle)
   _handle->m_dynamicParams.inputWidth  = _handle->m_params.base.maxWidthInput;
   _handle->m_dynamicParams.inputLineLength = -1;
 
-  for (XDAS_Int32 outIndex = 0; outIndex < _handle->m_params.base.numOutputStreams; ++outIndex)
+  // runs before handleVerifyParams(), so stream count is not trusted yet
+  const XDAS_Int32 outputsCount = std::min<XDAS_Int32>(_handle->m_params.base.numOutputStreams, IVIDTRANSCODE_MAXOUTSTREAMS);
+  for (XDAS_Int32 outIndex = 0; outIndex < outputsCount; ++outIndex)
+  {
     _handle->m_dynamicParams.outputLineLength[outIndex] = -1;
+    _handle->m_dynamicParams.outputAlgorithm[outIndex] = TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO;
+  }
 }
 
 
@@ -140,9 +151,15 @@ bool handleVerifyParams(const TrikVideoResampleHandle* _handle)
       || _handle->m_dynamicParams.inputWidth < 0)
     return false;
 
-  if (_handle->m_params.base.numOutputStreams < 0)
+  if (   _handle->m_params.base.numOutputStreams < 0
+      || _handle->m_params.base.numOutputStreams > IVIDTRANSCODE_MAXOUTSTREAMS)
     return false;
 
+  for (XDAS_Int32 outIndex = 0; outIndex < _handle->m_params.base.numOutputStreams; ++outIndex)
+    if (   _handle->m_dynamicParams.outputAlgorithm[outIndex] < TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO
+        || _handle->m_dynamicParams.outputAlgorithm[outIndex] > TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3)
+      return false;
+
   return true;
 }
 
@@ -152,7 +169,8 @@ bool handlePickOutputParams(const TrikVideoResampleHandle*	_handle,
                             XDAS_Int32* restrict		_iFormat,
                             XDAS_Int32* restrict		_iHeight,
                             XDAS_Int32* restrict		_iWidth,
-                            XDAS_Int32* restrict		_iLineLength)
+                            XDAS_Int32* restrict		_iLineLength,
+                            XDAS_Int32* restrict		_iAlgorithm)
 {
   if (   _handle == NULL
       || _iStreamIndex < 0
@@ -160,6 +178,7 @@ bool handlePickOutputParams(const TrikVideoResampleHandle*	_handle,
     return false;
 
   *_iFormat		= _handle->m_params.base.formatOutput[_iStreamIndex];
+  *_iAlgorithm		= _handle->m_dynamicParams.outputAlgorithm[_iStreamIndex];
 
   if (_handle->m_dynamicParams.base.keepInputResolutionFlag[_iStreamIndex])
   {
@@ -219,11 +238,230 @@ static bool convertVideoFormat(XDAS_Int32 _iFormat, trik::libimage::BaseImagePix
     case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565X: _pixelType = trik::libimage::BaseImagePixel::PixelRGB565X; return true;
     case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422:  _pixelType = trik::libimage::BaseImagePixel::PixelYUV422;  return true;
     case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV444:  _pixelType = trik::libimage::BaseImagePixel::PixelYUV444;  return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_GRAY8:   _pixelType = trik::libimage::BaseImagePixel::PixelGRAY8;   return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGBA8888: _pixelType = trik::libimage::BaseImagePixel::PixelRGBA8888; return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_BGRA8888: _pixelType = trik::libimage::BaseImagePixel::PixelBGRA8888; return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_XRGB8888: _pixelType = trik::libimage::BaseImagePixel::PixelXRGB8888; return true;
+    default: return false;
+  }
+}
+
+static bool convertVideoFormat(XDAS_Int32 _iFormat, trik::libimage::BaseImagePlanar::PlanarType& _planarType)
+{
+  switch (_iFormat)
+  {
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV12: _planarType = trik::libimage::BaseImagePlanar::PlanarNV12; return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV21: _planarType = trik::libimage::BaseImagePlanar::PlanarNV21; return true;
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_I420: _planarType = trik::libimage::BaseImagePlanar::PlanarI420; return true;
     default: return false;
   }
 }
 
 
+/*
+ * Algorithm objects are kept between frames, so resample plans and scratch rows are built on the first frame
+ * and only reused afterwards: steady state allocates nothing. Slot holds one object of any type and replaces it
+ * when a frame needs another one, i.e. after format or algorithm change.
+ */
+class ResampleCacheObject
+{
+  public:
+    virtual ~ResampleCacheObject() {}
+    virtual const void* type() const = 0;
+};
+
+template <typename _Object>
+class ResampleCacheObjectImpl : public ResampleCacheObject
+{
+  public:
+    explicit ResampleCacheObjectImpl(trik::libimage::ImageMemoryArena* _arena)
+     :m_object(_arena)
+    {
+    }
+
+    virtual const void* type() const
+    {
+      return typeTag();
+    }
+
+    // address unique per instantiation, no RTTI needed
+    static const void* typeTag()
+    {
+      static const char s_tag = 0;
+      return &s_tag;
+    }
+
+    _Object m_object;
+};
+
+class ResampleCacheSlot : private trik::noncopyable
+{
+  public:
+    ResampleCacheSlot()
+     :m_allocator(),
+      m_object(NULL),
+      m_memory(NULL)
+    {
+    }
+
+    ~ResampleCacheSlot()
+    {
+      reset();
+    }
+
+    // object, its plans and scratch rows are placed in given arena, i.e. in cache memory; NULL is heap
+    void arena(trik::libimage::ImageMemoryArena* _arena)
+    {
+      reset();
+      m_allocator = trik::libimage::ImageAllocator<XDAS_UInt8>(_arena);
+    }
+
+    template <typename _Object>
+    _Object& get()
+    {
+      typedef ResampleCacheObjectImpl<_Object> Impl;
+      if (m_object == NULL || m_object->type() != Impl::typeTag())
+      {
+        reset();
+        m_memory = m_allocator.allocate(sizeof(Impl));
+        m_object = new (m_memory) Impl(m_allocator.arena());
+      }
+
+      return static_cast<Impl*>(m_object)->m_object;
+    }
+
+    void reset()
+    {
+      if (m_object == NULL)
+        return;
+
+      m_object->~ResampleCacheObject();
+      m_allocator.deallocate(m_memory, 0);
+      m_object = NULL;
+      m_memory = NULL;
+    }
+
+  private:
+    trik::libimage::ImageAllocator<XDAS_UInt8> m_allocator;
+    ResampleCacheObject*                       m_object;
+    XDAS_UInt8*                                m_memory;
+};
+
+/*
+ * Slots are followed by arena over the rest of memTab record, slot objects with their plans and scratch rows
+ * are allocated there; arena belongs to this instance only, so instances are independent of each other.
+ */
+struct TrikVideoResampleCache
+{
+  TrikVideoResampleCache(void* _arenaMemory, size_t _arenaSize)
+   :m_arena(_arenaMemory, _arenaSize),
+    m_streams(),
+    m_shared(),
+    m_multi()
+  {
+    for (XDAS_Int32 outIndex = 0; outIndex < IVIDTRANSCODE_MAXOUTSTREAMS; ++outIndex)
+    {
+      m_streams[outIndex].arena(&m_arena);
+      m_shared[outIndex].arena(&m_arena);
+    }
+    m_multi.arena(&m_arena);
+  }
+
+  trik::libimage::ImageMemoryArena m_arena;	// declared first, so slots release into it before it goes
+  ResampleCacheSlot m_streams[IVIDTRANSCODE_MAXOUTSTREAMS];	// resampleBuffer() of every output stream
+  ResampleCacheSlot m_shared[IVIDTRANSCODE_MAXOUTSTREAMS];	// outputs of single pass of resampleBufferMulti()
+  ResampleCacheSlot m_multi;
+};
+
+
+static size_t resampleCacheHeaderSize()
+{
+  return trik::alignSize(sizeof(TrikVideoResampleCache), trik::libimage::ImageMemoryArena::s_alignment);
+}
+
+/*
+ * Estimate of arena usage by one output stream, not a derived bound: plans of both dimensions, ring of horizontally
+ * resampled rows and unpacked or decoded input rows, for widest kernel (Lanczos-3) and largest unpacked pixel
+ * (4 floats). Constant part is an allowance for algorithm objects themselves and block headers. Estimate is checked
+ * against resampleCachePeak() over all formats and algorithms at maximum geometry by tests/steady_state_alloc.cpp.
+ */
+static size_t resampleStreamArenaSize(size_t _inWidth, size_t _outWidth, size_t _outHeight)
+{
+  static const size_t s_planEntrySize = sizeof(size_t) + 6*sizeof(float);
+  static const size_t s_pixelSize     = 4*sizeof(float);
+  static const size_t s_ringRows      = 6;
+  static const size_t s_inputRows     = 2;
+  static const size_t s_objectsSize   = 4096;
+
+  return s_planEntrySize * (_outWidth + _outHeight)
+       + s_pixelSize * (s_ringRows*_outWidth + s_inputRows*(_inWidth + s_ringRows))
+       + s_objectsSize;
+}
+
+size_t resampleCacheSize(const TRIK_VIDTRANSCODE_RESAMPLE_Params* _params)
+{
+  if (_params == NULL)
+    _params = getDefaultParams();
+
+  const size_t inWidth  = std::max<XDAS_Int32>(_params->base.maxWidthInput, 0);
+  const size_t inHeight = std::max<XDAS_Int32>(_params->base.maxHeightInput, 0);
+  const size_t streams  = std::min<XDAS_Int32>(std::max<XDAS_Int32>(_params->base.numOutputStreams, 0),
+                                               IVIDTRANSCODE_MAXOUTSTREAMS);
+
+  // output kept at input resolution is bounded by input maximums, not output ones
+  size_t arenaSize = 0;
+  for (size_t outIndex = 0; outIndex < streams; ++outIndex)
+    arenaSize += resampleStreamArenaSize(inWidth,
+                                         std::max<size_t>(std::max<XDAS_Int32>(_params->base.maxWidthOutput[outIndex], 0), inWidth),
+                                         std::max<size_t>(std::max<XDAS_Int32>(_params->base.maxHeightOutput[outIndex], 0), inHeight));
+
+  // unpacked input row shared by outputs of single pass
+  arenaSize += resampleStreamArenaSize(inWidth, 0, 0);
+
+  return resampleCacheHeaderSize() + arenaSize;
+}
+
+
+size_t resampleCacheAlignment(void)
+{
+  return trik::libimage::ImageMemoryArena::s_alignment;
+}
+
+TrikVideoResampleCache* resampleCacheCreate(void* _memory, size_t _size)
+{
+  if (_memory == NULL || _size < resampleCacheHeaderSize())
+    return NULL;
+
+  return new (_memory) TrikVideoResampleCache(static_cast<XDAS_UInt8*>(_memory) + resampleCacheHeaderSize(),
+                                              _size - resampleCacheHeaderSize());
+}
+
+size_t resampleCachePeak(const TrikVideoResampleCache* _cache)
+{
+  return _cache == NULL ? 0 : resampleCacheHeaderSize() + _cache->m_arena.peak();
+}
+
+// memory is not freed, it belongs to caller
+void resampleCacheDestroy(TrikVideoResampleCache* _cache)
+{
+  if (_cache == NULL)
+    return;
+
+  _cache->~TrikVideoResampleCache();
+}
+
+// drops objects of shared pass when no longer used, see resampleBufferSharedImpl
+static void resampleCacheResetShared(TrikVideoResampleCache* _cache)
+{
+  if (_cache == NULL)
+    return;
+
+  for (XDAS_Int32 outIndex = 0; outIndex < IVIDTRANSCODE_MAXOUTSTREAMS; ++outIndex)
+    _cache->m_shared[outIndex].reset();
+  _cache->m_multi.reset();
+}
+
+
 template <trik::libimage::BaseImagePixel::PixelType         _PixelTypeSrc,
           trik::libimage::BaseImagePixel::PixelType         _PixelTypeDst,
           trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
@@ -236,7 +474,8 @@ static bool resampleBufferImpl(const XDAS_UInt8* restrict _inBuffer,
                                size_t&                    _outBufferSize,
                                const size_t&              _outWidth,
                                const size_t&              _outHeight,
-                               const size_t&              _outLineLength)
+                               const size_t&              _outLineLength,
+                               ResampleCacheSlot&         _slot)
 {
   typedef trik::libimage::Image<_PixelTypeSrc, const XDAS_UInt8> ImageSrc;
   typedef trik::libimage::Image<_PixelTypeDst, XDAS_UInt8>       ImageDst;
@@ -245,7 +484,151 @@ static bool resampleBufferImpl(const XDAS_UInt8* restrict _inBuffer,
   ImageSrc imageSrc(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength);
   ImageDst imageDst(_outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength);
 
-  Algorithm algorithm;
+  Algorithm& algorithm = _slot.get<Algorithm>();
+  if (_inBuffer == NULL) // plan only, see handlePrepareResample()
+    return algorithm.prepare(_inWidth, _inHeight, _outWidth, _outHeight);
+
+  if (!algorithm(imageSrc, imageDst))
+    return false;
+
+  _outBufferSize = imageDst.actualImageSize();
+  return true;
+}
+
+template <trik::libimage::BaseImagePlanar::PlanarType        _PlanarTypeSrc,
+          trik::libimage::BaseImagePlanar::PlanarType        _PlanarTypeDst,
+          trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static bool resamplePlanarBufferImpl(const XDAS_UInt8* restrict _inBuffer,
+                                     const size_t&              _inBufferSize,
+                                     const size_t&              _inWidth,
+                                     const size_t&              _inHeight,
+                                     const size_t&              _inLineLength,
+                                     XDAS_UInt8* restrict       _outBuffer,
+                                     size_t&                    _outBufferSize,
+                                     const size_t&              _outWidth,
+                                     const size_t&              _outHeight,
+                                     const size_t&              _outLineLength,
+                                     ResampleCacheSlot&         _slot)
+{
+  typedef trik::libimage::ImagePlanar<_PlanarTypeSrc, const XDAS_UInt8> ImageSrc;
+  typedef trik::libimage::ImagePlanar<_PlanarTypeDst, XDAS_UInt8>       ImageDst;
+  typedef trik::libimage::ImageAlgorithm<_Algorithm, ImageSrc, ImageDst> Algorithm;
+
+  ImageSrc imageSrc(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength);
+  ImageDst imageDst(_outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength);
+
+  Algorithm& algorithm = _slot.get<Algorithm>();
+  if (_inBuffer == NULL) // plan only, see handlePrepareResample()
+    return algorithm.prepare(_inWidth, _inHeight, _outWidth, _outHeight);
+
+  if (!algorithm(imageSrc, imageDst))
+    return false;
+
+  _outBufferSize = imageDst.actualImageSize();
+  return true;
+}
+
+template <trik::libimage::BaseImagePlanar::PlanarType        _PlanarTypeSrc,
+          trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static bool resamplePlanarBufferDstImpl(const XDAS_UInt8* restrict _inBuffer,
+                                        const size_t&              _inBufferSize,
+                                        const size_t&              _inWidth,
+                                        const size_t&              _inHeight,
+                                        const size_t&              _inLineLength,
+                                        XDAS_UInt8* restrict       _outBuffer,
+                                        size_t&                    _outBufferSize,
+                                        const trik::libimage::BaseImagePlanar::PlanarType& _outPlanarType,
+                                        const size_t&              _outWidth,
+                                        const size_t&              _outHeight,
+                                        const size_t&              _outLineLength,
+                                        ResampleCacheSlot&         _slot)
+{
+  switch (_outPlanarType)
+  {
+    case trik::libimage::BaseImagePlanar::PlanarNV12:
+      return resamplePlanarBufferImpl<_PlanarTypeSrc, trik::libimage::BaseImagePlanar::PlanarNV12,
+                                      _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                  _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+    case trik::libimage::BaseImagePlanar::PlanarNV21:
+      return resamplePlanarBufferImpl<_PlanarTypeSrc, trik::libimage::BaseImagePlanar::PlanarNV21,
+                                      _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                  _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+    case trik::libimage::BaseImagePlanar::PlanarI420:
+      return resamplePlanarBufferImpl<_PlanarTypeSrc, trik::libimage::BaseImagePlanar::PlanarI420,
+                                      _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                  _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+    default:
+      return false;
+  }
+}
+
+// any planar layout to any other, planes are resampled separately so layouts do not multiply the work
+template <trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static TrikVideoResampleStatus resamplePlanarBufferAlgorithmImpl(const XDAS_UInt8* restrict _inBuffer,
+                                                                 const size_t&              _inBufferSize,
+                                                                 const trik::libimage::BaseImagePlanar::PlanarType& _inPlanarType,
+                                                                 const size_t&              _inWidth,
+                                                                 const size_t&              _inHeight,
+                                                                 const size_t&              _inLineLength,
+                                                                 XDAS_UInt8* restrict       _outBuffer,
+                                                                 size_t&                    _outBufferSize,
+                                                                 const trik::libimage::BaseImagePlanar::PlanarType& _outPlanarType,
+                                                                 const size_t&              _outWidth,
+                                                                 const size_t&              _outHeight,
+                                                                 const size_t&              _outLineLength,
+                                                                 ResampleCacheSlot&         _slot)
+{
+  bool isOk;
+  switch (_inPlanarType)
+  {
+    case trik::libimage::BaseImagePlanar::PlanarNV12:
+      isOk = resamplePlanarBufferDstImpl<trik::libimage::BaseImagePlanar::PlanarNV12,
+                                         _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                     _outBuffer, _outBufferSize, _outPlanarType,
+                                                     _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+    case trik::libimage::BaseImagePlanar::PlanarNV21:
+      isOk = resamplePlanarBufferDstImpl<trik::libimage::BaseImagePlanar::PlanarNV21,
+                                         _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                     _outBuffer, _outBufferSize, _outPlanarType,
+                                                     _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+    case trik::libimage::BaseImagePlanar::PlanarI420:
+      isOk = resamplePlanarBufferDstImpl<trik::libimage::BaseImagePlanar::PlanarI420,
+                                         _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                     _outBuffer, _outBufferSize, _outPlanarType,
+                                                     _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+    default:
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INCOMPATIBLE_FORMATS;
+  }
+
+  return isOk ? TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK : TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+}
+
+template <typename                                          _ImageSrc,
+          trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static bool resampleGrayBufferImpl(const XDAS_UInt8* restrict _inBuffer,
+                                   const size_t&              _inBufferSize,
+                                   const size_t&              _inWidth,
+                                   const size_t&              _inHeight,
+                                   const size_t&              _inLineLength,
+                                   XDAS_UInt8* restrict       _outBuffer,
+                                   size_t&                    _outBufferSize,
+                                   const size_t&              _outWidth,
+                                   const size_t&              _outHeight,
+                                   const size_t&              _outLineLength,
+                                   ResampleCacheSlot&         _slot)
+{
+  typedef trik::libimage::Image<trik::libimage::BaseImagePixel::PixelGRAY8, XDAS_UInt8> ImageDst;
+  typedef trik::libimage::ImageAlgorithm<_Algorithm, _ImageSrc, ImageDst>              Algorithm;
+
+  _ImageSrc imageSrc(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength);
+  ImageDst  imageDst(_outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength);
+
+  Algorithm& algorithm = _slot.get<Algorithm>();
+  if (_inBuffer == NULL) // plan only, see handlePrepareResample()
+    return algorithm.prepare(_inWidth, _inHeight, _outWidth, _outHeight);
 
   if (!algorithm(imageSrc, imageDst))
     return false;
@@ -254,67 +637,221 @@ static bool resampleBufferImpl(const XDAS_UInt8* restrict _inBuffer,
   return true;
 }
 
+// GRAY8 is produced from luma of any input, packed or planar, chroma is never read
+template <trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static TrikVideoResampleStatus resampleGrayBufferAlgorithmImpl(const XDAS_UInt8* restrict _inBuffer,
+                                                               const size_t&              _inBufferSize,
+                                                               XDAS_Int32                 _iInFormat,
+                                                               const size_t&              _inWidth,
+                                                               const size_t&              _inHeight,
+                                                               const size_t&              _inLineLength,
+                                                               XDAS_UInt8* restrict       _outBuffer,
+                                                               size_t&                    _outBufferSize,
+                                                               const size_t&              _outWidth,
+                                                               const size_t&              _outHeight,
+                                                               const size_t&              _outLineLength,
+                                                               ResampleCacheSlot&         _slot)
+{
+  using trik::libimage::Image;
+  using trik::libimage::ImagePlanar;
+  using trik::libimage::BaseImagePixel;
+  using trik::libimage::BaseImagePlanar;
+
+  bool isOk;
+  switch (_iInFormat)
+  {
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB888:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelRGB888,  const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelRGB565,  const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565X:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelRGB565X, const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV444:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelYUV444,  const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelYUV422,  const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_GRAY8:
+      isOk = resampleGrayBufferImpl<Image<BaseImagePixel::PixelGRAY8,   const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                       _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV12:
+      isOk = resampleGrayBufferImpl<ImagePlanar<BaseImagePlanar::PlanarNV12, const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                            _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV21:
+      isOk = resampleGrayBufferImpl<ImagePlanar<BaseImagePlanar::PlanarNV21, const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                            _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_I420:
+      isOk = resampleGrayBufferImpl<ImagePlanar<BaseImagePlanar::PlanarI420, const XDAS_UInt8>, _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                                                                                            _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot);
+      break;
+
+    default:
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INCOMPATIBLE_FORMATS;
+  }
+
+  return isOk ? TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK : TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+}
+
 template <trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
 static TrikVideoResampleStatus resampleBufferAlgorithmImpl(const XDAS_UInt8* restrict _inBuffer,
                                                            const size_t&              _inBufferSize,
-                                                           const trik::libimage::BaseImagePixel::PixelType& _inPixelType,
+                                                           XDAS_Int32                 _iInFormat,
                                                            const size_t&              _inWidth,
                                                            const size_t&              _inHeight,
                                                            const size_t&              _inLineLength,
                                                            XDAS_UInt8* restrict       _outBuffer,
                                                            size_t&                    _outBufferSize,
-                                                           const trik::libimage::BaseImagePixel::PixelType& _outPixelType,
+                                                           XDAS_Int32                 _iOutFormat,
                                                            const size_t&              _outWidth,
                                                            const size_t&              _outHeight,
-                                                           const size_t&              _outLineLength)
+                                                           const size_t&              _outLineLength,
+                                                           ResampleCacheSlot&         _slot)
 {
+  if (_iOutFormat == TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_GRAY8)
+    return resampleGrayBufferAlgorithmImpl<_Algorithm>(_inBuffer,  _inBufferSize,  _iInFormat,
+                                                       _inWidth,  _inHeight,  _inLineLength,
+                                                       _outBuffer, _outBufferSize,
+                                                       _outWidth, _outHeight, _outLineLength, _slot);
+
+  trik::libimage::BaseImagePlanar::PlanarType inPlanarType;
+  trik::libimage::BaseImagePlanar::PlanarType outPlanarType;
+  const bool inPlanar  = convertVideoFormat(_iInFormat,  inPlanarType);
+  const bool outPlanar = convertVideoFormat(_iOutFormat, outPlanarType);
+  if (inPlanar && outPlanar)
+    return resamplePlanarBufferAlgorithmImpl<_Algorithm>(_inBuffer,  _inBufferSize,  inPlanarType,
+                                                         _inWidth,  _inHeight,  _inLineLength,
+                                                         _outBuffer, _outBufferSize, outPlanarType,
+                                                         _outWidth, _outHeight, _outLineLength, _slot);
+
+  trik::libimage::BaseImagePixel::PixelType inPixelType;
+  trik::libimage::BaseImagePixel::PixelType outPixelType;
+  if (   inPlanar || outPlanar
+      || !convertVideoFormat(_iInFormat,  inPixelType)
+      || !convertVideoFormat(_iOutFormat, outPixelType))
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INCOMPATIBLE_FORMATS;
+
   // YUV422 camera -> RGB565X (trik lcd)
-  if (        _inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
-           && _outPixelType == trik::libimage::BaseImagePixel::PixelRGB565X)
+  if (        inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGB565X)
   {
     if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelYUV422,
                             trik::libimage::BaseImagePixel::PixelRGB565X,
                             _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
-                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength))
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
       return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
   }
   // YUV422 camera -> RGB888 plane
-  else if (   _inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
-           && _outPixelType == trik::libimage::BaseImagePixel::PixelRGB888)
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGB888)
   {
     if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelYUV422,
                             trik::libimage::BaseImagePixel::PixelRGB888,
                             _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
-                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength))
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
       return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
   }
   // RGB888 compat camera -> RGB565X (trik lcd)
-  else if (   _inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
-           && _outPixelType == trik::libimage::BaseImagePixel::PixelRGB565X)
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGB565X)
   {
     if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
                             trik::libimage::BaseImagePixel::PixelRGB565X,
                             _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
-                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength))
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
       return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
   }
   // For testing purposes
-  else if (   _inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
-           && _outPixelType == trik::libimage::BaseImagePixel::PixelRGB888)
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGB888)
   {
     if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
                             trik::libimage::BaseImagePixel::PixelRGB888,
                             _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
-                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength))
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
       return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
   }
-  else if (   _inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
-           && _outPixelType == trik::libimage::BaseImagePixel::PixelRGB565)
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGB565)
   {
     if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
                             trik::libimage::BaseImagePixel::PixelRGB565,
                             _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
-                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength))
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  // 32-bit framebuffer and compositor upload, no separate expansion pass
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGBA8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelYUV422,
+                            trik::libimage::BaseImagePixel::PixelRGBA8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
+           && outPixelType == trik::libimage::BaseImagePixel::PixelBGRA8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelYUV422,
+                            trik::libimage::BaseImagePixel::PixelBGRA8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelYUV422
+           && outPixelType == trik::libimage::BaseImagePixel::PixelXRGB8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelYUV422,
+                            trik::libimage::BaseImagePixel::PixelXRGB8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelRGBA8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
+                            trik::libimage::BaseImagePixel::PixelRGBA8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelBGRA8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
+                            trik::libimage::BaseImagePixel::PixelBGRA8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+  }
+  else if (   inPixelType  == trik::libimage::BaseImagePixel::PixelRGB888
+           && outPixelType == trik::libimage::BaseImagePixel::PixelXRGB8888)
+  {
+    if (!resampleBufferImpl<trik::libimage::BaseImagePixel::PixelRGB888,
+                            trik::libimage::BaseImagePixel::PixelXRGB8888,
+                            _Algorithm>(_inBuffer,  _inBufferSize,  _inWidth,  _inHeight,  _inLineLength,
+                                        _outBuffer, _outBufferSize, _outWidth, _outHeight, _outLineLength, _slot))
       return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
   }
   else
@@ -324,6 +861,137 @@ static TrikVideoResampleStatus resampleBufferAlgorithmImpl(const XDAS_UInt8* res
 }
 
 
+static XDAS_Int32 pickAlgorithm(XDAS_Int32 _iAlgorithm,
+                                const size_t& _inWidth,  const size_t& _inHeight,
+                                const size_t& _outWidth, const size_t& _outHeight)
+{
+  if (_iAlgorithm != TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO)
+    return _iAlgorithm;
+
+  // bicubic aliases and wastes work on skipped input when reducing twice or more, integrate over area instead
+  if (_outWidth*2 <= _inWidth && _outHeight*2 <= _inHeight)
+    return TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AREA;
+  else
+    return TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC;
+}
+
+
+// NULL input buffer only builds plans in slot, output buffer is not accessed then
+static TrikVideoResampleStatus resampleBufferStream(const XDAS_Int8* restrict	_iInBuf,
+                                                    XDAS_Int32			_iInBufSize,
+                                                    XDAS_Int32			_iInFormat,
+                                                    XDAS_Int32			_iInHeight,
+                                                    XDAS_Int32			_iInWidth,
+                                                    XDAS_Int32			_iInLineLength,
+                                                    XDAS_Int8* restrict		_iOutBuf,
+                                                    XDAS_Int32			_iOutBufSize,
+                                                    XDAS_Int32*			_iOutBufUsed,
+                                                    XDAS_Int32			_iOutFormat,
+                                                    XDAS_Int32			_iOutHeight,
+                                                    XDAS_Int32			_iOutWidth,
+                                                    XDAS_Int32			_iOutLineLength,
+                                                    XDAS_Int32			_iAlgorithm,
+                                                    ResampleCacheSlot&		_slot)
+{
+  trik::libimage::BaseImagePixel::PixelType   inPixelType;
+  trik::libimage::BaseImagePlanar::PlanarType inPlanarType;
+  if (!convertVideoFormat(_iInFormat, inPixelType) && !convertVideoFormat(_iInFormat, inPlanarType))
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_UNKNOWN_IN_FORMAT;
+
+  if (_iInBufSize < 0 || _iInWidth < 0 || _iInHeight < 0)
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+  const size_t               inBufferSize = _iInBufSize;
+  const size_t               inWidth      = _iInWidth;
+  const size_t               inHeight     = _iInHeight;
+  const size_t               inLineLength = _iInLineLength<=0 ? 0 : _iInLineLength;
+  const XDAS_UInt8* restrict inBuffer     = reinterpret_cast<const XDAS_UInt8*>(_iInBuf);
+
+
+  trik::libimage::BaseImagePixel::PixelType   outPixelType;
+  trik::libimage::BaseImagePlanar::PlanarType outPlanarType;
+  if (!convertVideoFormat(_iOutFormat, outPixelType) && !convertVideoFormat(_iOutFormat, outPlanarType))
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_UNKNOWN_OUT_FORMAT;
+
+  if (_iOutBufSize < 0 || _iOutWidth < 0 || _iOutHeight < 0)
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+  size_t                     outBufferSize = _iOutBufSize;
+  const size_t               outWidth      = _iOutWidth;
+  const size_t               outHeight     = _iOutHeight;
+  const size_t               outLineLength = _iOutLineLength<=0 ? 0 : _iOutLineLength;
+  XDAS_UInt8* restrict       outBuffer     = reinterpret_cast<XDAS_UInt8*>(_iOutBuf);
+
+  if (_iOutBufUsed == NULL)
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+
+
+  _iAlgorithm = pickAlgorithm(_iAlgorithm, inWidth, inHeight, outWidth, outHeight);
+
+  TrikVideoResampleStatus result;
+  if (   inWidth == outWidth && inHeight == outHeight
+      && _iAlgorithm >= TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_NEAREST
+      && _iAlgorithm <= TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3)
+  {
+    // every algorithm reduces to plain pixel format conversion at the same size
+    result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoConvert>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                          inWidth,  inHeight,  inLineLength,
+                                                                                          outBuffer, outBufferSize, _iOutFormat,
+                                                                                          outWidth, outHeight, outLineLength, _slot);
+  }
+  else switch (_iAlgorithm)
+  {
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_NEAREST:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleNearest>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                    inWidth,  inHeight,  inLineLength,
+                                                                                                    outBuffer, outBufferSize, _iOutFormat,
+                                                                                                    outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BILINEAR:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleBilinear>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                     inWidth,  inHeight,  inLineLength,
+                                                                                                     outBuffer, outBufferSize, _iOutFormat,
+                                                                                                     outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                    inWidth,  inHeight,  inLineLength,
+                                                                                                    outBuffer, outBufferSize, _iOutFormat,
+                                                                                                    outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AREA:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleArea>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                 inWidth,  inHeight,  inLineLength,
+                                                                                                 outBuffer, outBufferSize, _iOutFormat,
+                                                                                                 outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS2:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos2>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                     inWidth,  inHeight,  inLineLength,
+                                                                                                     outBuffer, outBufferSize, _iOutFormat,
+                                                                                                     outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3:
+      result = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos3>(inBuffer,  inBufferSize,  _iInFormat,
+                                                                                                     inWidth,  inHeight,  inLineLength,
+                                                                                                     outBuffer, outBufferSize, _iOutFormat,
+                                                                                                     outWidth, outHeight, outLineLength, _slot);
+      break;
+
+    default:
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+  }
+
+  if (result != TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK)
+    return result;
+
+  *_iOutBufUsed = outBufferSize;
+  return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+}
+
 TrikVideoResampleStatus resampleBuffer(const XDAS_Int8* restrict	_iInBuf,
                                        XDAS_Int32			_iInBufSize,
                                        XDAS_Int32			_iInFormat,
@@ -336,14 +1004,287 @@ TrikVideoResampleStatus resampleBuffer(const XDAS_Int8* restrict	_iInBuf,
                                        XDAS_Int32			_iOutFormat,
                                        XDAS_Int32			_iOutHeight,
                                        XDAS_Int32			_iOutWidth,
-                                       XDAS_Int32			_iOutLineLength)
+                                       XDAS_Int32			_iOutLineLength,
+                                       XDAS_Int32			_iAlgorithm,
+                                       TrikVideoResampleCache*	_iCache,
+                                       XDAS_Int32			_iStreamIndex)
 {
   if (_iInBuf == NULL || _iOutBuf == NULL)
     return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
 
+  // without cache algorithm state lives for this call only, on heap
+  ResampleCacheSlot  localSlot;
+  ResampleCacheSlot& slot = (_iCache != NULL && _iStreamIndex >= 0 && _iStreamIndex < IVIDTRANSCODE_MAXOUTSTREAMS)
+                          ? _iCache->m_streams[_iStreamIndex] : localSlot;
 
-  trik::libimage::BaseImagePixel::PixelType inPixelType;
-  if (!convertVideoFormat(_iInFormat, inPixelType))
+  return resampleBufferStream(_iInBuf, _iInBufSize, _iInFormat, _iInHeight, _iInWidth, _iInLineLength,
+                              _iOutBuf, _iOutBufSize, _iOutBufUsed, _iOutFormat, _iOutHeight, _iOutWidth, _iOutLineLength,
+                              _iAlgorithm, slot);
+}
+
+
+
+
+
+template <trik::libimage::BaseImagePixel::PixelType _PixelTypeSrc>
+class ResampleOutputs
+{
+  public:
+    typedef trik::libimage::Image<_PixelTypeSrc, const XDAS_UInt8>  ImageSrc;
+    typedef trik::libimage::ImageAlgorithmMultiOutput<ImageSrc>    MultiOutput;
+    typedef typename MultiOutput::Output                           Output;
+};
+
+template <trik::libimage::BaseImagePixel::PixelType         _PixelTypeSrc,
+          trik::libimage::BaseImagePixel::PixelType         _PixelTypeDst,
+          trik::libimage::BaseImageAlgorithm::AlgorithmType _Algorithm>
+static bool createResampleOutputImpl(const TrikVideoResampleOutput&                    _output,
+                                     ResampleCacheSlot*                                _slot,
+                                     typename ResampleOutputs<_PixelTypeSrc>::Output*& _created)
+{
+  typedef typename ResampleOutputs<_PixelTypeSrc>::ImageSrc              ImageSrc;
+  typedef trik::libimage::Image<_PixelTypeDst, XDAS_UInt8>               ImageDst;
+  typedef trik::libimage::ImageAlgorithm<_Algorithm, ImageSrc, ImageDst> Algorithm;
+
+  if (_slot == NULL)
+    return true;
+
+  // output is owned by slot
+  trik::libimage::ImageAlgorithmOutput<Algorithm>& output = _slot->get<trik::libimage::ImageAlgorithmOutput<Algorithm> >();
+  output.imageOut(ImageDst(reinterpret_cast<XDAS_UInt8*>(_output.m_buf),
+                           _output.m_bufSize,
+                           _output.m_width,
+                           _output.m_height,
+                           _output.m_lineLength<=0 ? 0 : _output.m_lineLength));
+  _created = &output;
+  return true;
+}
+
+template <trik::libimage::BaseImagePixel::PixelType _PixelTypeSrc,
+          trik::libimage::BaseImagePixel::PixelType _PixelTypeDst>
+static bool createResampleOutputAlgorithm(const TrikVideoResampleOutput&                    _output,
+                                          XDAS_Int32                                        _iAlgorithm,
+                                          bool                                              _sameSize,
+                                          ResampleCacheSlot*                                _slot,
+                                          typename ResampleOutputs<_PixelTypeSrc>::Output*& _created)
+{
+  // same format copy is plain memcpy of packed rows, unpacking could only slow it down
+  if (_sameSize && _PixelTypeSrc == _PixelTypeDst)
+    return false;
+
+  if (_sameSize)
+    return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoConvert>(_output, _slot, _created);
+
+  switch (_iAlgorithm)
+  {
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BILINEAR:
+      return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoResampleBilinear>(_output, _slot, _created);
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC:
+      return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>(_output, _slot, _created);
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AREA:
+      return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoResampleArea>(_output, _slot, _created);
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS2:
+      return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos2>(_output, _slot, _created);
+    case TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3:
+      return createResampleOutputImpl<_PixelTypeSrc, _PixelTypeDst, trik::libimage::BaseImageAlgorithm::AlgoResampleLanczos3>(_output, _slot, _created);
+
+    // nearest copies packed pixels directly, unpacked input does not help it
+    default:
+      return false;
+  }
+}
+
+/*
+ * Same format pairs as resampleBufferAlgorithmImpl, false when output cannot take shared unpacked rows.
+ * Output object is created in slot only when slot is given, so that sharing can be probed first.
+ */
+template <trik::libimage::BaseImagePixel::PixelType _PixelTypeSrc>
+static bool createResampleOutput(const TrikVideoResampleOutput&                    _output,
+                                 const trik::libimage::BaseImagePixel::PixelType&  _outPixelType,
+                                 XDAS_Int32                                        _iAlgorithm,
+                                 bool                                              _sameSize,
+                                 ResampleCacheSlot*                                _slot,
+                                 typename ResampleOutputs<_PixelTypeSrc>::Output*& _created)
+{
+  return false;
+}
+
+template <>
+bool createResampleOutput<trik::libimage::BaseImagePixel::PixelYUV422>(const TrikVideoResampleOutput&                            _output,
+                                                                  const trik::libimage::BaseImagePixel::PixelType&          _outPixelType,
+                                                                  XDAS_Int32                                                _iAlgorithm,
+                                                                  bool                                                      _sameSize,
+                                                                  ResampleCacheSlot*                                        _slot,
+                                                                  ResampleOutputs<trik::libimage::BaseImagePixel::PixelYUV422>::Output*& _created)
+{
+  switch (_outPixelType)
+  {
+    case trik::libimage::BaseImagePixel::PixelRGB565X:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelYUV422,
+                                           trik::libimage::BaseImagePixel::PixelRGB565X>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelRGB888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelYUV422,
+                                           trik::libimage::BaseImagePixel::PixelRGB888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelRGBA8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelYUV422,
+                                           trik::libimage::BaseImagePixel::PixelRGBA8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelBGRA8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelYUV422,
+                                           trik::libimage::BaseImagePixel::PixelBGRA8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelXRGB8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelYUV422,
+                                           trik::libimage::BaseImagePixel::PixelXRGB8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    default:
+      return false;
+  }
+}
+
+template <>
+bool createResampleOutput<trik::libimage::BaseImagePixel::PixelRGB888>(const TrikVideoResampleOutput&                            _output,
+                                                                  const trik::libimage::BaseImagePixel::PixelType&          _outPixelType,
+                                                                  XDAS_Int32                                                _iAlgorithm,
+                                                                  bool                                                      _sameSize,
+                                                                  ResampleCacheSlot*                                        _slot,
+                                                                  ResampleOutputs<trik::libimage::BaseImagePixel::PixelRGB888>::Output*& _created)
+{
+  switch (_outPixelType)
+  {
+    case trik::libimage::BaseImagePixel::PixelRGB565X:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelRGB565X>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelRGB888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelRGB888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelRGB565:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelRGB565>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelRGBA8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelRGBA8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelBGRA8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelBGRA8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    case trik::libimage::BaseImagePixel::PixelXRGB8888:
+      return createResampleOutputAlgorithm<trik::libimage::BaseImagePixel::PixelRGB888,
+                                           trik::libimage::BaseImagePixel::PixelXRGB8888>(_output, _iAlgorithm, _sameSize, _slot, _created);
+    default:
+      return false;
+  }
+}
+
+/*
+ * Outputs which accept unpacked rows are produced together in one pass over input, when there are at least two of them;
+ * m_bufUsed of every such output is set, others are left for resampleBuffer
+ */
+template <trik::libimage::BaseImagePixel::PixelType _PixelTypeSrc>
+static TrikVideoResampleStatus resampleBufferSharedImpl(const XDAS_UInt8* restrict _inBuffer,
+                                                        const size_t&              _inBufferSize,
+                                                        const size_t&              _inWidth,
+                                                        const size_t&              _inHeight,
+                                                        const size_t&              _inLineLength,
+                                                        TrikVideoResampleOutput*   _outputs,
+                                                        XDAS_Int32                 _outputsCount,
+                                                        TrikVideoResampleCache*    _cache)
+{
+  typedef ResampleOutputs<_PixelTypeSrc> Outputs;
+
+  ResampleCacheSlot  localSlots[IVIDTRANSCODE_MAXOUTSTREAMS];
+  ResampleCacheSlot  localMultiSlot;
+  ResampleCacheSlot* slots     = _cache == NULL ? localSlots      : _cache->m_shared;
+  ResampleCacheSlot& multiSlot = _cache == NULL ? localMultiSlot  : _cache->m_multi;
+
+  typename Outputs::Output* outputs[IVIDTRANSCODE_MAXOUTSTREAMS];
+  bool       shared[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32 outputsShared = 0;
+
+  // probe first, objects of shared pass are not worth their memory for single output
+  for (XDAS_Int32 outIndex = 0; outIndex < _outputsCount; ++outIndex)
+  {
+    const TrikVideoResampleOutput& output = _outputs[outIndex];
+    outputs[outIndex] = NULL;
+    shared[outIndex]  = false;
+
+    trik::libimage::BaseImagePixel::PixelType outPixelType;
+    if (   (output.m_buf == NULL && _inBuffer != NULL)
+        || output.m_bufSize < 0 || output.m_width < 0 || output.m_height < 0
+        || !convertVideoFormat(output.m_format, outPixelType))
+      continue;
+
+    const size_t outWidth  = output.m_width;
+    const size_t outHeight = output.m_height;
+    shared[outIndex] = createResampleOutput<_PixelTypeSrc>(output, outPixelType,
+                                                           pickAlgorithm(output.m_algorithm, _inWidth, _inHeight, outWidth, outHeight),
+                                                           _inWidth == outWidth && _inHeight == outHeight,
+                                                           NULL, outputs[outIndex]);
+    if (shared[outIndex])
+      ++outputsShared;
+  }
+
+  if (outputsShared < 2)
+  {
+    resampleCacheResetShared(_cache);
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+  }
+
+  // state of shared outputs moves from stream slots to shared ones and back, never held by both
+  for (XDAS_Int32 outIndex = 0; outIndex < IVIDTRANSCODE_MAXOUTSTREAMS; ++outIndex)
+  {
+    if (outIndex >= _outputsCount || !shared[outIndex])
+    {
+      slots[outIndex].reset();
+      continue;
+    }
+
+    if (_cache != NULL)
+      _cache->m_streams[outIndex].reset();
+
+    const TrikVideoResampleOutput& output = _outputs[outIndex];
+    trik::libimage::BaseImagePixel::PixelType outPixelType;
+    convertVideoFormat(output.m_format, outPixelType);
+    const size_t outWidth  = output.m_width;
+    const size_t outHeight = output.m_height;
+    createResampleOutput<_PixelTypeSrc>(output, outPixelType,
+                                        pickAlgorithm(output.m_algorithm, _inWidth, _inHeight, outWidth, outHeight),
+                                        _inWidth == outWidth && _inHeight == outHeight,
+                                        &slots[outIndex], outputs[outIndex]);
+  }
+
+  typename Outputs::ImageSrc imageSrc(_inBuffer, _inBufferSize, _inWidth, _inHeight, _inLineLength);
+  typename Outputs::MultiOutput& multiOutput = multiSlot.get<typename Outputs::MultiOutput>();
+  multiOutput.clearOutputs();
+  for (XDAS_Int32 outIndex = 0; outIndex < _outputsCount; ++outIndex)
+    if (shared[outIndex])
+      multiOutput.addOutput(*outputs[outIndex]);
+
+  const bool isOk = _inBuffer == NULL ? multiOutput.prepare(_inWidth, _inHeight) : multiOutput(imageSrc);
+
+  for (XDAS_Int32 outIndex = 0; outIndex < _outputsCount; ++outIndex)
+    if (shared[outIndex])
+      _outputs[outIndex].m_bufUsed = outputs[outIndex]->actualImageSize();
+
+  return isOk ? TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK : TRIK_VIDTRANSCODE_RESAMPLE_STATUS_FAILED;
+}
+
+
+// NULL input buffer only builds plans in cache, output buffers are not accessed then
+static TrikVideoResampleStatus resampleBufferMultiImpl(const XDAS_Int8* restrict	_iInBuf,
+                                                       XDAS_Int32			_iInBufSize,
+                                                       XDAS_Int32			_iInFormat,
+                                                       XDAS_Int32			_iInHeight,
+                                                       XDAS_Int32			_iInWidth,
+                                                       XDAS_Int32			_iInLineLength,
+                                                       TrikVideoResampleOutput*	_iOutputs,
+                                                       XDAS_Int32			_iOutputsCount,
+                                                       TrikVideoResampleCache*	_iCache)
+{
+  if (   _iOutputs == NULL
+      || _iOutputsCount < 0 || _iOutputsCount > IVIDTRANSCODE_MAXOUTSTREAMS)
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+
+  trik::libimage::BaseImagePixel::PixelType   inPixelType;
+  trik::libimage::BaseImagePlanar::PlanarType inPlanarType;
+  const bool inPacked = convertVideoFormat(_iInFormat, inPixelType);
+  if (!inPacked && !convertVideoFormat(_iInFormat, inPlanarType))
     return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_UNKNOWN_IN_FORMAT;
 
   if (_iInBufSize < 0 || _iInWidth < 0 || _iInHeight < 0)
@@ -354,32 +1295,101 @@ TrikVideoResampleStatus resampleBuffer(const XDAS_Int8* restrict	_iInBuf,
   const size_t               inLineLength = _iInLineLength<=0 ? 0 : _iInLineLength;
   const XDAS_UInt8* restrict inBuffer     = reinterpret_cast<const XDAS_UInt8*>(_iInBuf);
 
+  for (XDAS_Int32 outIndex = 0; outIndex < _iOutputsCount; ++outIndex)
+    _iOutputs[outIndex].m_bufUsed = -1;
 
-  trik::libimage::BaseImagePixel::PixelType outPixelType;
-  if (!convertVideoFormat(_iOutFormat, outPixelType))
-    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_UNKNOWN_OUT_FORMAT;
-
-  if (_iOutBufSize < 0 || _iOutWidth < 0 || _iOutHeight < 0)
-    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
-  size_t                     outBufferSize = _iOutBufSize;
-  const size_t               outWidth      = _iOutWidth;
-  const size_t               outHeight     = _iOutHeight;
-  const size_t               outLineLength = _iOutLineLength<=0 ? 0 : _iOutLineLength;
-  XDAS_UInt8* restrict       outBuffer     = reinterpret_cast<XDAS_UInt8*>(_iOutBuf);
+  // planar input has no unpacked rows to share, all of its outputs are resampled one by one below
+  TrikVideoResampleStatus result = TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+  if (!inPacked)
+    resampleCacheResetShared(_iCache);
+  else switch (inPixelType)
+  {
+    case trik::libimage::BaseImagePixel::PixelYUV422:
+      result = resampleBufferSharedImpl<trik::libimage::BaseImagePixel::PixelYUV422>(inBuffer, inBufferSize,
+                                                                                     inWidth, inHeight, inLineLength,
+                                                                                     _iOutputs, _iOutputsCount, _iCache);
+      break;
 
-  if (_iOutBufUsed == NULL)
-    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+    case trik::libimage::BaseImagePixel::PixelRGB888:
+      result = resampleBufferSharedImpl<trik::libimage::BaseImagePixel::PixelRGB888>(inBuffer, inBufferSize,
+                                                                                     inWidth, inHeight, inLineLength,
+                                                                                     _iOutputs, _iOutputsCount, _iCache);
+      break;
 
+    default:
+      resampleCacheResetShared(_iCache);
+      break;
+  }
 
-  TrikVideoResampleStatus result
-    = resampleBufferAlgorithmImpl<trik::libimage::BaseImageAlgorithm::AlgoResampleBicubic>(inBuffer,  inBufferSize,  inPixelType,
-                                                                                           inWidth,  inHeight,  inLineLength,
-                                                                                           outBuffer, outBufferSize, outPixelType,
-                                                                                           outWidth, outHeight, outLineLength);
   if (result != TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK)
     return result;
 
-  *_iOutBufUsed = outBufferSize;
+  // remaining outputs one by one
+  for (XDAS_Int32 outIndex = 0; outIndex < _iOutputsCount; ++outIndex)
+  {
+    TrikVideoResampleOutput& output = _iOutputs[outIndex];
+    if (output.m_bufUsed >= 0)
+      continue;
+
+    if (_iInBuf != NULL && output.m_buf == NULL)
+      return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+
+    ResampleCacheSlot  localSlot;
+    ResampleCacheSlot& slot = _iCache == NULL ? localSlot : _iCache->m_streams[outIndex];
+    result = resampleBufferStream(_iInBuf, _iInBufSize, _iInFormat, _iInHeight, _iInWidth, _iInLineLength,
+                                  output.m_buf, output.m_bufSize, &output.m_bufUsed,
+                                  output.m_format, output.m_height, output.m_width, output.m_lineLength,
+                                  output.m_algorithm, slot);
+    if (result != TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK)
+      return result;
+  }
+
   return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
 }
 
+
+TrikVideoResampleStatus resampleBufferMulti(const XDAS_Int8* restrict	_iInBuf,
+                                            XDAS_Int32			_iInBufSize,
+                                            XDAS_Int32			_iInFormat,
+                                            XDAS_Int32			_iInHeight,
+                                            XDAS_Int32			_iInWidth,
+                                            XDAS_Int32			_iInLineLength,
+                                            TrikVideoResampleOutput*	_iOutputs,
+                                            XDAS_Int32			_iOutputsCount,
+                                            TrikVideoResampleCache*	_iCache)
+{
+  if (_iInBuf == NULL)
+    return TRIK_VIDTRANSCODE_RESAMPLE_STATUS_INVALID_ARGUMENTS;
+
+  return resampleBufferMultiImpl(_iInBuf, _iInBufSize, _iInFormat, _iInHeight, _iInWidth, _iInLineLength,
+                                 _iOutputs, _iOutputsCount, _iCache);
+}
+
+
+bool handlePrepareResample(TrikVideoResampleHandle* _handle)
+{
+  XDAS_Int32 inFormat;
+  XDAS_Int32 inHeight;
+  XDAS_Int32 inWidth;
+  XDAS_Int32 inLineLength;
+  if (   _handle->m_cache == NULL
+      || _handle->m_params.base.numOutputStreams > IVIDTRANSCODE_MAXOUTSTREAMS
+      || !handlePickInputParams(_handle, &inFormat, &inHeight, &inWidth, &inLineLength))
+    return false;
+
+  TrikVideoResampleOutput outputs[IVIDTRANSCODE_MAXOUTSTREAMS];
+  for (XDAS_Int32 outIndex = 0; outIndex < _handle->m_params.base.numOutputStreams; ++outIndex)
+  {
+    TrikVideoResampleOutput& output = outputs[outIndex];
+    output.m_buf	= NULL;
+    output.m_bufSize	= 0;
+    output.m_bufUsed	= 0;
+    if (!handlePickOutputParams(_handle, outIndex, &output.m_format, &output.m_height, &output.m_width,
+                                &output.m_lineLength, &output.m_algorithm))
+      return false;
+  }
+
+  return resampleBufferMultiImpl(NULL, 0, inFormat, inHeight, inWidth, inLineLength,
+                                 outputs, _handle->m_params.base.numOutputStreams,
+                                 _handle->m_cache) == TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+}
@@ -0,0 +1,175 @@
+#ifndef TRIK_TESTS_CODEC_HPP_
+#define TRIK_TESTS_CODEC_HPP_
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "trik_vidtranscode_resample.h"
+#include "internal/vidtranscode_resample_iface.h"
+#include "internal/vidtranscode_resample_helpers.h"
+
+
+/*
+ * Host stand-in of XDAIS framework: memTab records of alloc() are allocated with requested alignment,
+ * initObj() runs over them, free() records are kept for comparison and memory is released on destruction.
+ */
+class CodecInstance
+{
+  public:
+    CodecInstance()
+     :m_handle(NULL),
+      m_recordsCount(0),
+      m_freeCount(0)
+    {
+      memset(m_records, 0, sizeof(m_records));
+      memset(m_freeRecords, 0, sizeof(m_freeRecords));
+    }
+
+    ~CodecInstance()
+    {
+      release();
+    }
+
+    // NULL params take codec defaults
+    bool create(const TRIK_VIDTRANSCODE_RESAMPLE_Params* _params)
+    {
+      IALG_Fxns* fxns = NULL;
+      m_recordsCount = TRIK_VIDTRANSCODE_RESAMPLE_alloc(reinterpret_cast<const IALG_Params*>(_params), &fxns, m_records);
+      if (m_recordsCount <= 0 || m_recordsCount > IALG_MAXMEMRECS)
+        return false;
+
+      for (Int idx = 0; idx < m_recordsCount; ++idx)
+      {
+        const size_t alignment = m_records[idx].alignment > static_cast<Int>(sizeof(void*)) ? m_records[idx].alignment : sizeof(void*);
+        if (posix_memalign(&m_records[idx].base, alignment, m_records[idx].size) != 0)
+          return false;
+      }
+
+      m_handle = static_cast<IALG_Handle>(m_records[0].base);
+      m_handle->fxns = fxns;
+      return TRIK_VIDTRANSCODE_RESAMPLE_initObj(m_handle, m_records, NULL, reinterpret_cast<const IALG_Params*>(_params)) == IALG_EOK;
+    }
+
+    bool setParams(TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams& _dynamicParams)
+    {
+      return control(XDM_SETPARAMS, &_dynamicParams);
+    }
+
+    // commands other than XDM_SETPARAMS take no dynamic params
+    bool control(IVIDTRANSCODE_Cmd _cmd, TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams* _dynamicParams = NULL)
+    {
+      IVIDTRANSCODE_Status status;
+      memset(&status, 0, sizeof(status));
+      status.size = sizeof(status);
+      return TRIK_VIDTRANSCODE_RESAMPLE_control(videoHandle(), _cmd,
+                                                reinterpret_cast<IVIDTRANSCODE_DynamicParams*>(_dynamicParams),
+                                                &status) == IVIDTRANSCODE_EOK;
+    }
+
+    // bitsGenerated of every output is returned through outArgs
+    bool process(std::vector<XDAS_Int8>& _in, std::vector<XDAS_Int8>* _outs, XDAS_Int32 _outsCount,
+                 IVIDTRANSCODE_OutArgs& _outArgs)
+    {
+      XDM1_BufDesc inBufs;
+      memset(&inBufs, 0, sizeof(inBufs));
+      inBufs.numBufs = 1;
+      inBufs.descs[0].buf     = &_in.front();
+      inBufs.descs[0].bufSize = _in.size();
+
+      XDAS_Int8* outBufPtrs[IVIDTRANSCODE_MAXOUTSTREAMS];
+      XDAS_Int32 outBufSizes[IVIDTRANSCODE_MAXOUTSTREAMS];
+      for (XDAS_Int32 outIndex = 0; outIndex < _outsCount; ++outIndex)
+      {
+        outBufPtrs[outIndex]  = &_outs[outIndex].front();
+        outBufSizes[outIndex] = _outs[outIndex].size();
+      }
+
+      XDM_BufDesc outBufs;
+      outBufs.bufs     = outBufPtrs;
+      outBufs.numBufs  = _outsCount;
+      outBufs.bufSizes = outBufSizes;
+
+      IVIDTRANSCODE_InArgs inArgs;
+      inArgs.size     = sizeof(inArgs);
+      inArgs.numBytes = _in.size();
+      inArgs.inputID  = 1;
+
+      memset(&_outArgs, 0, sizeof(_outArgs));
+      _outArgs.size = sizeof(_outArgs);
+      return TRIK_VIDTRANSCODE_RESAMPLE_process(videoHandle(), &inBufs, &outBufs, &inArgs, &_outArgs) == IVIDTRANSCODE_EOK;
+    }
+
+    // free() must hand back records of alloc()
+    bool free()
+    {
+      if (m_handle == NULL)
+        return false;
+
+      m_freeCount = TRIK_VIDTRANSCODE_RESAMPLE_free(m_handle, m_freeRecords);
+      m_handle = NULL;
+      if (m_freeCount != m_recordsCount)
+        return false;
+
+      for (Int idx = 0; idx < m_recordsCount; ++idx)
+        if (   m_freeRecords[idx].base != m_records[idx].base
+            || m_freeRecords[idx].size != m_records[idx].size)
+          return false;
+
+      return true;
+    }
+
+    const IALG_MemRec& record(Int _index) const { return m_records[_index]; }
+    const TrikVideoResampleHandle* handle() const { return reinterpret_cast<const TrikVideoResampleHandle*>(m_handle); }
+    const Int& recordsCount() const { return m_recordsCount; }
+
+  private:
+    IALG_Handle	m_handle;
+    IALG_MemRec	m_records[IALG_MAXMEMRECS];
+    Int		m_recordsCount;
+    IALG_MemRec	m_freeRecords[IALG_MAXMEMRECS];
+    Int		m_freeCount;
+
+    CodecInstance(const CodecInstance&);
+    CodecInstance& operator=(const CodecInstance&);
+
+    IVIDTRANSCODE_Handle videoHandle() const
+    {
+      return reinterpret_cast<IVIDTRANSCODE_Handle>(m_handle);
+    }
+
+    void release()
+    {
+      if (m_handle != NULL)
+        free();
+
+      for (Int idx = 0; idx < m_recordsCount; ++idx)
+        ::free(m_records[idx].base);
+      m_recordsCount = 0;
+    }
+};
+
+
+// default dynamic params with given geometry of single input and two outputs
+static inline TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams codecDynamicParams(XDAS_Int32 _inWidth, XDAS_Int32 _inHeight,
+                                                                          XDAS_Int32 _outWidth0, XDAS_Int32 _outHeight0,
+                                                                          XDAS_Int32 _outWidth1, XDAS_Int32 _outHeight1)
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams dynamicParams = *getDefaultDynamicParams();
+  dynamicParams.base.size = sizeof(dynamicParams);
+  dynamicParams.inputWidth  = _inWidth;
+  dynamicParams.inputHeight = _inHeight;
+  dynamicParams.inputLineLength = -1;
+  dynamicParams.base.keepInputResolutionFlag[0] = XDAS_FALSE;
+  dynamicParams.base.keepInputResolutionFlag[1] = XDAS_FALSE;
+  dynamicParams.base.outputWidth[0]  = _outWidth0;
+  dynamicParams.base.outputHeight[0] = _outHeight0;
+  dynamicParams.base.outputWidth[1]  = _outWidth1;
+  dynamicParams.base.outputHeight[1] = _outHeight1;
+  dynamicParams.outputLineLength[0] = -1;
+  dynamicParams.outputLineLength[1] = -1;
+  return dynamicParams;
+}
+
+
+#endif // !TRIK_TESTS_CODEC_HPP_
@@ -0,0 +1,221 @@
+#include <sysexits.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <iostream>
+
+#include "codec.hpp"
+
+
+using namespace std;
+
+
+/*
+ * Codec takes all of its resample state from memTab records: once alloc() is answered, neither initObj(),
+ * control() within maximum geometry nor any process() call may reach heap. Cache record size is an estimate,
+ * so every format and algorithm is run at maximum geometry and its peak must fit.
+ */
+static size_t s_heapAllocations = 0;
+
+void* operator new(size_t _size) throw(std::bad_alloc)
+{
+  ++s_heapAllocations;
+  void* const ptr = malloc(_size == 0 ? 1 : _size);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* _ptr) throw()
+{
+  free(_ptr);
+}
+
+void* operator new[](size_t _size) throw(std::bad_alloc)
+{
+  return operator new(_size);
+}
+
+void operator delete[](void* _ptr) throw()
+{
+  operator delete(_ptr);
+}
+
+
+static const size_t s_frames = 5;
+
+
+static bool checkGeometry(CodecInstance& _codec,
+                          XDAS_Int32 _inWidth, XDAS_Int32 _inHeight,
+                          XDAS_Int32 _outWidth0, XDAS_Int32 _outHeight0,
+                          XDAS_Int32 _outWidth1, XDAS_Int32 _outHeight1,
+                          XDAS_Int32 _algorithm)
+{
+  // buffers are set up before counting starts
+  vector<XDAS_Int8> in(_inWidth*_inHeight*2);
+  vector<XDAS_Int8> outs[2] = { vector<XDAS_Int8>(_outWidth0*_outHeight0*2), vector<XDAS_Int8>(_outWidth1*_outHeight1*3) };
+  for (size_t idx = 0; idx < in.size(); ++idx)
+    in[idx] = static_cast<XDAS_Int8>(idx*7 + idx/(_inWidth*2)*3);
+
+  TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams dynamicParams = codecDynamicParams(_inWidth, _inHeight,
+                                                                              _outWidth0, _outHeight0,
+                                                                              _outWidth1, _outHeight1);
+  dynamicParams.outputAlgorithm[0] = _algorithm;
+  dynamicParams.outputAlgorithm[1] = _algorithm;
+
+  const size_t allocationsBefore = s_heapAllocations;
+  bool passed = _codec.setParams(dynamicParams);
+
+  for (size_t frame = 0; passed && frame < s_frames; ++frame)
+  {
+    IVIDTRANSCODE_OutArgs outArgs;
+    passed &= _codec.process(in, outs, 2, outArgs)
+           && outArgs.bitsGenerated[0] == static_cast<XDAS_Int32>(outs[0].size()*8)
+           && outArgs.bitsGenerated[1] == static_cast<XDAS_Int32>(outs[1].size()*8);
+  }
+
+  const size_t allocations = s_heapAllocations - allocationsBefore;
+  passed &= allocations == 0;
+
+  cout << "YUV422 " << _inWidth << "x" << _inHeight << " -> " << _outWidth0 << "x" << _outHeight0
+       << " and " << _outWidth1 << "x" << _outHeight1 << ", algorithm " << _algorithm << ": "
+       << allocations << " heap allocations" << (passed ? ", ok" : ", FAILED") << endl;
+  return passed;
+}
+
+
+// one frame at maximum geometry of fresh instance; combination codec does not support at all is skipped
+static bool checkMaxParams(XDAS_Int32 _inFormat, XDAS_Int32 _outFormat0, XDAS_Int32 _outFormat1,
+                           XDAS_Int32 _algorithm, size_t& _peak, size_t& _size, bool& _supported)
+{
+  static const XDAS_Int32 s_inWidth    = 320;
+  static const XDAS_Int32 s_inHeight   = 240;
+  static const XDAS_Int32 s_outWidth0  = 480;
+  static const XDAS_Int32 s_outHeight0 = 360;
+  static const XDAS_Int32 s_outWidth1  = 200;
+  static const XDAS_Int32 s_outHeight1 = 150;
+
+  TRIK_VIDTRANSCODE_RESAMPLE_Params params = *getDefaultParams();
+  params.base.numOutputStreams   = 2;
+  params.base.formatInput        = _inFormat;
+  params.base.formatOutput[0]    = _outFormat0;
+  params.base.formatOutput[1]    = _outFormat1;
+  params.base.maxWidthInput      = s_inWidth;
+  params.base.maxHeightInput     = s_inHeight;
+  params.base.maxWidthOutput[0]  = s_outWidth0;
+  params.base.maxHeightOutput[0] = s_outHeight0;
+  params.base.maxWidthOutput[1]  = s_outWidth1;
+  params.base.maxHeightOutput[1] = s_outHeight1;
+
+  // 4 bytes per pixel is enough for any format
+  vector<XDAS_Int8> in(s_inWidth*s_inHeight*4);
+  vector<XDAS_Int8> outs[2] = { vector<XDAS_Int8>(s_outWidth0*s_outHeight0*4), vector<XDAS_Int8>(s_outWidth1*s_outHeight1*4) };
+  for (size_t idx = 0; idx < in.size(); ++idx)
+    in[idx] = static_cast<XDAS_Int8>(idx*11 + idx/(s_inWidth*4)*7);
+
+  XDAS_Int32 used;
+  _supported = resampleBuffer(&in.front(), in.size(), _inFormat, s_inHeight, s_inWidth, -1,
+                              &outs[0].front(), outs[0].size(), &used, _outFormat0, s_outHeight0, s_outWidth0, -1,
+                              _algorithm, NULL, 0) == TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK
+            && resampleBuffer(&in.front(), in.size(), _inFormat, s_inHeight, s_inWidth, -1,
+                              &outs[1].front(), outs[1].size(), &used, _outFormat1, s_outHeight1, s_outWidth1, -1,
+                              _algorithm, NULL, 0) == TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+  if (!_supported)
+    return true;
+
+  TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams dynamicParams = codecDynamicParams(s_inWidth, s_inHeight,
+                                                                              s_outWidth0, s_outHeight0,
+                                                                              s_outWidth1, s_outHeight1);
+  dynamicParams.outputAlgorithm[0] = _algorithm;
+  dynamicParams.outputAlgorithm[1] = _algorithm;
+
+  CodecInstance codec;
+  const size_t allocationsBefore = s_heapAllocations;
+  bool passed = codec.create(&params) && codec.setParams(dynamicParams);
+
+  IVIDTRANSCODE_OutArgs outArgs;
+  passed = passed && codec.process(in, outs, 2, outArgs);
+  passed &= s_heapAllocations == allocationsBefore;
+
+  _peak = resampleCachePeak(codec.handle()->m_cache);
+  _size = codec.record(1).size;
+  passed &= _peak <= _size;
+
+  passed &= codec.free();
+  return passed;
+}
+
+static bool checkMaxParamsAll()
+{
+  static const XDAS_Int32 s_formatFirst = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB888;
+  static const XDAS_Int32 s_formatLast  = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_XRGB8888;
+
+  bool passed = true;
+  size_t checked = 0;
+  size_t failed = 0;
+  double worstRatio = 0;
+  for (XDAS_Int32 inFormat = s_formatFirst; inFormat <= s_formatLast; ++inFormat)
+    for (XDAS_Int32 outFormat = s_formatFirst; outFormat <= s_formatLast; ++outFormat)
+      for (XDAS_Int32 algorithm = TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO;
+           algorithm <= TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3; ++algorithm)
+      {
+        // second output differs in size only, so every supported pair also runs through shared single pass
+        const XDAS_Int32 outFormat1 = outFormat;
+        size_t peak = 0;
+        size_t size = 0;
+        bool supported = false;
+        if (!checkMaxParams(inFormat, outFormat, outFormat1, algorithm, peak, size, supported))
+        {
+          cout << "format " << hex << inFormat << " -> " << outFormat << " and " << outFormat1 << dec
+               << ", algorithm " << algorithm << ": peak " << peak << " of " << size << ", FAILED" << endl;
+          passed = false;
+          ++failed;
+        }
+
+        if (!supported)
+          continue;
+        ++checked;
+        if (size > 0)
+          worstRatio = max(worstRatio, static_cast<double>(peak) / size);
+      }
+
+  cout << "maximum geometry, " << checked << " format and algorithm combinations: " << failed << " failed"
+       << ", worst peak " << static_cast<int>(worstRatio*100) << "% of cache record"
+       << (passed ? ", ok" : ", FAILED") << endl;
+  return passed && checked > 0;
+}
+
+
+int main()
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_Params params = *getDefaultParams();
+  params.base.numOutputStreams   = 2;
+  params.base.formatInput        = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422;
+  params.base.formatOutput[0]    = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565X;
+  params.base.formatOutput[1]    = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB888;
+  params.base.maxWidthInput      = 640;
+  params.base.maxHeightInput     = 480;
+  params.base.maxWidthOutput[0]  = 640;
+  params.base.maxHeightOutput[0] = 480;
+  params.base.maxWidthOutput[1]  = 320;
+  params.base.maxHeightOutput[1] = 240;
+
+  CodecInstance codec;
+  const size_t allocationsBefore = s_heapAllocations;
+  bool passed = codec.create(&params);
+  passed &= s_heapAllocations == allocationsBefore;
+  cout << "alloc and initObj: " << s_heapAllocations - allocationsBefore << " heap allocations"
+       << (passed ? ", ok" : ", FAILED") << endl;
+
+  passed &= checkGeometry(codec, 640, 480, 320, 240, 213, 160, TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO);
+  passed &= checkGeometry(codec, 640, 480, 640, 480, 320, 240, TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC);
+  passed &= checkGeometry(codec, 320, 240, 640, 480, 100, 75,  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3);
+  passed &= checkGeometry(codec, 640, 480, 213, 160, 160, 120, TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AREA);
+  passed &= checkGeometry(codec, 640, 480, 320, 240, 320, 240, TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_NEAREST);
+
+  passed &= codec.free();
+
+  passed &= checkMaxParamsAll();
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
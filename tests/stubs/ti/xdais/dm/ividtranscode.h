@@ -0,0 +1,155 @@
+/*
+ * Host stand-in of IVIDTRANSCODE interface, fields in XDM order; only what codec and tests touch is declared
+ */
+#ifndef TRIK_TESTS_STUBS_TI_XDAIS_DM_IVIDTRANSCODE_H_
+#define TRIK_TESTS_STUBS_TI_XDAIS_DM_IVIDTRANSCODE_H_
+
+#include <ti/xdais/xdas.h>
+#include <ti/xdais/ialg.h>
+
+#define XDM_CUSTOMENUMBASE		0x100
+#define XDM_BYTE			1
+#define XDM_MAX_IO_BUFFERS		16
+
+#define IVIDEO_NONE			0
+#define IVIDEO_NA_FRAME			(-1)
+#define IVIDEO_NA_PICTURE		(-1)
+#define IVIDEO_CONTENTTYPE_NA		(-1)
+
+#define IVIDTRANSCODE_EOK		0
+#define IVIDTRANSCODE_EFAIL		(-1)
+#define IVIDTRANSCODE_EUNSUPPORTED	(-3)
+#define IVIDTRANSCODE_MAXOUTSTREAMS	2
+
+enum
+{
+  XDM_GETSTATUS,
+  XDM_SETPARAMS,
+  XDM_RESET,
+  XDM_SETDEFAULT,
+  XDM_FLUSH,
+  XDM_GETBUFINFO,
+  XDM_GETVERSION
+};
+
+#define XDM_SETCORRUPTEDDATA(x)		((x) |= (1 << 13))
+#define XDM_SETUNSUPPORTEDPARAM(x)	((x) |= (1 << 14))
+#define XDM_SETACCESSMODE_READ(x)	((x) |= 1)
+#define XDM_SETACCESSMODE_WRITE(x)	((x) |= 2)
+#define XDM_CLEARACCESSMODE_READ(x)	((x) &= ~1)
+#define XDM_CLEARACCESSMODE_WRITE(x)	((x) &= ~2)
+
+typedef struct XDM1_SingleBufDesc
+{
+  XDAS_Int8*	buf;
+  XDAS_Int32	bufSize;
+  XDAS_Int32	accessMask;
+} XDM1_SingleBufDesc;
+
+typedef struct XDM1_BufDesc
+{
+  XDAS_Int32		numBufs;
+  XDM1_SingleBufDesc	descs[XDM_MAX_IO_BUFFERS];
+} XDM1_BufDesc;
+
+typedef struct XDM_BufDesc
+{
+  XDAS_Int8**	bufs;
+  XDAS_Int32	numBufs;
+  XDAS_Int32*	bufSizes;
+} XDM_BufDesc;
+
+typedef struct XDM_AlgBufInfo
+{
+  XDAS_Int32	minNumInBufs;
+  XDAS_Int32	minNumOutBufs;
+  XDAS_Int32	minInBufSize[XDM_MAX_IO_BUFFERS];
+  XDAS_Int32	minOutBufSize[XDM_MAX_IO_BUFFERS];
+} XDM_AlgBufInfo;
+
+typedef struct IVIDTRANSCODE_Params
+{
+  XDAS_Int32	size;
+  XDAS_Int32	numOutputStreams;
+  XDAS_Int32	formatInput;
+  XDAS_Int32	formatOutput[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	maxHeightInput;
+  XDAS_Int32	maxWidthInput;
+  XDAS_Int32	maxFrameRateInput;
+  XDAS_Int32	maxBitRateInput;
+  XDAS_Int32	maxHeightOutput[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	maxWidthOutput[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	maxFrameRateOutput[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	maxBitRateOutput[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	dataEndianness;
+} IVIDTRANSCODE_Params;
+
+typedef struct IVIDTRANSCODE_DynamicParams
+{
+  XDAS_Int32	size;
+  XDAS_Int32	readHeaderOnlyFlag;
+  XDAS_Int32	keepInputResolutionFlag[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	outputHeight[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	outputWidth[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	keepInputFrameRateFlag[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	inputFrameRate;
+  XDAS_Int32	outputFrameRate[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	targetBitRate[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	rateControl[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	keepInputGOPFlag[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	intraFrameInterval[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	interFrameInterval[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	forceFrame[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32	frameSkipTranscodeFlag[IVIDTRANSCODE_MAXOUTSTREAMS];
+} IVIDTRANSCODE_DynamicParams;
+
+typedef struct IVIDTRANSCODE_InArgs
+{
+  XDAS_Int32	size;
+  XDAS_Int32	numBytes;
+  XDAS_Int32	inputID;
+} IVIDTRANSCODE_InArgs;
+
+typedef struct IVIDTRANSCODE_OutArgs
+{
+  XDAS_Int32		size;
+  XDAS_Int32		extendedError;
+  XDAS_Int32		bitsConsumed;
+  XDAS_Int32		bitsGenerated[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32		decodedPictureType;
+  XDAS_Int32		decodedPictureStructure;
+  XDAS_Int32		encodedPictureType[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32		encodedPictureStructure[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32		decodedHeight;
+  XDAS_Int32		decodedWidth;
+  XDAS_Int32		outputID[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32		inputFrameSkipTranscodeFlag[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDM1_SingleBufDesc	encodedBuf[IVIDTRANSCODE_MAXOUTSTREAMS];
+  XDAS_Int32		outBufsInUseFlag;
+} IVIDTRANSCODE_OutArgs;
+
+typedef struct IVIDTRANSCODE_Status
+{
+  XDAS_Int32		size;
+  XDAS_Int32		extendedError;
+  XDM1_SingleBufDesc	data;
+  XDM_AlgBufInfo	bufInfo;
+} IVIDTRANSCODE_Status;
+
+typedef IALG_Cmd IVIDTRANSCODE_Cmd;
+
+typedef struct IVIDTRANSCODE_Obj
+{
+  struct IVIDTRANSCODE_Fxns* fxns;
+} IVIDTRANSCODE_Obj;
+
+typedef IVIDTRANSCODE_Obj* IVIDTRANSCODE_Handle;
+
+typedef struct IVIDTRANSCODE_Fxns
+{
+  IALG_Fxns	ialg;
+  XDAS_Int32	(*process)(IVIDTRANSCODE_Handle, XDM1_BufDesc*, XDM_BufDesc*, IVIDTRANSCODE_InArgs*, IVIDTRANSCODE_OutArgs*);
+  XDAS_Int32	(*control)(IVIDTRANSCODE_Handle, IVIDTRANSCODE_Cmd, IVIDTRANSCODE_DynamicParams*, IVIDTRANSCODE_Status*);
+} IVIDTRANSCODE_Fxns;
+
+#endif // !TRIK_TESTS_STUBS_TI_XDAIS_DM_IVIDTRANSCODE_H_
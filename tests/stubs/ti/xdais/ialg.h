@@ -0,0 +1,76 @@
+/*
+ * Host stand-in of IALG interface, field order of memTab record and function table as in XDAIS
+ */
+#ifndef TRIK_TESTS_STUBS_TI_XDAIS_IALG_H_
+#define TRIK_TESTS_STUBS_TI_XDAIS_IALG_H_
+
+#include <xdc/std.h>
+
+#define IALG_EOK	0
+#define IALG_EFAIL	(-1)
+#define IALG_MAXMEMRECS	16
+
+typedef enum IALG_MemAttrs
+{
+  IALG_SCRATCH,
+  IALG_PERSIST,
+  IALG_WRITEONCE
+} IALG_MemAttrs;
+
+typedef enum IALG_MemSpace
+{
+  IALG_EPROG = 1,
+  IALG_IPROG,
+  IALG_ESDATA,
+  IALG_EXTERNAL,
+  IALG_DARAM0,
+  IALG_DARAM1,
+  IALG_SARAM,
+  IALG_SARAM0 = IALG_SARAM,
+  IALG_SARAM1,
+  IALG_DARAM2,
+  IALG_SARAM2
+} IALG_MemSpace;
+
+typedef struct IALG_MemRec
+{
+  Uns		size;
+  Int		alignment;
+  IALG_MemSpace	space;
+  IALG_MemAttrs	attrs;
+  void*		base;
+} IALG_MemRec;
+
+typedef struct IALG_Obj
+{
+  struct IALG_Fxns* fxns;
+} IALG_Obj;
+
+typedef IALG_Obj* IALG_Handle;
+
+typedef struct IALG_Params
+{
+  Int size;
+} IALG_Params;
+
+typedef struct IALG_Status
+{
+  Int size;
+} IALG_Status;
+
+typedef unsigned int IALG_Cmd;
+
+typedef struct IALG_Fxns
+{
+  void*	implementationId;
+  void	(*algActivate)(IALG_Handle);
+  Int	(*algAlloc)(const IALG_Params*, struct IALG_Fxns**, IALG_MemRec*);
+  Int	(*algControl)(IALG_Handle, IALG_Cmd, IALG_Status*);
+  void	(*algDeactivate)(IALG_Handle);
+  Int	(*algFree)(IALG_Handle, IALG_MemRec*);
+  Int	(*algInit)(IALG_Handle, const IALG_MemRec*, IALG_Handle, const IALG_Params*);
+  void	(*algMoved)(IALG_Handle, const IALG_MemRec*, IALG_Handle, const IALG_Params*);
+  Int	(*algNumAlloc)(void);
+} IALG_Fxns;
+
+#endif // !TRIK_TESTS_STUBS_TI_XDAIS_IALG_H_
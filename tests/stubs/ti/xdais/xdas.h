@@ -0,0 +1,21 @@
+/*
+ * Host stand-in of XDAIS scalar types
+ */
+#ifndef TRIK_TESTS_STUBS_TI_XDAIS_XDAS_H_
+#define TRIK_TESTS_STUBS_TI_XDAIS_XDAS_H_
+
+#include <stdint.h>
+
+typedef char		XDAS_Int8;
+typedef unsigned char	XDAS_UInt8;
+typedef int16_t		XDAS_Int16;
+typedef uint16_t	XDAS_UInt16;
+typedef int32_t		XDAS_Int32;
+typedef uint32_t	XDAS_UInt32;
+typedef void		XDAS_Void;
+typedef int8_t		XDAS_Bool;
+
+#define XDAS_TRUE	1
+#define XDAS_FALSE	0
+
+#endif // !TRIK_TESTS_STUBS_TI_XDAIS_XDAS_H_
@@ -0,0 +1,19 @@
+/*
+ * Host stand-in of XDC runtime types, only what codec sources use; tests build codec with host compiler
+ */
+#ifndef TRIK_TESTS_STUBS_XDC_STD_H_
+#define TRIK_TESTS_STUBS_XDC_STD_H_
+
+#include <stddef.h>
+
+typedef int		Int;
+typedef unsigned int	Uns;
+typedef void*		Ptr;
+typedef char		Char;
+typedef int		Bool;
+
+#ifndef __cplusplus
+#define restrict __restrict
+#endif
+
+#endif // !TRIK_TESTS_STUBS_XDC_STD_H_
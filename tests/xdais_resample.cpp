@@ -0,0 +1,149 @@
+#include <sysexits.h>
+#include <vector>
+#include <iostream>
+
+#include "codec.hpp"
+
+
+using namespace std;
+
+
+/*
+ * Codec driven through XDAIS calls as framework does: alloc, initObj, control, process and free.
+ * Every frame must match resampleBuffer() without cache, memTab records must come back from free().
+ */
+static const XDAS_Int32 s_inWidth   = 640;
+static const XDAS_Int32 s_inHeight  = 480;
+static const XDAS_Int32 s_outWidth0 = 320;
+static const XDAS_Int32 s_outHeight0 = 240;
+static const XDAS_Int32 s_outWidth1 = 213;
+static const XDAS_Int32 s_outHeight1 = 160;
+
+
+static bool checkRecords(const CodecInstance& _codec, const TRIK_VIDTRANSCODE_RESAMPLE_Params* _params)
+{
+  return _codec.recordsCount() == 2
+      && _codec.record(0).size >= sizeof(TrikVideoResampleHandle)
+      && _codec.record(1).size == resampleCacheSize(_params)
+      && _codec.record(1).attrs == IALG_PERSIST;
+}
+
+
+static bool checkFrames()
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_Params params = *getDefaultParams();
+  params.base.numOutputStreams   = 2;
+  params.base.formatInput        = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422;
+  params.base.formatOutput[0]    = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565X;
+  params.base.formatOutput[1]    = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_GRAY8;
+  params.base.maxWidthInput      = s_inWidth;
+  params.base.maxHeightInput     = s_inHeight;
+  params.base.maxWidthOutput[0]  = s_outWidth0;
+  params.base.maxHeightOutput[0] = s_outHeight0;
+  params.base.maxWidthOutput[1]  = s_outWidth1;
+  params.base.maxHeightOutput[1] = s_outHeight1;
+
+  CodecInstance codec;
+  bool passed = codec.create(&params) && checkRecords(codec, &params);
+
+  TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams dynamicParams = codecDynamicParams(s_inWidth, s_inHeight,
+                                                                              s_outWidth0, s_outHeight0,
+                                                                              s_outWidth1, s_outHeight1);
+  dynamicParams.outputAlgorithm[0] = TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BILINEAR;
+  dynamicParams.outputAlgorithm[1] = TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC;
+  passed = passed && codec.setParams(dynamicParams);
+
+  vector<XDAS_Int8> in(s_inWidth*s_inHeight*2);
+  vector<XDAS_Int8> outs[2] = { vector<XDAS_Int8>(s_outWidth0*s_outHeight0*2), vector<XDAS_Int8>(s_outWidth1*s_outHeight1) };
+  vector<XDAS_Int8> refs[2] = { outs[0], outs[1] };
+
+  for (size_t frame = 0; passed && frame < 3; ++frame)
+  {
+    for (size_t idx = 0; idx < in.size(); ++idx)
+      in[idx] = static_cast<XDAS_Int8>(idx*13 + frame*71 + idx/(s_inWidth*2)*5);
+
+    IVIDTRANSCODE_OutArgs outArgs;
+    passed &= codec.process(in, outs, 2, outArgs)
+           && outArgs.bitsGenerated[0] == static_cast<XDAS_Int32>(outs[0].size()*8)
+           && outArgs.bitsGenerated[1] == static_cast<XDAS_Int32>(outs[1].size()*8);
+
+    XDAS_Int32 used;
+    passed &= resampleBuffer(&in.front(), in.size(), params.base.formatInput, s_inHeight, s_inWidth, -1,
+                             &refs[0].front(), refs[0].size(), &used, params.base.formatOutput[0], s_outHeight0, s_outWidth0, -1,
+                             dynamicParams.outputAlgorithm[0], NULL, 0) == TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK
+           && resampleBuffer(&in.front(), in.size(), params.base.formatInput, s_inHeight, s_inWidth, -1,
+                             &refs[1].front(), refs[1].size(), &used, params.base.formatOutput[1], s_outHeight1, s_outWidth1, -1,
+                             dynamicParams.outputAlgorithm[1], NULL, 0) == TRIK_VIDTRANSCODE_RESAMPLE_STATUS_OK;
+    passed &= outs[0] == refs[0] && outs[1] == refs[1];
+  }
+
+  passed &= codec.free();
+
+  cout << "YUV422 " << s_inWidth << "x" << s_inHeight << " -> RGB565X " << s_outWidth0 << "x" << s_outHeight0
+       << " and GRAY8 " << s_outWidth1 << "x" << s_outHeight1 << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+// reset replaces params with defaults, memTab of creation params must still come back from free()
+static bool checkResetFree()
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_Params params = *getDefaultParams();
+  params.base.numOutputStreams   = 1;
+  params.base.formatInput        = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422;
+  params.base.formatOutput[0]    = TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB888;
+  params.base.maxWidthInput      = 1920;
+  params.base.maxHeightInput     = 1080;
+  params.base.maxWidthOutput[0]  = 1280;
+  params.base.maxHeightOutput[0] = 720;
+
+  CodecInstance codec;
+  const bool passed = resampleCacheSize(&params) != resampleCacheSize(NULL)
+                   && codec.create(&params)
+                   && checkRecords(codec, &params)
+                   && codec.control(XDM_RESET)
+                   && codec.control(XDM_SETDEFAULT)
+                   && codec.free();
+
+  cout << "reset then free" << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+// stream count beyond per-stream arrays of params is refused by initObj()
+static bool checkTooManyStreams()
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_Params params = *getDefaultParams();
+  params.base.numOutputStreams = IVIDTRANSCODE_MAXOUTSTREAMS + 1;
+
+  CodecInstance codec;
+  const bool passed = !codec.create(&params);
+
+  cout << "too many output streams" << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+static bool checkDefaultParams()
+{
+  CodecInstance codec;
+  const bool passed = codec.create(NULL)
+                   && checkRecords(codec, NULL)
+                   && codec.free();
+
+  cout << "default params" << (passed ? ": ok" : ": FAILED") << endl;
+  return passed;
+}
+
+
+int main()
+{
+  bool passed = true;
+
+  passed &= checkFrames();
+  passed &= checkResetFree();
+  passed &= checkTooManyStreams();
+  passed &= checkDefaultParams();
+
+  return passed ? EX_OK : EX_SOFTWARE;
+}
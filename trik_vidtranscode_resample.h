@@ -25,10 +25,29 @@ typedef enum TRIK_VIDTRANSCODE_RESAMPLE_VideoFormat
   TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565,
   TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGB565X,
   TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV444,
-  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_YUV422,
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV12,		/* planar 4:2:0, Y plane then interleaved U,V plane */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_NV21,		/* as NV12 with V,U order */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_I420,		/* planar 4:2:0, Y, U and V planes */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_GRAY8,		/* 8-bit luma only, output only */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_RGBA8888,	/* 32-bit, bytes R, G, B, A */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_BGRA8888,	/* 32-bit, bytes B, G, R, A, little-endian XRGB framebuffer word */
+  TRIK_VIDTRANSCODE_RESAMPLE_VIDEO_FORMAT_XRGB8888	/* 32-bit, bytes X, R, G, B */
 } TRIK_VIDTRANSCODE_RESAMPLE_VideoFormat;
 
 
+typedef enum TRIK_VIDTRANSCODE_RESAMPLE_Algorithm
+{
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AUTO = 0,	/* area when reducing 2x or more, bicubic otherwise */
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_NEAREST,		/* cheapest, for latency-critical previews */
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BILINEAR,
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_BICUBIC,
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_AREA,
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS2,
+  TRIK_VIDTRANSCODE_RESAMPLE_ALGORITHM_LANCZOS3		/* best quality for enlarging, 6x6 taps */
+} TRIK_VIDTRANSCODE_RESAMPLE_Algorithm;
+
+
 typedef struct TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams {
     IVIDTRANSCODE_DynamicParams	base;
 
@@ -37,6 +56,7 @@ typedef struct TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams {
     XDAS_Int32			inputLineLength;
 
     XDAS_Int32			outputLineLength[2];
+    XDAS_Int32			outputAlgorithm[2];
 } TRIK_VIDTRANSCODE_RESAMPLE_DynamicParams;
 
 